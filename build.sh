@@ -91,6 +91,7 @@ prepare_build_tree()
 	mkdir -p build/boinc >> $LOGFILE || failure
 	mkdir -p build/framework >> $LOGFILE || failure
 	mkdir -p build/orc >> $LOGFILE || failure
+	mkdir -p build/starcat >> $LOGFILE || failure
 	mkdir -p build/starsphere >> $LOGFILE || failure
 
 	return 0
@@ -409,7 +410,7 @@ build_mingw()
 
 build_starsphere()
 {
-	# make sure ORC is always compiled for host platform (it's exexuted during starsphere build!)
+	# make sure ORC and StarCat are always compiled for host platform (they're exexuted during starsphere build!)
 	export PATH=$PATH_ORG
 
 	echo "Building Starsphere [ORC]..." | tee -a $LOGFILE
@@ -421,6 +422,16 @@ build_starsphere()
 	make install >> $LOGFILE 2>&1 || failure
 	echo "Successfully built and installed Starsphere [ORC]!" | tee -a $LOGFILE
 
+	echo "Building Starsphere [StarCat]..." | tee -a $LOGFILE
+	export STARCAT_SRC=$ROOT/src/starcat || failure
+	export STARCAT_INSTALL=$ROOT/install || failure
+	export CATALOG_SRC=$ROOT/src/starsphere || failure
+	cd $ROOT/build/starcat || failure
+	cp $ROOT/src/starcat/Makefile . >> $LOGFILE 2>&1 || failure
+	make $2 >> $LOGFILE 2>&1 || failure
+	make install >> $LOGFILE 2>&1 || failure
+	echo "Successfully built and installed Starsphere [StarCat]!" | tee -a $LOGFILE
+
 	# set main include directory
 	if [ "$1" == "$TARGET_WIN32" ]; then
 		export PATH=$PATH_MINGW
@@ -0,0 +1,121 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <cstdlib>
+#include <cstdio>
+#include <ctime>
+#include <vector>
+#include <iostream>
+
+#include "ByteSum.h"
+
+using namespace std;
+
+/**
+ * \brief Checkpoint checksum (ByteSum) test and benchmark
+ *
+ * This tool compares all ByteSum kernels supported by the host with the scalar reference
+ * on randomized buffers (random lengths, alignments and extreme byte values). Afterwards it
+ * measures their throughput on a buffer of the size of a Hough checkpoint (10000 candidates).
+ */
+
+/// Available kernels (the scalar one is the reference)
+const ByteSum::KernelType KERNELS[] = {ByteSum::ScalarKernel, ByteSum::SSE2Kernel, ByteSum::AVX2Kernel};
+
+/// Number of available kernels
+const int KERNEL_COUNT = sizeof(KERNELS) / sizeof(KERNELS[0]);
+
+void printUsage() {
+	cerr << "Invalid command-line options!" << endl;
+	cerr << "Usage: bytesum [<test buffers> [<benchmark iterations> [<benchmark size>]]]" << endl;
+}
+
+void fillBuffer(char *data, const size_t length) {
+	// random bytes or one of the extreme values (catch sign handling and overflows)
+	const int mode = rand() % 3;
+
+	for(size_t i = 0; i < length; ++i) {
+		data[i] = mode == 0 ? (char) rand() : (mode == 1 ? (char) 0x80 : (char) 0x7f);
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	if(argc > 4) {
+		printUsage();
+		exit(1);
+	}
+
+	const int buffers = argc > 1 ? atoi(argv[1]) : 20000;
+	const int iterations = argc > 2 ? atoi(argv[2]) : 200;
+	const int size = argc > 3 ? atoi(argv[3]) : 720004;
+	if(buffers < 0 || iterations <= 0 || size <= 0) {
+		printUsage();
+		exit(1);
+	}
+
+	const size_t maximumLength = size > 300 ? size : 300;
+	vector<char> buffer(maximumLength + 64);
+
+	// make sure all kernels agree with the scalar reference
+	srand(1);
+	int failures = 0;
+	for(int i = 0; i < buffers; ++i) {
+		// all short lengths (remainders), then mostly short and a few long random ones
+		const size_t length = i < 200 ? i : rand() % (i % 10 == 0 ? maximumLength : 300);
+		const size_t offset = rand() % 33;
+		fillBuffer(&buffer[offset], length);
+
+		const uint32_t reference = ByteSum::kernel(ByteSum::ScalarKernel)(&buffer[offset], length);
+		if(ByteSum::sum(&buffer[offset], length) != reference) ++failures;
+
+		for(int k = 1; k < KERNEL_COUNT; ++k) {
+			ByteSum::Kernel kernel = ByteSum::kernel(KERNELS[k]);
+			if(kernel && kernel(&buffer[offset], length) != reference) ++failures;
+		}
+	}
+
+	printf("Selected kernel: %s\n", ByteSum::kernelName());
+	printf("Test: %d buffers, %d mismatches\n", buffers, failures);
+
+	// benchmark all supported kernels (rotating alignments)
+	for(int i = 0; i < size + 8; ++i) buffer[i] = (char) rand();
+	printf("Benchmark: %d bytes, %d iterations\n", size, iterations);
+
+	double scalarTime = 0;
+	volatile uint32_t sink = 0;
+	for(int k = 0; k < KERNEL_COUNT; ++k) {
+		ByteSum::Kernel kernel = ByteSum::kernel(KERNELS[k]);
+		if(!kernel) {
+			printf("%-6s not supported\n", ByteSum::kernelName(KERNELS[k]));
+			continue;
+		}
+
+		const clock_t start = clock();
+		for(int i = 0; i < iterations; ++i) sink += kernel(&buffer[i & 7], size);
+		const double time = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+		if(k == 0) scalarTime = time;
+		printf("%-6s %10.3f us per sum (%.1fx)\n", ByteSum::kernelName(KERNELS[k]),
+			   time * 1e6 / iterations, time > 0 ? scalarTime / time : 0.0);
+	}
+
+	exit(failures == 0 ? 0 : 1);
+}
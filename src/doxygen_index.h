@@ -154,23 +154,25 @@
  * \subsubsection sec_orc_usage Usage
  *
  * -# Create a resource specification file
- * -# Run the resource compiler (\c orc) to convert the resources into source code
- * -# Include the generated source file in your project (compile and link it to the main executable)
- * -# Use ResourceFactory to instantiate a Resource object (loads the binary resource data into memory)
- * -# Use the Resource instance to retrieve a pointer to the resource's raw data
+ * -# Run the resource compiler (\c orc) to convert the resources into source code (plus a binary blob file)
+ * -# Include the generated source file in your project (compile it next to the blob file and link it to the main executable)
+ * -# Use ResourceFactory to instantiate a Resource object (refers to the compiled-in resource data, nothing is copied)
+ * -# Use the Resource instance to retrieve a pointer to the resource's raw data and its size
  *
  * %Resource specification file format:
  * - Simple text file (*.orc)
  * - Each line describes one resource
- * - The descriptor has to look like this: \c LogicalResourceName|PhysicalResourceName
+ * - The descriptor has to look like this: \c LogicalResourceName|PhysicalResourceName[|Compression]
  * - \c PhysicalResourceName is the actual file name of the resource
+ * - \c Compression is optional: \c none (default), \c lz4 or \c lz4hc (see ResourceCompiler)
  * - Lines starting with # are treated as comments
  * - Empty lines are ignored
  *
  * Command line calling convention:
- * \code orc <InputSpecFileName> <OutputCodeFileName> \endcode
+ * \code orc <InputSpecFileName> <OutputCodeFileName> [<OutputPackFileName>] \endcode
  * - \c InputSpecFileName: The name of the resource specification file (input)
- * - \c OutputCodeFileName: The name of the resource code file (output)
+ * - \c OutputCodeFileName: The name of the resource code file (output, the blob file name uses the extension \c .bin)
+ * - \c OutputPackFileName: The name of an optional resource pack file (output, see ResourcePack)
  *
  * \subsection cha_source Source Code Access
  *
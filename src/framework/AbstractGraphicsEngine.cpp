@@ -29,7 +29,7 @@ AbstractGraphicsEngine::~AbstractGraphicsEngine()
 {
 }
 
-void AbstractGraphicsEngine::refreshLocalBOINCInformation()
+void AbstractGraphicsEngine::fetchLocalBOINCInformation()
 {
 	m_BoincAdapter.refresh();
 }
@@ -161,13 +161,31 @@ public:
 	virtual void keyboardPressEvent(const KeyBoardKey keyPressed) = 0;
 
 	/**
-	 * \brief This method is called when the BOINC client information should be updated
+	 * \brief This method is called when the BOINC client information should be fetched
+	 *
+	 * This method is called periodically by a background thread, \b not by the render thread.
+	 * It should query the BOINC (and science application) adapters, prepare everything the
+	 * render thread needs (e.g. preformatted HUD strings) and publish it as a snapshot (see
+	 * SnapshotBuffer). Thus it must neither call any OpenGL functions nor touch any state used
+	 * while rendering. The adapters are owned by this thread once the event loop is running.
 	 *
 	 * When you inherit from this class and implement this method, please make sure you call
-	 * \ref refreshLocalBOINCInformation() to invoke the generic default implementation which
+	 * \ref fetchLocalBOINCInformation() to invoke the generic default implementation which
 	 * refreshes \ref m_BoincAdapter.
 	 *
-	 * \see refreshLocalBOINCInformation()
+	 * \see fetchLocalBOINCInformation()
+	 * \see refreshBOINCInformation()
+	 */
+	virtual void fetchBOINCInformation() = 0;
+
+	/**
+	 * \brief This method is called when the BOINC client information should be updated
+	 *
+	 * This method is called by the render thread whenever fetchBOINCInformation() published
+	 * a new snapshot. It should only take over the latest snapshot (which is a cheap swap)
+	 * and must not query any adapter itself.
+	 *
+	 * \see fetchBOINCInformation()
 	 */
 	virtual void refreshBOINCInformation() = 0;
 
@@ -186,15 +204,15 @@ protected:
 	AbstractGraphicsEngine(string sharedMemoryIdentifier);
 
 	/**
-	 * \brief This method has to be called in order to update the BOINC client information
+	 * \brief This method has to be called in order to fetch the BOINC client information
 	 *
 	 * This is the local/generic implementation which refreshes \ref m_BoincAdapter.
 	 *
-	 * \see refreshBOINCInformation()
+	 * \see fetchBOINCInformation()
 	 */
-	virtual void refreshLocalBOINCInformation();
+	virtual void fetchLocalBOINCInformation();
 
-	/// BOINC client adapter instance for information retrieval
+	/// BOINC client adapter instance for information retrieval (owned by the fetching thread)
 	BOINCClientAdapter m_BoincAdapter;
 };
 
@@ -19,22 +19,37 @@
  ***************************************************************************/
 
 #include "BOINCClientAdapter.h"
-#include "Libxml2Adapter.h"
+#include "XMLProcessorFactory.h"
 
 #include <sstream>
+#include <cstring>
+#include <sys/stat.h>
+
+const int BOINCClientAdapter::MAX_SHARED_MEMORY_READ_ATTEMPTS = 3;
 
 BOINCClientAdapter::BOINCClientAdapter(string sharedMemoryIdentifier)
 {
 	m_Initialized = false;
 	m_SharedMemoryAreaIdentifier = sharedMemoryIdentifier;
 	m_SharedMemoryAreaAvailable = false;
+	m_SharedMemoryAreaGeneration = 0;
+	m_SharedMemoryAreaSequence = 0;
+	m_SharedMemoryAreaRevision = 0;
 
-	m_xmlIFace = new Libxml2Adapter();
+	m_xmlIFace = XMLProcessorFactory::createInstance();
 
 	m_GraphicsFrameRate = 20;
 	m_GraphicsQualitySetting = BOINCClientAdapter::LowGraphicsQualitySetting;
 	m_GraphicsWindowWidth = 800;
 	m_GraphicsWindowHeight = 600;
+
+	m_UserInfoFileDevice = 0;
+	m_UserInfoFileInode = 0;
+	m_UserInfoFileModificationTime = 0;
+	m_UserInfoFileSize = -1;
+	m_UserInfoRevision = 0;
+	m_WorkUnitRevision = 0;
+	m_ProjectPreferencesRevision = 0;
 }
 
 BOINCClientAdapter::~BOINCClientAdapter()
@@ -56,10 +71,15 @@ void BOINCClientAdapter::initialize()
 void BOINCClientAdapter::refresh()
 {
 	if(m_Initialized) {
+		// a work unit change is reported via workUnitRevision()
+		const unsigned int preferencesRevision = m_ProjectPreferencesRevision;
 		readUserInfo();
 		readSharedMemoryArea();
 
-		/// \todo Check that we're still watching our own WU (or science app)!
+		// preferences might have been changed on the project website
+		if(m_ProjectPreferencesRevision != preferencesRevision) {
+			readProjectPreferences();
+		}
 	}
 	else {
 		cerr << "The BOINC Client Adapter has not yet been initialized! Doing so now..." << endl;
@@ -69,16 +89,95 @@ void BOINCClientAdapter::refresh()
 
 void BOINCClientAdapter::readUserInfo()
 {
+	struct stat status;
+
+	// skip parsing when the file didn't change (always parse if we can't tell)
+	if(stat(INIT_DATA_FILE, &status) == 0) {
+		if(status.st_dev == m_UserInfoFileDevice &&
+		   status.st_ino == m_UserInfoFileInode &&
+		   status.st_mtime == m_UserInfoFileModificationTime &&
+		   status.st_size == m_UserInfoFileSize)
+		{
+			return;
+		}
+
+		m_UserInfoFileDevice = status.st_dev;
+		m_UserInfoFileInode = status.st_ino;
+		m_UserInfoFileModificationTime = status.st_mtime;
+		m_UserInfoFileSize = status.st_size;
+	}
+
+	// keep previous values for comparison
+	const APP_INIT_DATA previous = m_UserData;
+
 	boinc_parse_init_data_file();
 	boinc_get_init_data(m_UserData);
+
+	// report actual changes only
+	if(m_UserInfoRevision == 0 ||
+	   strcmp(m_UserData.user_name, previous.user_name) != 0 ||
+	   strcmp(m_UserData.team_name, previous.team_name) != 0 ||
+	   m_UserData.user_total_credit != previous.user_total_credit ||
+	   m_UserData.user_expavg_credit != previous.user_expavg_credit ||
+	   m_UserData.host_total_credit != previous.host_total_credit ||
+	   m_UserData.host_expavg_credit != previous.host_expavg_credit)
+	{
+		++m_UserInfoRevision;
+	}
+
+	if(m_WorkUnitRevision == 0 || strcmp(m_UserData.wu_name, previous.wu_name) != 0) {
+		++m_WorkUnitRevision;
+	}
+
+	// BOINC initializes missing preferences with 0
+	const char *preferences = m_UserData.project_preferences ? m_UserData.project_preferences : "";
+	const char *previousPreferences = previous.project_preferences ? previous.project_preferences : "";
+	if(m_ProjectPreferencesRevision == 0 || strcmp(preferences, previousPreferences) != 0) {
+		++m_ProjectPreferencesRevision;
+	}
+}
+
+unsigned int BOINCClientAdapter::userInfoRevision() const
+{
+	return m_UserInfoRevision;
+}
+
+unsigned int BOINCClientAdapter::workUnitRevision() const
+{
+	return m_WorkUnitRevision;
+}
+
+unsigned int BOINCClientAdapter::projectPreferencesRevision() const
+{
+	return m_ProjectPreferencesRevision;
 }
 
 void BOINCClientAdapter::readSharedMemoryArea()
 {
 	// check if we already have a pointer
 	if(m_SharedMemoryAreaAvailable) {
-		// load contents
-		m_SharedMemoryAreaContents = string(m_SharedMemoryArea);
+		if(SharedMemoryArea::hasHeader(m_SharedMemoryArea)) {
+			const SharedMemoryArea::Header *header = reinterpret_cast<const SharedMemoryArea::Header*>(m_SharedMemoryArea);
+
+			// load contents only when they changed and keep the previous ones if we can't get a consistent copy
+			for(int attempt = 0; attempt < MAX_SHARED_MEMORY_READ_ATTEMPTS; ++attempt) {
+				SharedMemoryArea::ReadResult result = SharedMemoryArea::read(header, m_SharedMemoryAreaGeneration, m_SharedMemoryAreaSequence, m_SharedMemoryAreaBuffer);
+
+				if(result == SharedMemoryArea::Unchanged) {
+					break;
+				}
+				else if(result == SharedMemoryArea::Updated) {
+					m_SharedMemoryAreaContents.swap(m_SharedMemoryAreaBuffer);
+					++m_SharedMemoryAreaRevision;
+					break;
+				}
+			}
+		}
+		// legacy contents: load them only when they changed
+		else if(m_SharedMemoryAreaRevision == 0 || m_SharedMemoryAreaContents.compare(m_SharedMemoryArea) != 0) {
+			m_SharedMemoryAreaContents.assign(m_SharedMemoryArea);
+			++m_SharedMemoryAreaRevision;
+		}
 	}
 	// the shared memory area's not available, try to get a pointer to it
 	else {
@@ -99,7 +198,16 @@ void BOINCClientAdapter::readSharedMemoryArea()
 
 void BOINCClientAdapter::readProjectPreferences()
 {
-	string temp;
+	// XPath queries (resolved in one batch)
+	static const char *queries[] = {
+		"/project_preferences/graphics/@fps",
+		"/project_preferences/graphics/@quality",
+		"/project_preferences/graphics/@width",
+		"/project_preferences/graphics/@height"
+	};
+	static const vector<string> xpaths(queries, queries + sizeof(queries) / sizeof(queries[0]));
+
+	vector<string> values;
 	istringstream converter;
 	converter.exceptions(ios_base::badbit | ios_base::failbit);
 
@@ -107,20 +215,20 @@ void BOINCClientAdapter::readProjectPreferences()
 	m_xmlIFace->setXmlDocument(projectInformation(), "http://einstein.phys.uwm.edu");
 
 	// use XPath queries to get attributes
+	m_xmlIFace->getSingleNodeContentsByXPath(xpaths, values);
+
 	try {
-		temp = m_xmlIFace->getSingleNodeContentByXPath("/project_preferences/graphics/@fps");
-		if(temp.length() > 0) {
+		if(values[0].length() > 0) {
 			converter.clear();
-			converter.str(temp);
+			converter.str(values[0]);
 			converter >> dec >> m_GraphicsFrameRate;
 		}
 
-		temp = m_xmlIFace->getSingleNodeContentByXPath("/project_preferences/graphics/@quality");
-		if(temp.length() > 0) {
-			if(temp == "high") {
+		if(values[1].length() > 0) {
+			if(values[1] == "high") {
 				m_GraphicsQualitySetting = BOINCClientAdapter::HighGraphicsQualitySetting;
 			}
-			else if(temp == "medium") {
+			else if(values[1] == "medium") {
 				m_GraphicsQualitySetting = BOINCClientAdapter::MediumGraphicsQualitySetting;
 			}
 			else {
@@ -128,17 +236,15 @@ void BOINCClientAdapter::readProjectPreferences()
 			}
 		}
 
-		temp = m_xmlIFace->getSingleNodeContentByXPath("/project_preferences/graphics/@width");
-		if(temp.length() > 0) {
+		if(values[2].length() > 0) {
 			converter.clear();
-			converter.str(temp);
+			converter.str(values[2]);
 			converter >> dec >> m_GraphicsWindowWidth;
 		}
 
-		temp = m_xmlIFace->getSingleNodeContentByXPath("/project_preferences/graphics/@height");
-		if(temp.length() > 0) {
+		if(values[3].length() > 0) {
 			converter.clear();
-			converter.str(temp);
+			converter.str(values[3]);
 			converter >> dec >> m_GraphicsWindowHeight;
 		}
 	}
@@ -147,11 +253,16 @@ void BOINCClientAdapter::readProjectPreferences()
 	}
 }
 
-string BOINCClientAdapter::applicationInformation() const
+const string& BOINCClientAdapter::applicationInformation() const
 {
 	return m_SharedMemoryAreaContents;
 }
 
+unsigned int BOINCClientAdapter::applicationInformationRevision() const
+{
+	return m_SharedMemoryAreaRevision;
+}
+
 string BOINCClientAdapter::projectInformation() const
 {
 	string temp("<project_preferences />\n");
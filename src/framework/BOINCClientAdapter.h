@@ -24,11 +24,14 @@
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <ctime>
+#include <sys/types.h>
 
 #include "boinc_api.h"
 #include "graphics2.h"
 
 #include "XMLProcessorInterface.h"
+#include "SharedMemoryArea.h"
 
 using namespace std;
 
@@ -93,6 +96,43 @@ public:
 	 */
 	void refresh();
 
+	/**
+	 * \brief Retrieves the revision of the user information
+	 *
+	 * The revision is incremented whenever the user, team or credit information changes.
+	 * Compare it to the revision seen last in order to update depending data (e.g. HUD contents)
+	 * only when necessary.
+	 *
+	 * \return The revision of the user information (0: not yet available)
+	 *
+	 * \see readUserInfo
+	 */
+	unsigned int userInfoRevision() const;
+
+	/**
+	 * \brief Retrieves the revision of the work unit information
+	 *
+	 * The revision is incremented whenever the active work unit changes.
+	 *
+	 * \return The revision of the work unit information (0: not yet available)
+	 *
+	 * \see readUserInfo
+	 */
+	unsigned int workUnitRevision() const;
+
+	/**
+	 * \brief Retrieves the revision of the project preferences
+	 *
+	 * The revision is incremented whenever the project preferences change (the graphics
+	 * settings are reloaded automatically). Compare it to the revision seen last in order
+	 * to reload your own settings only when necessary.
+	 *
+	 * \return The revision of the project preferences (0: not yet available)
+	 *
+	 * \see projectInformation
+	 */
+	unsigned int projectPreferencesRevision() const;
+
 	/**
 	 * \brief Retrieves the BOINC core client version of the currently active client
 	 *
@@ -215,11 +255,25 @@ public:
     /**
      * \brief Retrieves information provided by the running science application
      *
-     * \return The application specific information string (i.e. XML) found in APP_INIT_DATA
+     * \return The application specific information string (i.e. XML) found in the shared memory area
+     * (valid until the next refresh)
      *
-     * \see m_UserData
+     * \see applicationInformationRevision
+     * \see readSharedMemoryArea
      */
-    string applicationInformation() const;
+    const string& applicationInformation() const;
+
+    /**
+     * \brief Retrieves the revision of the information provided by the running science application
+     *
+     * The revision is incremented whenever the contents of the shared memory area change.
+     * Compare it to the revision seen last in order to parse them only when necessary.
+     *
+     * \return The revision of the application information (0: not yet available)
+     *
+     * \see applicationInformation
+     */
+    unsigned int applicationInformationRevision() const;
 
     /**
      * \brief Retrieves specific information provided by the currently active project
@@ -317,9 +371,13 @@ private:
      * \brief Fetch the contents of \c init_data.xml
      *
      * This method uses the BOINC API in order to fill the \c APP_INIT_DATA structure m_UserData
-     * with initial information about the current work unit computation session (slot). The data
-     * in \c init_data.xml is refreshed only at the beginning of a session, hence this method doesn't
-     * need to be called periodically.
+     * with initial information about the current work unit computation session (slot).
+     * The file is only parsed when it changed (identity, modification time or size), which
+     * happens rarely (e.g. after a scheduler RPC). Actual changes of the user and work unit
+     * information are reported via their revisions.
+     *
+     * \see userInfoRevision
+     * \see workUnitRevision
      */
 	void readUserInfo();
 
@@ -330,7 +388,13 @@ private:
 	 * and work unit computation. The contents have to be considered as volatile, hence should be refreshed
 	 * periodically.
 	 *
+	 * If the science application uses the versioned protocol (see SharedMemoryArea) unchanged contents
+	 * aren't copied at all and contents read while being written are discarded (the previous contents
+	 * are kept until a consistent copy could be made). Legacy contents (plain string) are compared in place
+	 * and copied only when they changed.
+	 *
 	 * \see refresh()
+	 * \see applicationInformationRevision()
 	 */
 	void readSharedMemoryArea();
 
@@ -339,6 +403,7 @@ private:
 	 *
 	 * The project-specific preferences are retrieved by projectInformation().
 	 * This method parses the XML string returned and populates the respective data members.
+	 * It's called again whenever the preferences change.
 	 *
 	 * \see projectInformation()
 	 * \see m_GraphicsFrameRate
@@ -360,6 +425,21 @@ private:
 	/// The contents of the shared memory area after the last refresh
 	string m_SharedMemoryAreaContents;
 
+	/// Scratch buffer receiving copies of the versioned shared memory area (swapped when consistent)
+	string m_SharedMemoryAreaBuffer;
+
+	/// Generation (producer run) of the versioned shared memory area seen last
+	uint32_t m_SharedMemoryAreaGeneration;
+
+	/// Sequence of the versioned shared memory area seen last
+	uint32_t m_SharedMemoryAreaSequence;
+
+	/// Revision of the shared memory area contents
+	unsigned int m_SharedMemoryAreaRevision;
+
+	/// Maximum number of attempts to get a consistent copy of the versioned shared memory area per refresh
+	static const int MAX_SHARED_MEMORY_READ_ATTEMPTS;
+
 	/// Flag to indicate whether the shared memory area is available or not
 	bool m_SharedMemoryAreaAvailable;
 
@@ -385,6 +465,27 @@ private:
 
 	/// Pointer to the XML processor
 	XMLProcessorInterface* m_xmlIFace;
+
+	/// Device of \c init_data.xml when it was parsed last
+	dev_t m_UserInfoFileDevice;
+
+	/// Inode of \c init_data.xml when it was parsed last
+	ino_t m_UserInfoFileInode;
+
+	/// Modification time of \c init_data.xml when it was parsed last
+	time_t m_UserInfoFileModificationTime;
+
+	/// Size of \c init_data.xml when it was parsed last (-1: not yet parsed)
+	off_t m_UserInfoFileSize;
+
+	/// Revision of the user information
+	unsigned int m_UserInfoRevision;
+
+	/// Revision of the work unit information
+	unsigned int m_WorkUnitRevision;
+
+	/// Revision of the project preferences
+	unsigned int m_ProjectPreferencesRevision;
 };
 
 /**
@@ -0,0 +1,127 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "BufferedFile.h"
+
+#include <iostream>
+#include <fcntl.h>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+const size_t BufferedFile::CHUNK_SIZE = 64 * 1024;
+
+BufferedFile::BufferedFile() :
+	m_Buffer(CHUNK_SIZE)
+{
+	m_Descriptor = -1;
+}
+
+BufferedFile::~BufferedFile()
+{
+	close();
+}
+
+bool BufferedFile::open(const string filename)
+{
+	close();
+
+	m_Filename = filename;
+
+	m_Descriptor = ::open(filename.c_str(), O_RDONLY | O_BINARY);
+	if(m_Descriptor < 0) {
+		cerr << "File " << filename << " couldn't be opened!" << endl;
+		return false;
+	}
+
+	// record status of the opened file (used to detect concurrent modifications)
+	if(!m_Status.fromDescriptor(m_Descriptor)) {
+		cerr << "Status of file " << filename << " couldn't be retrieved!" << endl;
+		close();
+		return false;
+	}
+
+	return true;
+}
+
+void BufferedFile::close()
+{
+	if(m_Descriptor >= 0) {
+		::close(m_Descriptor);
+	}
+	m_Descriptor = -1;
+}
+
+const char* BufferedFile::read(const size_t offset, const size_t count)
+{
+	size_t done = 0;
+
+	if(m_Descriptor < 0 || count > CHUNK_SIZE) return NULL;
+
+#ifdef _WIN32
+	if(lseek(m_Descriptor, (long) offset, SEEK_SET) != (long) offset) {
+		cerr << "File " << m_Filename << " couldn't be read!" << endl;
+		return NULL;
+	}
+#endif
+
+	// read until the chunk is complete (the file might have been truncated meanwhile)
+	while(done < count) {
+#ifdef _WIN32
+		int result = ::read(m_Descriptor, &m_Buffer[done], (unsigned int) (count - done));
+#else
+		ssize_t result = pread(m_Descriptor, &m_Buffer[done], count - done, offset + done);
+#endif
+		if(result < 0) {
+			cerr << "File " << m_Filename << " couldn't be read!" << endl;
+			return NULL;
+		}
+		else if(result == 0) {
+			return NULL;
+		}
+
+		done += result;
+	}
+
+	return &m_Buffer[0];
+}
+
+bool BufferedFile::unchanged() const
+{
+	FileStatus status;
+
+	if(!status.fromName(m_Filename)) {
+		return false;
+	}
+
+	return status == m_Status;
+}
+
+size_t BufferedFile::size() const
+{
+	return m_Status.size;
+}
@@ -0,0 +1,125 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef BUFFEREDFILE_H_
+#define BUFFEREDFILE_H_
+
+#include <string>
+#include <vector>
+
+#include "FileStatus.h"
+
+using namespace std;
+
+/**
+ * \addtogroup framework Framework
+ * @{
+ */
+
+/**
+ * \brief Read-only access to a file through a fixed-size chunk buffer
+ *
+ * This class reads a file chunk by chunk (at most \ref CHUNK_SIZE bytes at a time) into
+ * a buffer which is allocated once and reused for every chunk and every file opened,
+ * so files of any size can be processed periodically in fixed memory. Other than
+ * MappedFile it can safely be used for files that might be rewritten (or truncated) in
+ * place while they are read: the buffer isn't affected by such changes, they only
+ * render its contents inconsistent. The file's status recorded when it was opened can
+ * be used to detect that case (see unchanged()).
+ *
+ * \author Oliver Bock\n
+ * Max-Planck-Institute for Gravitational Physics\n
+ * Hannover, Germany
+ */
+class BufferedFile
+{
+public:
+	/// Size of the chunk buffer (maximum number of bytes per read())
+	static const size_t CHUNK_SIZE;
+
+	/// Constructor
+	BufferedFile();
+
+	/// Destructor
+	virtual ~BufferedFile();
+
+	/**
+	 * \brief Opens the given file and records its status
+	 *
+	 * A previously opened file is closed first.
+	 *
+	 * \param filename The name of the file to be opened
+	 *
+	 * \return TRUE if the file could be opened, FALSE otherwise
+	 */
+	bool open(const string filename);
+
+	/// Closes the file (the buffer's memory is kept for reuse)
+	void close();
+
+	/**
+	 * \brief Reads a chunk of the opened file into the buffer
+	 *
+	 * The buffer's previous contents are discarded.
+	 *
+	 * \param offset The file offset of the chunk
+	 * \param count The size of the chunk (at most \ref CHUNK_SIZE bytes)
+	 *
+	 * \return Pointer to the chunk (valid until the next call), NULL if it couldn't be read completely
+	 */
+	const char* read(const size_t offset, const size_t count);
+
+	/**
+	 * \brief Checks whether the file is still unchanged
+	 *
+	 * The file's current size, modification time and identity are compared to the ones
+	 * recorded when it was opened. Please note that this is a cheap heuristic, not a
+	 * guarantee, hence callers should validate the contents (e.g. by a checksum) as well.
+	 *
+	 * \return TRUE if the file seems to be unchanged, FALSE otherwise
+	 */
+	bool unchanged() const;
+
+	/**
+	 * \brief Retrieves the size of the opened file
+	 *
+	 * \return The file size recorded when it was opened
+	 */
+	size_t size() const;
+
+private:
+	/// The name of the opened file
+	string m_Filename;
+
+	/// The descriptor of the opened file (-1 if none)
+	int m_Descriptor;
+
+	/// The chunk buffer (\ref CHUNK_SIZE bytes)
+	vector<char> m_Buffer;
+
+	/// The status of the opened file (used to detect concurrent modifications)
+	FileStatus m_Status;
+};
+
+/**
+ * @}
+ */
+
+#endif /*BUFFEREDFILE_H_*/
@@ -0,0 +1,150 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef FILESTATUS_H_
+#define FILESTATUS_H_
+
+#include <string>
+#include <ctime>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+using namespace std;
+
+/**
+ * \addtogroup framework Framework
+ * @{
+ */
+
+/**
+ * \brief Status of a file used to detect concurrent modifications
+ *
+ * The status of an opened file should always be taken from its descriptor (or handle),
+ * never from its name: the file might get replaced between opening and checking it.
+ * Comparing it to the status retrieved by name later on then reveals whether the name
+ * still refers to the same, unmodified file.
+ *
+ * \see MappedFile
+ * \see BufferedFile
+ *
+ * \author Oliver Bock\n
+ * Max-Planck-Institute for Gravitational Physics\n
+ * Hannover, Germany
+ */
+struct FileStatus
+{
+	/// The file size (bytes)
+	size_t size;
+
+	/// The file's modification time
+	time_t modificationTime;
+
+	/// The file's identity (device and inode, not available on Windows)
+	unsigned long long identity;
+
+	/// Constructor
+	FileStatus() : size(0), modificationTime(0), identity(0) {}
+
+	/**
+	 * \brief Retrieves the status of an opened file
+	 *
+	 * \param fd The descriptor of the file
+	 *
+	 * \return TRUE if the file's status could be retrieved, FALSE otherwise
+	 */
+	bool fromDescriptor(const int fd)
+	{
+		struct stat status;
+		if(fstat(fd, &status) != 0) return false;
+		assign(status);
+		return true;
+	}
+
+	/**
+	 * \brief Retrieves the current status of a file by name
+	 *
+	 * \param filename The name of the file
+	 *
+	 * \return TRUE if the file's status could be retrieved, FALSE otherwise
+	 */
+	bool fromName(const string filename)
+	{
+		struct stat status;
+		if(stat(filename.c_str(), &status) != 0) return false;
+		assign(status);
+		return true;
+	}
+
+#ifdef _WIN32
+	/**
+	 * \brief Retrieves the status of an opened file
+	 *
+	 * \param file The handle of the file
+	 *
+	 * \return TRUE if the file's status could be retrieved, FALSE otherwise
+	 */
+	bool fromHandle(const HANDLE file)
+	{
+		BY_HANDLE_FILE_INFORMATION information;
+		if(!GetFileInformationByHandle(file, &information)) return false;
+
+		// FILETIME counts 100ns intervals since 1601-01-01, time_t seconds since 1970-01-01
+		const unsigned long long writeTime =
+			((unsigned long long) information.ftLastWriteTime.dwHighDateTime << 32) |
+			information.ftLastWriteTime.dwLowDateTime;
+
+		size = ((unsigned long long) information.nFileSizeHigh << 32) | information.nFileSizeLow;
+		modificationTime = (time_t) ((writeTime - 116444736000000000ULL) / 10000000ULL);
+		identity = 0;
+		return true;
+	}
+#endif
+
+	/// Compares two file states
+	bool operator==(const FileStatus &other) const
+	{
+		return size == other.size &&
+			   modificationTime == other.modificationTime &&
+			   identity == other.identity;
+	}
+
+private:
+	/// Copies the relevant fields of the given status
+	void assign(const struct stat &status)
+	{
+		size = status.st_size;
+		modificationTime = status.st_mtime;
+#ifdef _WIN32
+		identity = 0;
+#else
+		identity = ((unsigned long long) status.st_dev << 32) ^ (unsigned long long) status.st_ino;
+#endif
+	}
+};
+
+/**
+ * @}
+ */
+
+#endif /*FILESTATUS_H_*/
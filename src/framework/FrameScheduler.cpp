@@ -0,0 +1,117 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "FrameScheduler.h"
+
+#include <cmath>
+
+// weight of new measurements (exponential moving average)
+#define FRAMESCHEDULER_SMOOTHING 0.1
+
+FrameScheduler::FrameScheduler(const float frameRate)
+{
+	setFrameRate(frameRate);
+	reset(0);
+}
+
+FrameScheduler::~FrameScheduler()
+{
+}
+
+void FrameScheduler::setFrameRate(const float frameRate)
+{
+	m_Interval = 1000.0 / (frameRate > 0.0 ? frameRate : 1.0);
+}
+
+void FrameScheduler::reset(const Uint32 now)
+{
+	m_Deadline = now;
+	m_DeadlineFraction = 0.0;
+	m_FrameStart = now;
+	m_LastFrameEnd = now;
+	m_HasLastFrame = false;
+	m_FrameCost = 0.0;
+	m_FrameTime = m_Interval;
+	m_Jitter = 0.0;
+	m_DroppedFrames = 0;
+}
+
+Uint32 FrameScheduler::delay(const Uint32 now) const
+{
+	// start early enough to finish by the deadline (signed difference: wrap-around safe)
+	const Sint32 delay = (Sint32) (m_Deadline - now) - (Sint32) (m_FrameCost + 0.5);
+
+	return delay > 0 ? (Uint32) delay : 0;
+}
+
+void FrameScheduler::beginFrame(const Uint32 now)
+{
+	m_FrameStart = now;
+}
+
+void FrameScheduler::endFrame(const Uint32 now)
+{
+	// frame cost (render and swap)
+	const double cost = (Uint32) (now - m_FrameStart);
+	m_FrameCost += FRAMESCHEDULER_SMOOTHING * (cost - m_FrameCost);
+
+	// statistics
+	if(m_HasLastFrame) {
+		const double frameTime = (Uint32) (now - m_LastFrameEnd);
+		m_FrameTime += FRAMESCHEDULER_SMOOTHING * (frameTime - m_FrameTime);
+		m_Jitter += FRAMESCHEDULER_SMOOTHING * (fabs(frameTime - m_Interval) - m_Jitter);
+	}
+	m_LastFrameEnd = now;
+	m_HasLastFrame = true;
+
+	// next deadline: a slightly late frame is started right away, but deadlines
+	// that can't be met anymore are skipped (no backlog, no catching up)
+	advanceDeadline(m_Interval);
+	const double late = (Sint32) (now - m_Deadline) - m_DeadlineFraction + m_FrameCost;
+	if(late > m_Interval) {
+		const double missed = floor(late / m_Interval);
+		advanceDeadline(missed * m_Interval);
+		m_DroppedFrames += (unsigned long) missed;
+	}
+}
+
+void FrameScheduler::advanceDeadline(const double time)
+{
+	const double total = m_DeadlineFraction + time;
+	const double whole = floor(total);
+
+	m_Deadline += (Uint32) whole;
+	m_DeadlineFraction = total - whole;
+}
+
+float FrameScheduler::achievedFrameRate() const
+{
+	return m_FrameTime > 0.0 ? 1000.0 / m_FrameTime : 0.0;
+}
+
+float FrameScheduler::frameTimeJitter() const
+{
+	return m_Jitter;
+}
+
+unsigned long FrameScheduler::droppedFrames() const
+{
+	return m_DroppedFrames;
+}
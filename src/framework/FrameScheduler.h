@@ -0,0 +1,166 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef FRAMESCHEDULER_H_
+#define FRAMESCHEDULER_H_
+
+#include <SDL.h>
+
+/**
+ * \addtogroup framework Framework
+ * @{
+ */
+
+/**
+ * \brief Deadline based frame pacing
+ *
+ * This class determines when the next frame should be rendered. Each frame has a
+ * deadline (the time it should be finished) which is one frame interval after the
+ * previous one. Rendering is started ahead of the deadline by the (smoothed) measured
+ * cost of the previous frames, which includes the time spent waiting for the buffer swap.
+ *
+ * If a frame finishes too late to meet the following deadline, the missed deadlines
+ * are skipped (dropped) instead of trying to catch up, i.e. there's never more than one
+ * frame pending. The scheduler also keeps track of the achieved frame rate and the frame
+ * time jitter (both smoothed).
+ *
+ * All times are given in milliseconds (e.g. SDL_GetTicks()). They are only ever compared
+ * by their (signed) difference, so the schedule survives the wrap-around of the 32 bit
+ * tick counter (after about 49.7 days).
+ *
+ * \author Oliver Bock\n
+ * Max-Planck-Institute for Gravitational Physics\n
+ * Hannover, Germany
+ */
+class FrameScheduler
+{
+public:
+	/**
+	 * \brief Constructor
+	 *
+	 * \param frameRate The target frame rate (frames per second)
+	 */
+	FrameScheduler(const float frameRate = 20.0);
+
+	/// Destructor
+	virtual ~FrameScheduler();
+
+	/**
+	 * \brief Sets the target frame rate
+	 *
+	 * \param frameRate The target frame rate (frames per second)
+	 */
+	void setFrameRate(const float frameRate);
+
+	/**
+	 * \brief Resets the schedule (and statistics)
+	 *
+	 * \param now The current time
+	 */
+	void reset(const Uint32 now);
+
+	/**
+	 * \brief Returns the time to wait until the next frame should be started
+	 *
+	 * \param now The current time
+	 *
+	 * \return The delay until the next frame should be started (0 if it's due already)
+	 */
+	Uint32 delay(const Uint32 now) const;
+
+	/**
+	 * \brief Marks the beginning of a frame
+	 *
+	 * \param now The current time
+	 */
+	void beginFrame(const Uint32 now);
+
+	/**
+	 * \brief Marks the end of a frame and schedules the next one
+	 *
+	 * \param now The current time
+	 */
+	void endFrame(const Uint32 now);
+
+	/**
+	 * \brief Returns the achieved frame rate
+	 *
+	 * \return The achieved frame rate (frames per second, smoothed)
+	 */
+	float achievedFrameRate() const;
+
+	/**
+	 * \brief Returns the frame time jitter
+	 *
+	 * \return The mean deviation of the frame time from the target frame interval (ms, smoothed)
+	 */
+	float frameTimeJitter() const;
+
+	/**
+	 * \brief Returns the number of dropped frames
+	 *
+	 * \return The number of deadlines missed (skipped) since the last reset
+	 */
+	unsigned long droppedFrames() const;
+
+private:
+	/**
+	 * \brief Moves the deadline ahead
+	 *
+	 * \param time The time to be added to the deadline (ms)
+	 */
+	void advanceDeadline(const double time);
+
+	/// Target frame interval (ms)
+	double m_Interval;
+
+	/// Deadline of the next frame (wraps like the tick counter)
+	Uint32 m_Deadline;
+
+	/// Fractional part of the deadline (ms, 0 <= x < 1, avoids drift for fractional intervals)
+	double m_DeadlineFraction;
+
+	/// Start time of the current frame
+	Uint32 m_FrameStart;
+
+	/// End time of the previous frame (valid if \ref m_HasLastFrame is set)
+	Uint32 m_LastFrameEnd;
+
+	/// Indicator for a previous frame (since the last reset)
+	bool m_HasLastFrame;
+
+	/// Smoothed frame cost (ms)
+	double m_FrameCost;
+
+	/// Smoothed frame time (time between the ends of two consecutive frames, ms)
+	double m_FrameTime;
+
+	/// Smoothed frame time jitter (ms)
+	double m_Jitter;
+
+	/// Number of dropped frames
+	unsigned long m_DroppedFrames;
+};
+
+/**
+ * @}
+ */
+
+#endif /*FRAMESCHEDULER_H_*/
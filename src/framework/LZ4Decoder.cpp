@@ -0,0 +1,114 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <cstring>
+
+#include "LZ4Decoder.h"
+
+bool LZ4Decoder::decompress(const unsigned char *input, const size_t inputSize,
+							unsigned char *output, const size_t outputSize)
+{
+	const unsigned char *inputEnd = input + inputSize;
+	unsigned char *current = output;
+	unsigned char *outputEnd = output + outputSize;
+
+	while(input < inputEnd) {
+		// token: literal length (high nibble) and match length (low nibble)
+		const unsigned char token = *input++;
+
+		// copy literals
+		size_t literalLength = token >> 4;
+		if(literalLength == 15 && !readLength(input, inputEnd, literalLength)) {
+			return false;
+		}
+		if(literalLength > (size_t)(inputEnd - input) || literalLength > (size_t)(outputEnd - current)) {
+			return false;
+		}
+		if(literalLength <= (size_t)COPY_CHUNK && inputEnd - input >= COPY_CHUNK && outputEnd - current >= COPY_CHUNK) {
+			// short run with enough room: fixed size copy (inlined by the compiler)
+			memcpy(current, input, COPY_CHUNK);
+		}
+		else if(literalLength > 0) {
+			memcpy(current, input, literalLength);
+		}
+		input += literalLength;
+		current += literalLength;
+
+		// the last sequence has no match
+		if(input == inputEnd) {
+			break;
+		}
+
+		// read match offset (little endian)
+		if(inputEnd - input < 2) {
+			return false;
+		}
+		const size_t offset = input[0] | input[1] << 8;
+		input += 2;
+		if(offset == 0 || offset > (size_t)(current - output)) {
+			return false;
+		}
+
+		size_t matchLength = token & 0x0f;
+		if(matchLength == 15 && !readLength(input, inputEnd, matchLength)) {
+			return false;
+		}
+		matchLength += MIN_MATCH;
+		if(matchLength > (size_t)(outputEnd - current)) {
+			return false;
+		}
+
+		// copy match (byte by byte if it overlaps with its own output)
+		const unsigned char *match = current - offset;
+		if(offset >= COPY_CHUNK && outputEnd - current >= (ptrdiff_t)(matchLength + COPY_CHUNK)) {
+			// chunks don't overlap, the last one may exceed the match (overwritten later)
+			unsigned char *matchEnd = current + matchLength;
+			for(unsigned char *chunk = current; chunk < matchEnd; chunk += COPY_CHUNK, match += COPY_CHUNK) {
+				memcpy(chunk, match, COPY_CHUNK);
+			}
+			current = matchEnd;
+		}
+		else if(offset >= matchLength) {
+			memcpy(current, match, matchLength);
+			current += matchLength;
+		}
+		else {
+			for(unsigned char *matchEnd = current + matchLength; current < matchEnd; ++current, ++match) {
+				*current = *match;
+			}
+		}
+	}
+
+	return current == outputEnd;
+}
+
+bool LZ4Decoder::readLength(const unsigned char *&input, const unsigned char *inputEnd, size_t& length)
+{
+	unsigned char value;
+	do {
+		if(input == inputEnd) {
+			return false;
+		}
+		value = *input++;
+		length += value;
+	} while(value == 255);
+
+	return true;
+}
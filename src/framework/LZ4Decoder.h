@@ -0,0 +1,85 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef LZ4DECODER_H_
+#define LZ4DECODER_H_
+
+#include <cstddef>
+
+/**
+ * \addtogroup framework Framework
+ * @{
+ */
+
+/**
+ * \brief Decompressor for LZ4 compressed blocks
+ *
+ * This class decompresses data stored in the LZ4 block format (as generated by
+ * the resource compiler's LZ4Encoder). The decompressed size has to be known in
+ * advance. All input is validated, so corrupt blocks are rejected instead of
+ * causing reads or writes outside of the given buffers.
+ *
+ * \see ResourceFactory
+ *
+ * \author Oliver Bock\n
+ * Max-Planck-Institute for Gravitational Physics\n
+ * Hannover, Germany
+ */
+class LZ4Decoder
+{
+public:
+	/**
+	 * \brief Decompresses an LZ4 block
+	 *
+	 * \param input Pointer to the compressed block
+	 * \param inputSize Size of the compressed block (in bytes)
+	 * \param output Pointer to the destination buffer
+	 * \param outputSize Size of the decompressed data (in bytes)
+	 *
+	 * \return \c true if the block has been decompressed successfully
+	 * and yielded exactly \c outputSize bytes, \c false otherwise
+	 */
+	static bool decompress(const unsigned char *input, const size_t inputSize,
+						   unsigned char *output, const size_t outputSize);
+
+private:
+	/**
+	 * \brief Reads a length continuation (sequence of 255 values plus remainder)
+	 *
+	 * \param input Current read position (updated)
+	 * \param inputEnd End of the compressed block
+	 * \param length The length to be extended (updated)
+	 *
+	 * \return \c true on success, \c false if the block ended prematurely
+	 */
+	static bool readLength(const unsigned char *&input, const unsigned char *inputEnd, size_t& length);
+
+	/// Minimum match length of the format
+	static const size_t MIN_MATCH = 4;
+
+	/// Size of the fixed size copies used where the buffers leave enough room
+	static const ptrdiff_t COPY_CHUNK = 16;
+};
+
+/**
+ * @}
+ */
+
+#endif /*LZ4DECODER_H_*/
@@ -21,25 +21,38 @@
 #include "Libxml2Adapter.h"
 
 #include <iostream>
-#include <sstream>
-
-#include <libxml/xpath.h>
+#include <cstdlib>
 
 Libxml2Adapter::Libxml2Adapter()
 {
+	static bool parserInitialized = false;
+
+	// libxml2's global state is shared by all instances: set it up once, tear it down at exit
+	if(!parserInitialized) {
+		xmlInitParser();
+		atexit(xmlCleanupParser);
+		parserInitialized = true;
+	}
+
 	m_xmlDocument = NULL;
+	m_xpathContext = NULL;
 }
 
 Libxml2Adapter::~Libxml2Adapter()
 {
-	if(m_xmlDocument) xmlFreeDoc(m_xmlDocument);
-	xmlCleanupParser();
+	releaseDocument();
+
+	map<string, xmlXPathCompExprPtr>::iterator expression;
+	for(expression = m_xpathExpressions.begin(); expression != m_xpathExpressions.end(); ++expression) {
+		if(expression->second) xmlXPathFreeCompExpr(expression->second);
+	}
 }
 
 void Libxml2Adapter::setXmlDocument(const string xml, const string url)
 {
 	xmlDocPtr doc = xmlReadMemory(xml.c_str(), xml.size(), url.c_str(), NULL, 0);
 	if(doc) {
+		releaseDocument();
 		m_xmlDocument = doc;
 	}
 	else {
@@ -47,79 +60,107 @@ void Libxml2Adapter::setXmlDocument(const string xml, const string url)
 	}
 }
 
-string Libxml2Adapter::getSingleNodeContentByXPath(const string xpath)
+void Libxml2Adapter::releaseDocument()
 {
-	// no document available!
-	if(!m_xmlDocument) return("");
-
-	string result = "";
-
-	// prepare xpath context
-    xmlXPathContextPtr xpathCtx = xmlXPathNewContext(m_xmlDocument);
-    if(xpathCtx == NULL) {
-    	cerr << "Error getting XPath context!" << endl;
-    	return("");
-    }
-
-    // prepare xpath expression
-    xmlChar* xpathExpr = xmlCharStrdup(xpath.c_str());
-    if(xpathExpr == NULL) {
-    	cerr << "Error preparing XPath expression: " << xpath << endl;
-    	xmlXPathFreeContext(xpathCtx);
-    	return("");
-    }
-
-    // run xpath query
-    xmlXPathObjectPtr xpathObj = xmlXPathEvalExpression(xpathExpr, xpathCtx);
-    if(xpathObj == NULL) {
-    	cerr << "Error evaluating XPath expression: " << xpath << endl;
-    	xmlFree(xpathExpr);
-    	xmlXPathFreeContext(xpathCtx);
-    	return("");
-    }
-
-    // retrieve node set returned by xpath query
-    xmlNodeSetPtr nodes = xpathObj->nodesetval;
-
-    // how many nodes did we find?
-    int size = (nodes) ? nodes->nodeNr : 0;
-
-    if(size <= 0) {
-    	cerr << "No node found using XPath expression: " << xpath << endl;
-    	result = "";
-    }
-    else if(size > 1) {
-    	cerr << "More than node found using XPath expression: " << xpath << endl;
-    	result = "";
-    }
-    else {
-		// prepare conversion stream
-		ostringstream converter;
-		converter.exceptions(ios_base::badbit | ios_base::failbit);
-
-		// get xml content
-		xmlChar* nodeContent = xmlNodeListGetString(m_xmlDocument, nodes->nodeTab[0]->xmlChildrenNode, 1);
+	if(m_xpathContext) {
+		xmlXPathFreeContext(m_xpathContext);
+		m_xpathContext = NULL;
+	}
+
+	if(m_xmlDocument) {
+		xmlFreeDoc(m_xmlDocument);
+		m_xmlDocument = NULL;
+	}
+}
+
+xmlXPathCompExprPtr Libxml2Adapter::compiledExpression(const string& xpath)
+{
+	// already compiled?
+	map<string, xmlXPathCompExprPtr>::iterator cached = m_xpathExpressions.find(xpath);
+	if(cached != m_xpathExpressions.end()) return cached->second;
+
+	// compile xpath expression (cache invalid ones as well, they won't get any better)
+	xmlXPathCompExprPtr expression = xmlXPathCompile(BAD_CAST(xpath.c_str()));
+	if(expression == NULL) {
+		cerr << "Error preparing XPath expression: " << xpath << endl;
+	}
+
+	m_xpathExpressions[xpath] = expression;
+
+	return expression;
+}
+
+Libxml2Adapter::NodeResult Libxml2Adapter::evaluateSingleNode(const string& xpath, string& content)
+{
+	content.clear();
 
-		try {
-			// convert xml contents
-			converter << nodeContent;
-			result = converter.str();
+	// no document available!
+	if(!m_xmlDocument) return NodeError;
+
+	// prepare xpath context (once per document)
+	if(!m_xpathContext) {
+		m_xpathContext = xmlXPathNewContext(m_xmlDocument);
+		if(m_xpathContext == NULL) {
+			cerr << "Error getting XPath context!" << endl;
+			return NodeError;
 		}
-		catch(ios_base::failure) {
-			cerr << "Error converting XPath node content!" << endl;
-			result = "";
+	}
+
+	// prepare xpath expression
+	xmlXPathCompExprPtr xpathExpr = compiledExpression(xpath);
+	if(xpathExpr == NULL) return NodeError;
+
+	// run xpath query
+	xmlXPathObjectPtr xpathObj = xmlXPathCompiledEval(xpathExpr, m_xpathContext);
+	if(xpathObj == NULL) {
+		cerr << "Error evaluating XPath expression: " << xpath << endl;
+		return NodeError;
+	}
+
+	// retrieve node set returned by xpath query
+	xmlNodeSetPtr nodes = xpathObj->nodesetval;
+
+	// how many nodes did we find?
+	int size = (nodes) ? nodes->nodeNr : 0;
+
+	NodeResult result = NodeFound;
+	if(size <= 0) {
+		result = NodeNotFound;
+	}
+	else if(size > 1) {
+		result = NodeAmbiguous;
+	}
+	else {
+		// get xml content (empty nodes have none)
+		xmlChar* nodeContent = xmlNodeListGetString(m_xmlDocument, nodes->nodeTab[0]->xmlChildrenNode, 1);
+		if(nodeContent) {
+			content.assign((const char*) nodeContent);
+			xmlFree(nodeContent);
 		}
+	}
 
-		// clean up
-		xmlFree(nodeContent);
-    }
+	// clean up
+	xmlXPathFreeObject(xpathObj);
 
-    // clean up
-    xmlFree(xpathExpr);
-    xmlXPathFreeObject(xpathObj);
-    xmlXPathFreeContext(xpathCtx);
+	return result;
+}
 
-    return(result);
+string Libxml2Adapter::getSingleNodeContentByXPath(const string xpath)
+{
+	string result;
+
+	switch(evaluateSingleNode(xpath, result)) {
+		case NodeNotFound:
+			cerr << "No node found using XPath expression: " << xpath << endl;
+			break;
+		case NodeAmbiguous:
+			cerr << "More than node found using XPath expression: " << xpath << endl;
+			break;
+		default:
+			break;
+	}
+
+	return(result);
 }
 
 string Libxml2Adapter::getSingleNodeContentByXPath(const string xml, const string url, const string xpath)
@@ -128,4 +169,22 @@ string Libxml2Adapter::getSingleNodeContentByXPath(const string xml, const strin
 	return(getSingleNodeContentByXPath(xpath));
 }
 
+int Libxml2Adapter::getSingleNodeContentsByXPath(const vector<string>& xpaths, vector<string>& contents)
+{
+	int found = 0;
+
+	contents.resize(xpaths.size());
+
+	for(size_t i = 0; i < xpaths.size(); ++i) {
+		NodeResult result = evaluateSingleNode(xpaths[i], contents[i]);
 
+		if(result == NodeFound) {
+			++found;
+		}
+		else if(result == NodeAmbiguous) {
+			cerr << "More than node found using XPath expression: " << xpaths[i] << endl;
+		}
+	}
+
+	return found;
+}
@@ -22,10 +22,13 @@
 #define LIBXML2ADAPTER_H_
 
 #include <string>
+#include <vector>
+#include <map>
 
 #include "XMLProcessorInterface.h"
 
 #include <libxml/parser.h>
+#include <libxml/xpath.h>
 
 using namespace std;
 
@@ -41,6 +44,13 @@ using namespace std;
  * library because of its rich feature set that comprises DOM, SAX, XPath, XSLT as well
  * as validation based on DTD and XML Schema.
  *
+ * XPath expressions are compiled once and cached for the lifetime of the adapter instance,
+ * the XPath context is reused as long as the document doesn't change. Thus repeated queries
+ * (e.g. when reloading preferences) only cost their evaluation.
+ *
+ * libxml2's global parser state is initialized by the first instance and cleaned up at
+ * process exit, never by the destructor, since several instances may coexist.
+ *
  * \see XMLProcessorInterface
  *
  * \author Oliver Bock\n
@@ -59,6 +69,8 @@ public:
 	/**
 	 * \brief Sets the XML document to be processed
 	 *
+	 * The previous document (if any) is released. It's kept however if the new one can't be parsed.
+	 *
 	 * \param xml The XML document to be used for processing
 	 * \param url The base URL of the document
 	 */
@@ -94,9 +106,58 @@ public:
 	 */
 	string getSingleNodeContentByXPath(const string xml, const string url, const string xpath);
 
+	/**
+	 * \brief Retrieves the contents of several single nodes (elements or attributes) at once
+	 *
+	 * All expressions are evaluated using the same XPath context. Nodes which can't be found
+	 * result in empty contents without further notice.
+	 *
+	 * \param xpaths The XPath expressions to be used for searching
+	 * \param contents The nodes' contents (output, same order as \c xpaths)
+	 *
+	 * \return The number of nodes found
+	 */
+	int getSingleNodeContentsByXPath(const vector<string>& xpaths, vector<string>& contents);
+
 private:
+	/// Results of evaluateSingleNode()
+	enum NodeResult {
+		NodeFound,
+		NodeNotFound,
+		NodeAmbiguous,
+		NodeError
+	};
+
+	/**
+	 * \brief Evaluates the given XPath expression and retrieves the content of the single node found
+	 *
+	 * \param xpath The XPath expression to be used for searching
+	 * \param content The node's content (output, empty unless the node was found)
+	 *
+	 * \return The outcome of the search
+	 */
+	NodeResult evaluateSingleNode(const string& xpath, string& content);
+
+	/**
+	 * \brief Retrieves the compiled version of the given XPath expression (compiled on first use)
+	 *
+	 * \param xpath The XPath expression
+	 *
+	 * \return The compiled expression or NULL if it's invalid
+	 */
+	xmlXPathCompExprPtr compiledExpression(const string& xpath);
+
+	/// Releases the current document and its XPath context
+	void releaseDocument();
+
 	/// The current XML document instance
 	xmlDocPtr m_xmlDocument;
+
+	/// The XPath context of the current document
+	xmlXPathContextPtr m_xpathContext;
+
+	/// Cache of compiled XPath expressions (invalid ones are cached as NULL)
+	map<string, xmlXPathCompExprPtr> m_xpathExpressions;
 };
 
 /**
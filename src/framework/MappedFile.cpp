@@ -0,0 +1,167 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "MappedFile.h"
+
+#include <iostream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+MappedFile::MappedFile()
+{
+	m_Data = NULL;
+	m_Size = 0;
+
+#ifdef _WIN32
+	m_File = INVALID_HANDLE_VALUE;
+	m_Mapping = NULL;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const string filename)
+{
+	close();
+
+	m_Filename = filename;
+
+#ifdef _WIN32
+	m_File = CreateFileA(filename.c_str(),
+						 GENERIC_READ,
+						 FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+						 NULL,
+						 OPEN_EXISTING,
+						 FILE_ATTRIBUTE_NORMAL,
+						 NULL);
+
+	if(m_File == INVALID_HANDLE_VALUE) {
+		cerr << "File " << filename << " couldn't be opened!" << endl;
+		return false;
+	}
+
+	// record status of the opened file (used to detect concurrent modifications)
+	if(!m_Status.fromHandle(m_File)) {
+		cerr << "Status of file " << filename << " couldn't be retrieved!" << endl;
+		close();
+		return false;
+	}
+
+	// empty files can't be mapped
+	if(m_Status.size == 0) {
+		close();
+		return false;
+	}
+
+	m_Mapping = CreateFileMappingA(m_File, NULL, PAGE_READONLY, 0, 0, NULL);
+	if(!m_Mapping) {
+		cerr << "File " << filename << " couldn't be mapped!" << endl;
+		close();
+		return false;
+	}
+
+	m_Data = (const char*) MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, m_Status.size);
+	if(!m_Data) {
+		cerr << "File " << filename << " couldn't be mapped!" << endl;
+		close();
+		return false;
+	}
+#else
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if(fd < 0) {
+		cerr << "File " << filename << " couldn't be opened!" << endl;
+		return false;
+	}
+
+	// record status of the opened file (used to detect concurrent modifications)
+	if(!m_Status.fromDescriptor(fd)) {
+		cerr << "Status of file " << filename << " couldn't be retrieved!" << endl;
+		::close(fd);
+		return false;
+	}
+
+	// empty files can't be mapped
+	if(m_Status.size == 0) {
+		::close(fd);
+		return false;
+	}
+
+	void *mapping = mmap(NULL, m_Status.size, PROT_READ, MAP_SHARED, fd, 0);
+
+	// the mapping keeps its own reference to the file
+	::close(fd);
+
+	if(mapping == MAP_FAILED) {
+		cerr << "File " << filename << " couldn't be mapped!" << endl;
+		return false;
+	}
+
+	m_Data = (const char*) mapping;
+#endif
+
+	m_Size = m_Status.size;
+
+	return true;
+}
+
+void MappedFile::close()
+{
+#ifdef _WIN32
+	if(m_Data) UnmapViewOfFile(m_Data);
+	if(m_Mapping) CloseHandle(m_Mapping);
+	if(m_File != INVALID_HANDLE_VALUE) CloseHandle(m_File);
+
+	m_Mapping = NULL;
+	m_File = INVALID_HANDLE_VALUE;
+#else
+	if(m_Data) munmap((void*) m_Data, m_Size);
+#endif
+
+	m_Data = NULL;
+	m_Size = 0;
+}
+
+bool MappedFile::unchanged() const
+{
+	FileStatus status;
+
+	if(!m_Data || !status.fromName(m_Filename)) {
+		return false;
+	}
+
+	return status == m_Status;
+}
+
+const char* MappedFile::data() const
+{
+	return m_Data;
+}
+
+size_t MappedFile::size() const
+{
+	return m_Size;
+}
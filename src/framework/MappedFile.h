@@ -0,0 +1,131 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef MAPPEDFILE_H_
+#define MAPPEDFILE_H_
+
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "FileStatus.h"
+
+using namespace std;
+
+/**
+ * \addtogroup framework Framework
+ * @{
+ */
+
+/**
+ * \brief Read-only memory mapping of a file
+ *
+ * This class maps a complete file into memory (read-only) so its contents can be
+ * accessed in place, without reading (copying) them into a separate buffer first.
+ * It also records the file's size and modification time at the time it was opened
+ * which can be used to detect concurrent modifications (see unchanged()).
+ *
+ * Please note that mapped files must only ever be replaced (written to a temporary
+ * file which is then renamed), never rewritten in place: truncating a file while it
+ * is mapped invalidates the pages beyond its new end and accessing them raises SIGBUS.
+ * Use BufferedFile for files that might be rewritten in place.
+ *
+ * \author Oliver Bock\n
+ * Max-Planck-Institute for Gravitational Physics\n
+ * Hannover, Germany
+ */
+class MappedFile
+{
+public:
+	/// Constructor
+	MappedFile();
+
+	/// Destructor (closes the mapping)
+	virtual ~MappedFile();
+
+	/**
+	 * \brief Maps the given file into memory
+	 *
+	 * An existing mapping is closed first.
+	 *
+	 * \param filename The name of the file to be mapped
+	 *
+	 * \return TRUE if the file could be mapped, FALSE otherwise
+	 */
+	bool open(const string filename);
+
+	/// Closes the current mapping (if any)
+	void close();
+
+	/**
+	 * \brief Checks whether the mapped file is still unchanged
+	 *
+	 * The file's current size, modification time and identity (i.e. whether the name
+	 * still refers to the mapped file or to a replacement) are compared to the ones
+	 * recorded when it was opened. Please note that this is a cheap heuristic, not a guarantee,
+	 * hence callers should validate the contents (e.g. by a checksum) as well.
+	 *
+	 * \return TRUE if the file seems to be unchanged, FALSE otherwise
+	 */
+	bool unchanged() const;
+
+	/**
+	 * \brief Retrieves the mapped file contents
+	 *
+	 * \return Pointer to the file contents (NULL if nothing is mapped)
+	 */
+	const char* data() const;
+
+	/**
+	 * \brief Retrieves the size of the mapped file
+	 *
+	 * \return The size of the file contents (in bytes)
+	 */
+	size_t size() const;
+
+private:
+	/// The name of the mapped file
+	string m_Filename;
+
+	/// Pointer to the mapped file contents
+	const char *m_Data;
+
+	/// The size of the mapped file contents (as reported for the opened file)
+	size_t m_Size;
+
+	/// The status of the opened file (used to detect concurrent modifications)
+	FileStatus m_Status;
+
+#ifdef _WIN32
+	/// Handle of the mapped file
+	HANDLE m_File;
+
+	/// Handle of the file mapping object
+	HANDLE m_Mapping;
+#endif
+};
+
+/**
+ * @}
+ */
+
+#endif /*MAPPEDFILE_H_*/
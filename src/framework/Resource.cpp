@@ -20,7 +20,9 @@
 
 #include "Resource.h"
 
-Resource::Resource(const string identifier, const vector<unsigned char>& data) : m_Data(data)
+Resource::Resource(const string identifier, const unsigned char *data, const size_t size) :
+	m_Data(data),
+	m_Size(size)
 {
 	m_Identifier = identifier;
 }
@@ -34,7 +36,12 @@ string Resource::identifier() const
 	return m_Identifier;
 }
 
-const vector<unsigned char>* Resource::data() const
+const unsigned char* Resource::data() const
 {
-	return &m_Data;
+	return m_Data;
+}
+
+size_t Resource::size() const
+{
+	return m_Size;
 }
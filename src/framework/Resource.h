@@ -22,7 +22,7 @@
 #define RESOURCE_H_
 
 #include <string>
-#include <vector>
+#include <cstddef>
 
 using namespace std;
 
@@ -32,11 +32,16 @@ using namespace std;
  */
 
 /**
- * \brief Class that serves as storage container for arbitrary binary data resources
+ * \brief Class that provides access to arbitrary binary data resources
  * 
- * Instances of this class are returned by ResourceFactory and hold any kind of binary data
- * in the guise of a byte value vector identified by a descriptive string. You can access the
- * data using \ref data() and query the identifier using \ref identifier(). 
+ * Instances of this class are returned by ResourceFactory and refer to any kind of binary data
+ * in the guise of a byte value sequence identified by a descriptive string. You can access the
+ * data using \ref data() and \ref size() and query the identifier using \ref identifier().\n
+ * \n
+ * A resource doesn't own its data, it's merely a view on the resource storage compiled into
+ * the application (see \ref c_ResourceStorage) or on the decompressed copy cached by the
+ * ResourceFactory. Thus creating a resource doesn't copy any data and the data remains
+ * valid even after the resource instance has been deleted (as long as its factory exists).
  * 
  * \see ResourceFactory
  * 
@@ -51,9 +56,10 @@ public:
 	 * \brief Constructor
 	 * 
 	 * \param identifier The string used to identify this resource
-	 * \param data A vector of byte values used to initialize the resource's data container
+	 * \param data Pointer to the resource's data (not copied, has to remain valid)
+	 * \param size The size of the resource's data (in bytes)
 	 */
-	Resource(const string identifier, const vector<unsigned char>& data);
+	Resource(const string identifier, const unsigned char *data, const size_t size);
 	
 	/// Destructor
 	virtual ~Resource();
@@ -66,22 +72,31 @@ public:
 	string identifier() const;
 	
 	/**
-	 * \brief Retrieve the data stored in this resource
+	 * \brief Retrieve the data of this resource
 	 * 
 	 * The data can be accessed using the constant pointer returned by this method.
-	 * The pointer points to the beginning of a byte value sequence. The length of the
-	 * vector equals the the size of the data content.
+	 * The pointer points to the beginning of a byte value sequence of \ref size() bytes.
 	 * 
-	 * \return The base pointer to the data contained in this resource
+	 * \return The base pointer to the data of this resource
 	 */
-	const vector<unsigned char> * data() const;
+	const unsigned char* data() const;
+	
+	/**
+	 * \brief Retrieve the size of the data of this resource
+	 * 
+	 * \return The size of the data of this resource (in bytes)
+	 */
+	size_t size() const;
 	
 private:
 	/// The identifer of this resource
 	string m_Identifier;
 	
-	/// The data storage container of this resource
-	const vector<unsigned char> m_Data;
+	/// The base pointer to the data of this resource (not owned)
+	const unsigned char *m_Data;
+	
+	/// The size of the data of this resource
+	const size_t m_Size;
 };
 
 /**
@@ -19,47 +19,101 @@
  ***************************************************************************/
 
 #include "ResourceFactory.h"
+#include "LZ4Decoder.h"
 
 ResourceFactory::ResourceFactory()
 {
-	// determine number of resources
-	int resourceCount = c_ResourceIndex[0][0];
-	
-	// import each resource into factory cache
-	for(int i = 0; i < resourceCount; ++i) {
-		
-		// prepare temporary buffer
-		size_t resourceSize = c_ResourceIndex[i+1][1];
-		vector<unsigned char> buffer(resourceSize);
+	m_PackHeader = NULL;
+}
 
-		// extract resource data from storage container
-		for(size_t x = 0; x < resourceSize; ++x) {
-			
-			// use offset and relative position to find the absolute position
-			unsigned char byteValue = c_ResourceStorage[c_ResourceIndex[i+1][0] + x];
-			
-			// add byte to buffer
-			buffer[x] = byteValue;
+ResourceFactory::~ResourceFactory()
+{
+}
+
+const Resource* ResourceFactory::createInstance(const string identifier)
+{
+	Location location;
+	
+	// determine whether the requested identifier exists (pack first)
+	if(!findPackedResource(identifier, location) && !findCompiledResource(identifier, location)) {
+		return NULL;
+	}
+	
+	if(location.compression == LZ4 && location.size > 0) {
+		// compressed resource: decompress on first access
+		map<const unsigned char*, vector<unsigned char> >::iterator cached = m_DecompressedResources.find(location.data);
+		if(cached == m_DecompressedResources.end()) {
+			vector<unsigned char> buffer(location.size);
+			if(!LZ4Decoder::decompress(location.data, location.storedSize, &buffer[0], location.size)) {
+				cerr << "Resource \"" << identifier << "\" could not be decompressed!" << endl;
+				return NULL;
+			}
+			cached = m_DecompressedResources.insert(make_pair(location.data, vector<unsigned char>())).first;
+			cached->second.swap(buffer);
 		}
-		
-		// add buffer to resource map
-		m_ResourceMap[c_ResourceIdentifiers[i]] = buffer;
+		location.data = &cached->second[0];
 	}
+	else if(location.compression != Uncompressed && location.compression != LZ4) {
+		cerr << "Resource \"" << identifier << "\" uses an unknown compression method!" << endl;
+		return NULL;
+	}
+	
+	// create instance referring to its data
+	return new Resource(identifier, location.data, location.size);
 }
 
-ResourceFactory::~ResourceFactory()
+bool ResourceFactory::openPackFile(const string filename)
 {
+	// drop previous pack and its decompressed resources
+	m_PackHeader = NULL;
+	m_DecompressedResources.clear();
+	
+	if(!m_PackFile.open(filename)) {
+		cerr << "Resource pack " << filename << " couldn't be opened, using built-in resources!" << endl;
+		return false;
+	}
+	
+	m_PackHeader = ResourcePack::validate(m_PackFile.data(), m_PackFile.size());
+	if(!m_PackHeader) {
+		cerr << "Resource pack " << filename << " is invalid, using built-in resources!" << endl;
+		m_PackFile.close();
+		return false;
+	}
+	
+	return true;
 }
 
-const Resource* ResourceFactory::createInstance(const string identifier)
+bool ResourceFactory::findPackedResource(const string& identifier, Location& location) const
 {
-	Resource *res = NULL;
+	if(!m_PackHeader) return false;
+	
+	const ResourcePack::Entry *entry = ResourcePack::find(m_PackHeader, identifier.c_str(), identifier.length());
+	if(!entry) return false;
 	
-	// determine whether the requested identifier exists
-	if(m_ResourceMap.find(identifier) != m_ResourceMap.end()) {
-		// we know the requested resource, create instance
-		res = new Resource(identifier, m_ResourceMap[identifier]);
+	location.data = reinterpret_cast<const unsigned char*>(m_PackFile.data()) + entry->offset;
+	location.storedSize = entry->storedSize;
+	location.size = entry->size;
+	location.compression = entry->compression;
+	
+	return true;
+}
+
+bool ResourceFactory::findCompiledResource(const string& identifier, Location& location) const
+{
+	// determine candidate resource (index row) using the perfect hash table
+	const uint32_t seed = c_ResourceHashTable[0];
+	const uint32_t mask = c_ResourceHashTable[1];
+	const uint32_t hash = ResourcePack::hashIdentifier(identifier.c_str(), identifier.length(), seed);
+	const unsigned int row = c_ResourceHashTable[2 + (hash & mask)];
+	
+	if(row == 0 || strcmp(c_ResourceIdentifiers[row-1], identifier.c_str()) != 0) {
+		return false;
 	}
 	
-	return res;
+	location.data = c_ResourceStorage + c_ResourceIndex[row][0];
+	location.storedSize = c_ResourceIndex[row][1];
+	location.size = c_ResourceIndex[row][2];
+	location.compression = c_ResourceIndex[row][3];
+	
+	return true;
 }
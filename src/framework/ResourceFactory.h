@@ -23,9 +23,13 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include <iostream>
+#include <cstring>
 
 #include "Resource.h"
+#include "MappedFile.h"
+#include "ResourcePack.h"
 
 using namespace std;
 
@@ -37,14 +41,25 @@ using namespace std;
 /**
  * \brief This factory instantiates %Resource objects using a given identifier
  * 
- * During contruction of the factory object itself it loads all available resources into
- * an internal cache. The user can subsequently request a copy of this resource by specifying
- * it using the resource's identifier.
+ * The user can request a resource by specifying it using the resource's identifier.
+ * Resources are looked up on demand (perfect hash table generated by ORC) and
+ * merely refer to the compiled-in resource storage, so neither the factory nor the
+ * returned resource instances copy any uncompressed resource data.
  *
- * The resource data is expected to be stored in these three externally linked arrays:
+ * Compressed resources are decompressed on first access into a buffer cached by the
+ * factory. Subsequent requests of the same resource refer to that buffer. Thus the data
+ * of compressed resources is only valid as long as the factory exists.
+ *
+ * Optionally an external resource pack (see ResourcePack) can be opened using openPackFile().
+ * Resources found in the pack take precedence over the compiled-in ones, the compiled-in storage
+ * serves as fallback for all other resources (or if the pack can't be used at all). The pack
+ * is memory mapped, so its resources are only valid as long as the factory exists, too.
+ *
+ * The resource data is expected to be stored in these four externally linked arrays:
  * - \ref c_ResourceIdentifiers
  * - \ref c_ResourceIndex 
  * - \ref c_ResourceStorage
+ * - \ref c_ResourceHashTable
  *
  * These arrays are compiled using the Open %Resource Compiler (ORC) which can be found
  * in the \c orc subdirectory.
@@ -74,24 +89,90 @@ public:
 	 * \param identifier The identifer of the resource to be instantiated
 	 * 
 	 * \return A constant pointer to the newly instantiated resource
-	 * or NULL if the specified resource could not be found
+	 * or NULL if the specified resource could not be found (the caller takes ownership)
 	 * 
 	 * \see ResourceCompiler
 	 */
 	const Resource* createInstance(const string identifier);
 	
+	/**
+	 * \brief Opens an external resource pack
+	 * 
+	 * The pack file is memory mapped and validated. If this fails, the factory
+	 * continues to use the compiled-in resources only. This should be done before
+	 * any resources are created: a previously opened pack is closed, hence resources
+	 * created before might become invalid.
+	 * 
+	 * \param filename The name of the resource pack file (written by ORC)
+	 * 
+	 * \return TRUE if the resource pack can be used, FALSE otherwise
+	 * 
+	 * \see ResourcePack
+	 */
+	bool openPackFile(const string filename);
+	
+	/// Compression methods of the embedded resources (as stored by ORC)
+	enum Compression {
+		Uncompressed = 0,
+		LZ4 = 1
+	};
+	
 private:
-	/// Hashtable mapping identifiers to resource data
-	map<string, vector<unsigned char> > m_ResourceMap;
+	/// Location of a resource's (stored) data
+	struct Location {
+		/// Pointer to the stored data
+		const unsigned char *data;
+		
+		/// Size of the stored data
+		size_t storedSize;
+		
+		/// Size of the resource (uncompressed)
+		size_t size;
+		
+		/// Compression method
+		unsigned int compression;
+	};
+	
+	/**
+	 * \brief Looks up a resource in the resource pack (if any)
+	 * 
+	 * \param identifier The identifier of the resource
+	 * \param location The location of the resource (output)
+	 * 
+	 * \return TRUE if the resource has been found, FALSE otherwise
+	 */
+	bool findPackedResource(const string& identifier, Location& location) const;
+	
+	/**
+	 * \brief Looks up a resource in the compiled-in storage
+	 * 
+	 * \param identifier The identifier of the resource
+	 * \param location The location of the resource (output)
+	 * 
+	 * \return TRUE if the resource has been found, FALSE otherwise
+	 */
+	bool findCompiledResource(const string& identifier, Location& location) const;
+	
+	/// The memory mapped resource pack
+	MappedFile m_PackFile;
+	
+	/// Header of the resource pack (NULL if no valid pack is open)
+	const ResourcePack::Header *m_PackHeader;
+	
+	/// Cache of decompressed resources (identified by their stored data)
+	map<const unsigned char*, vector<unsigned char> > m_DecompressedResources;
 };
 
 /**
  * \brief Declaration of the external list of resource identifiers
  * 
+ * The identifiers are sorted in ascending order (as generated by ORC).
+ * They are plain C strings, so they are available even during static initialization.
+ * 
  * \todo Does this need to be global?
  * Maybe we should wrap a class around the generated resources?
  */
-extern const string c_ResourceIdentifiers[];
+extern const char* const c_ResourceIdentifiers[];
 
 /**
  * \brief Declaration of the external list of resource indices
@@ -100,25 +181,42 @@ extern const string c_ResourceIdentifiers[];
  * every resource in the storage container. Using these indices you
  * can easily extract a requested resource:
  * -# Offset to the resource
- * -# Length of the resource
+ * -# Length of the resource (as stored)
+ * -# Length of the resource (uncompressed)
+ * -# Compression method (see ResourceFactory::Compression)
+ *
+ * The first row holds the number of resources.
  * 
  * \todo Does this need to be global?
  * Maybe we should wrap a class around the generated resources?
  */
-extern const unsigned int c_ResourceIndex[][2];
+extern const unsigned int c_ResourceIndex[][4];
 
 /**
  * \brief Declaration of the external resource storage container
  * 
  * The container comprises all resources in a continuous byte sequence
- * expressed as hex values. Use the resource index to locate/retrieve
- * a specific resource from the container.
+ * which is assembled directly from the binary blob file written by ORC.
+ * Use the resource index to locate/retrieve a specific resource from the container.
  * 
  * \todo Does this need to be global?
  * Maybe we should wrap a class around the generated resources?
  */
 extern const unsigned char c_ResourceStorage[];
 
+/**
+ * \brief Declaration of the external perfect hash table of resource identifiers
+ * 
+ * The table maps every resource identifier to its row in \ref c_ResourceIndex
+ * without any collisions:
+ * -# Hash seed
+ * -# Hash table index mask (the table size is a power of two)
+ * -# Hash table slots (row in \ref c_ResourceIndex, 0 for empty slots)
+ * 
+ * An identifier can only be found in the slot selected by its (masked) hash value.
+ */
+extern const unsigned int c_ResourceHashTable[];
+
 /**
  * @}
  */
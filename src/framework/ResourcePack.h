@@ -0,0 +1,233 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RESOURCEPACK_H_
+#define RESOURCEPACK_H_
+
+#include <cstddef>
+#include <cstring>
+#include <stdint.h>
+
+/**
+ * \addtogroup framework Framework
+ * @{
+ */
+
+/**
+ * \brief File format of external resource packs
+ *
+ * Besides the compiled-in resource storage ORC can write the resources into a pack file
+ * which ResourceFactory maps into memory at runtime. Assets can thus be updated without
+ * rebuilding the application, and all processes using the same pack share its pages.
+ *
+ \verbatim
+ offset           size             contents
+ 0                36               header (see Header)
+ indexOffset      count * 24       index entries (see Entry, sorted by identifier)
+ hashTableOffset  (mask + 1) * 4   perfect hash table slots (entry number + 1, 0: empty)
+ namesOffset      ...              identifiers (zero terminated)
+ ...              ...              payloads (each aligned to ALIGNMENT bytes)
+ \endverbatim
+ *
+ * All fields are stored in host byte order (the magic bytes reject packs of the other one).
+ * The hash table uses the same seeded FNV-1a hash as the compiled-in \ref c_ResourceHashTable.
+ *
+ * \see ResourceFactory::openPackFile
+ * \see ResourceCompiler
+ *
+ * \author Oliver Bock\n
+ * Max-Planck-Institute for Gravitational Physics\n
+ * Hannover, Germany
+ */
+class ResourcePack
+{
+public:
+	/// Pack file header
+	struct Header {
+		/// Magic bytes identifying the file format
+		char magic[4];
+
+		/// Format version
+		uint32_t version;
+
+		/// Total size of the pack file (bytes)
+		uint32_t fileSize;
+
+		/// Number of resources
+		uint32_t count;
+
+		/// Hash seed (collision free for the identifiers)
+		uint32_t hashSeed;
+
+		/// Hash table index mask (the table size is a power of two)
+		uint32_t hashMask;
+
+		/// Offset of the index entries
+		uint32_t indexOffset;
+
+		/// Offset of the hash table slots
+		uint32_t hashTableOffset;
+
+		/// Offset of the identifiers
+		uint32_t namesOffset;
+	};
+
+	/// Index entry describing a single resource
+	struct Entry {
+		/// Offset of the (zero terminated) identifier
+		uint32_t nameOffset;
+
+		/// Length of the identifier (excluding the terminating zero)
+		uint32_t nameLength;
+
+		/// Offset of the payload
+		uint32_t offset;
+
+		/// Size of the payload (as stored)
+		uint32_t storedSize;
+
+		/// Size of the resource (uncompressed)
+		uint32_t size;
+
+		/// Compression method (see ResourceFactory::Compression)
+		uint32_t compression;
+	};
+
+	/// The format version implemented by this class
+	static const uint32_t VERSION = 1;
+
+	/// Alignment of the payloads (bytes)
+	static const uint32_t ALIGNMENT = 16;
+
+	/// Magic bytes identifying the file format
+	static const char* magic()
+	{
+		return "\177ORC";
+	}
+
+	/**
+	 * \brief Validates a pack file
+	 *
+	 * All offsets and sizes are checked, so a pack accepted by this method can
+	 * be accessed (see find()) without any further bounds checks.
+	 *
+	 * \param data Pointer to the pack file contents
+	 * \param size Size of the pack file contents
+	 *
+	 * \return Pointer to the pack file header, NULL if the pack file is invalid
+	 */
+	static const Header* validate(const char *data, const size_t size)
+	{
+		if(!data || size < sizeof(Header)) return NULL;
+
+		const Header *header = reinterpret_cast<const Header*>(data);
+		if(memcmp(header->magic, magic(), sizeof(header->magic)) != 0 ||
+		   header->version != VERSION ||
+		   header->fileSize != size) {
+			return NULL;
+		}
+
+		// check table locations (alignment and bounds)
+		const uint64_t slots = (uint64_t) header->hashMask + 1;
+		if((slots & (slots - 1)) != 0 ||
+		   header->indexOffset % 4 != 0 || header->hashTableOffset % 4 != 0 ||
+		   header->indexOffset + (uint64_t) header->count * sizeof(Entry) > size ||
+		   header->hashTableOffset + slots * sizeof(uint32_t) > size ||
+		   header->namesOffset > size) {
+			return NULL;
+		}
+
+		// check slots (entry numbers)
+		const uint32_t *table = reinterpret_cast<const uint32_t*>(data + header->hashTableOffset);
+		for(uint64_t i = 0; i < slots; ++i) {
+			if(table[i] > header->count) return NULL;
+		}
+
+		// check entries (identifiers and payloads)
+		const Entry *entries = reinterpret_cast<const Entry*>(data + header->indexOffset);
+		for(uint32_t i = 0; i < header->count; ++i) {
+			const Entry &entry = entries[i];
+			if((uint64_t) entry.nameOffset + entry.nameLength >= size ||
+			   data[entry.nameOffset + entry.nameLength] != '\0' ||
+			   (uint64_t) entry.offset + entry.storedSize > size) {
+				return NULL;
+			}
+
+			// uncompressed payloads are handed out as they are (ResourceFactory::Uncompressed)
+			if(entry.compression == 0 && entry.storedSize != entry.size) {
+				return NULL;
+			}
+		}
+
+		return header;
+	}
+
+	/**
+	 * \brief Looks up a resource in a (validated) pack file
+	 *
+	 * \param header Pointer to the pack file header returned by validate()
+	 * \param identifier The identifier of the resource
+	 * \param length The length of the identifier
+	 *
+	 * \return Pointer to the resource's index entry, NULL if the pack doesn't contain it
+	 */
+	static const Entry* find(const Header *header, const char *identifier, const size_t length)
+	{
+		const char *data = reinterpret_cast<const char*>(header);
+		const uint32_t *table = reinterpret_cast<const uint32_t*>(data + header->hashTableOffset);
+
+		const uint32_t slot = table[hashIdentifier(identifier, length, header->hashSeed) & header->hashMask];
+		if(slot == 0) return NULL;
+
+		const Entry *entry = reinterpret_cast<const Entry*>(data + header->indexOffset) + (slot - 1);
+		if(entry->nameLength != length || memcmp(data + entry->nameOffset, identifier, length) != 0) {
+			return NULL;
+		}
+
+		return entry;
+	}
+
+	/**
+	 * \brief Computes the hash value of a resource identifier (FNV-1a, seeded)
+	 *
+	 * This is used for the pack file and the compiled-in hash tables alike.
+	 *
+	 * \param identifier The resource identifier
+	 * \param length The length of the identifier
+	 * \param seed The hash seed
+	 *
+	 * \return The hash value
+	 */
+	static uint32_t hashIdentifier(const char *identifier, const size_t length, const uint32_t seed)
+	{
+		uint32_t hash = seed;
+		for(size_t i = 0; i < length; ++i) {
+			hash = (hash ^ (unsigned char) identifier[i]) * 16777619u;
+		}
+
+		return hash;
+	}
+};
+
+/**
+ * @}
+ */
+
+#endif /*RESOURCEPACK_H_*/
@@ -0,0 +1,233 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef SHAREDMEMORYAREA_H_
+#define SHAREDMEMORYAREA_H_
+
+#include <string>
+#include <cstring>
+#include <stdint.h>
+
+using namespace std;
+
+/**
+ * \addtogroup framework Framework
+ * @{
+ */
+
+/**
+ * \brief Versioned (seqlock) protocol for the shared memory area of a science application
+ *
+ * Traditionally the science application simply writes a zero terminated string (i.e. XML)
+ * into the shared memory area. The graphics application can neither tell whether that string
+ * changed since it was read last nor whether it was read while being written. Producers may
+ * therefore prefix the contents with a small header which contains a sequence counter and
+ * a generation identifying the producer run:
+ *
+ \verbatim
+ offset  size  field
+ 0       4     magic ("\177EaH", never the start of legacy text contents)
+ 4       4     protocol version (2)
+ 8       4     generation (changes whenever the producer (re)initializes the area)
+ 12      4     sequence counter (odd while the producer is writing)
+ 16      4     payload capacity (bytes, including the terminating zero)
+ 20      4     payload length (bytes, excluding the terminating zero)
+ 24      ...   payload (zero terminated string)
+ \endverbatim
+ *
+ * The producer increments the counter before and after changing the payload (see write()).
+ * The consumer copies the payload only if the generation or the counter changed since its last
+ * read and discards the copy if the counter was odd or either of them changed while copying
+ * (see read()). Neither side blocks. The generation is required since the counter restarts
+ * at 0 when a producer (re)initializes the area, so the counter alone might match the one the
+ * consumer saw last in the previous run.
+ *
+ * Shared memory areas without header (legacy producers) are still supported by the consumer.
+ *
+ * \author Oliver Bock\n
+ * Max-Planck-Institute for Gravitational Physics\n
+ * Hannover, Germany
+ */
+class SharedMemoryArea
+{
+public:
+	/// Header preceding the payload (all fields in host byte order)
+	struct Header {
+		/// Magic bytes identifying the header
+		char magic[4];
+
+		/// Protocol version
+		uint32_t version;
+
+		/// Generation (identifies the producer run)
+		volatile uint32_t generation;
+
+		/// Sequence counter (odd while the producer is writing)
+		volatile uint32_t sequence;
+
+		/// Size of the payload area (bytes, including the terminating zero)
+		uint32_t capacity;
+
+		/// Length of the current payload (bytes, excluding the terminating zero)
+		volatile uint32_t length;
+	};
+
+	/// Results of read()
+	enum ReadResult {
+		Unchanged,
+		Updated,
+		Torn
+	};
+
+	/// The protocol version implemented by this class
+	static const uint32_t VERSION = 2;
+
+	/**
+	 * \brief Checks whether the given shared memory area starts with a header
+	 *
+	 * \param area Pointer to the shared memory area
+	 *
+	 * \return TRUE if the area uses this protocol, FALSE for legacy (plain string) contents
+	 */
+	static bool hasHeader(const char *area)
+	{
+		const Header *header = reinterpret_cast<const Header*>(area);
+
+		return memcmp(header->magic, magic(), sizeof(header->magic)) == 0 && header->version == VERSION;
+	}
+
+	/**
+	 * \brief Initializes the header of a new shared memory area (producer only)
+	 *
+	 * This has to be called before the first write(), the payload will be empty.
+	 * The generation should differ between producer runs (e.g. use the process id).
+	 * If the area already carries a header of a previous run with the same generation
+	 * the generation is incremented, so consumers always notice the new run.
+	 *
+	 * \param area Pointer to the shared memory area
+	 * \param size The total size of the shared memory area (header plus payload)
+	 * \param generation The generation of this producer run
+	 *
+	 * \return Pointer to the initialized header, NULL if the area is too small
+	 */
+	static Header* initialize(char *area, const size_t size, uint32_t generation)
+	{
+		if(size <= sizeof(Header)) return NULL;
+
+		Header *header = reinterpret_cast<Header*>(area);
+		if(hasHeader(area)) {
+			if(header->generation == generation) ++generation;
+
+			// odd sequence: consumers of the previous run discard what they are copying
+			header->sequence = header->sequence | 1;
+			__sync_synchronize();
+		}
+
+		header->version = VERSION;
+		header->generation = generation;
+		header->capacity = size - sizeof(Header);
+		header->length = 0;
+		area[sizeof(Header)] = '\0';
+
+		__sync_synchronize();
+		header->sequence = 0;
+
+		// publish the header last, consumers might be watching already
+		__sync_synchronize();
+		memcpy(header->magic, magic(), sizeof(header->magic));
+
+		return header;
+	}
+
+	/**
+	 * \brief Replaces the payload (producer only)
+	 *
+	 * \param header Pointer to the header returned by initialize()
+	 * \param contents The new contents (truncated to the payload capacity if required)
+	 */
+	static void write(Header *header, const char *contents)
+	{
+		char *payload = reinterpret_cast<char*>(header + 1);
+		size_t length = strlen(contents);
+		if(length >= header->capacity) length = header->capacity - 1;
+
+		// odd sequence: write in progress
+		header->sequence = header->sequence + 1;
+		__sync_synchronize();
+
+		memcpy(payload, contents, length);
+		payload[length] = '\0';
+		header->length = length;
+
+		// even sequence: write completed
+		__sync_synchronize();
+		header->sequence = header->sequence + 1;
+	}
+
+	/**
+	 * \brief Copies the payload if it changed since the last read (consumer only)
+	 *
+	 * The copy is made into \c contents in any case except \ref Unchanged, but it's
+	 * only consistent if \ref Updated is returned. Thus you should pass a scratch buffer
+	 * (whose memory gets reused) and keep your previous contents on \ref Torn.
+	 *
+	 * \param header Pointer to the header of the shared memory area
+	 * \param generation The generation seen last (input), updated on success (output)
+	 * \param sequence The sequence seen last (input), updated on success (output)
+	 * \param contents The buffer receiving the payload
+	 *
+	 * \return \ref Unchanged (nothing copied), \ref Updated (consistent copy)
+	 * or \ref Torn (producer was writing, try again later)
+	 */
+	static ReadResult read(const Header *header, uint32_t &generation, uint32_t &sequence, string &contents)
+	{
+		const char *payload = reinterpret_cast<const char*>(header + 1);
+
+		const uint32_t begin = header->sequence;
+		__sync_synchronize();
+		const uint32_t run = header->generation;
+
+		if(begin == sequence && run == generation) return Unchanged;
+		if(begin & 1) return Torn;
+
+		// never trust the length (it might be written concurrently)
+		const uint32_t length = header->length;
+		if(length >= header->capacity) return Torn;
+
+		contents.assign(payload, length);
+
+		__sync_synchronize();
+		if(header->sequence != begin || header->generation != run) return Torn;
+
+		generation = run;
+		sequence = begin;
+		return Updated;
+	}
+
+private:
+	/// Magic bytes identifying the header (the leading DEL distinguishes it from text)
+	static const char* magic() { return "\177EaH"; }
+};
+
+/**
+ * @}
+ */
+
+#endif /*SHAREDMEMORYAREA_H_*/
@@ -0,0 +1,608 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "SimpleXMLAdapter.h"
+
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+
+const size_t SimpleXMLAdapter::Arena::BLOCK_SIZE = 16384;
+
+const int SimpleXMLAdapter::MAX_DEPTH = 256;
+
+namespace {
+	/// Shared (empty) text of elements without any
+	const char EMPTY_TEXT[] = "";
+
+	bool isSpace(const char character)
+	{
+		return character == ' ' || character == '\t' || character == '\n' || character == '\r';
+	}
+
+	void skipSpace(const char *&position)
+	{
+		while(isSpace(*position)) ++position;
+	}
+
+	bool startsWith(const char *position, const char *prefix)
+	{
+		return strncmp(position, prefix, strlen(prefix)) == 0;
+	}
+}
+
+SimpleXMLAdapter::Arena::Arena() : m_Block(0), m_Offset(0)
+{
+}
+
+SimpleXMLAdapter::Arena::~Arena()
+{
+	for(size_t i = 0; i < m_Blocks.size(); ++i) {
+		delete [] m_Blocks[i].first;
+	}
+}
+
+char* SimpleXMLAdapter::Arena::allocate(size_t size)
+{
+	size = (size + 7) & ~((size_t) 7);
+
+	// find a block with enough space left (blocks are used in order)
+	while(m_Block < m_Blocks.size()) {
+		if(m_Offset + size <= m_Blocks[m_Block].second) {
+			char *memory = m_Blocks[m_Block].first + m_Offset;
+			m_Offset += size;
+			return memory;
+		}
+		++m_Block;
+		m_Offset = 0;
+	}
+
+	// add new block (large allocations get their own one)
+	const size_t blockSize = size > BLOCK_SIZE ? size : BLOCK_SIZE;
+	m_Blocks.push_back(make_pair(new char[blockSize], blockSize));
+	m_Block = m_Blocks.size() - 1;
+	m_Offset = size;
+
+	return m_Blocks.back().first;
+}
+
+void SimpleXMLAdapter::Arena::reset()
+{
+	m_Block = 0;
+	m_Offset = 0;
+}
+
+SimpleXMLAdapter::SimpleXMLAdapter()
+{
+	m_Arena = new Arena();
+	m_SpareArena = new Arena();
+	m_Root = NULL;
+}
+
+SimpleXMLAdapter::~SimpleXMLAdapter()
+{
+	delete m_Arena;
+	delete m_SpareArena;
+}
+
+void SimpleXMLAdapter::setXmlDocument(const string xml, const string url)
+{
+	Element *root = parseDocument(xml.c_str());
+	if(root) {
+		// the spare arena holds the new document now
+		Arena *arena = m_Arena;
+		m_Arena = m_SpareArena;
+		m_SpareArena = arena;
+		m_Root = root;
+	}
+	else {
+		cerr << "Document couldn't be parsed!" << endl;
+	}
+}
+
+SimpleXMLAdapter::Element* SimpleXMLAdapter::parseDocument(const char *xml)
+{
+	const char *position = xml;
+	Element *root = NULL;
+
+	m_SpareArena->reset();
+
+	// skip byte order mark
+	if(startsWith(position, "\xEF\xBB\xBF")) position += 3;
+
+	// prolog, root element and trailing comments/processing instructions
+	while(true) {
+		skipSpace(position);
+
+		if(*position == '\0') break;
+
+		if(startsWith(position, "<?") || startsWith(position, "<!")) {
+			if(!skipMarkup(position)) return NULL;
+		}
+		else if(*position == '<' && !root) {
+			root = parseElement(position, 0);
+			if(!root) return NULL;
+		}
+		else {
+			// text outside of or more than one root element
+			return NULL;
+		}
+	}
+
+	return root;
+}
+
+SimpleXMLAdapter::Element* SimpleXMLAdapter::parseElement(const char *&position, const int depth)
+{
+	if(depth > MAX_DEPTH) return NULL;
+
+	// start tag: name
+	const char *name = ++position;
+	while(*position && !isSpace(*position) && *position != '/' && *position != '>') ++position;
+	const size_t nameLength = position - name;
+	if(nameLength == 0) return NULL;
+
+	Element *element = reinterpret_cast<Element*>(m_SpareArena->allocate(sizeof(Element)));
+	char *elementName = m_SpareArena->allocate(nameLength + 1);
+	memcpy(elementName, name, nameLength);
+	elementName[nameLength] = '\0';
+	element->name = elementName;
+	element->text = EMPTY_TEXT;
+	element->attributes = NULL;
+	element->children = NULL;
+	element->next = NULL;
+
+	// start tag: attributes
+	while(true) {
+		skipSpace(position);
+
+		if(*position == '/') {
+			// empty element
+			if(position[1] != '>') return NULL;
+			position += 2;
+			return element;
+		}
+		else if(*position == '>') {
+			++position;
+			break;
+		}
+		else if(*position == '\0') {
+			return NULL;
+		}
+
+		const char *attributeName = position;
+		while(*position && !isSpace(*position) && *position != '=' && *position != '>' && *position != '/') ++position;
+		const size_t attributeNameLength = position - attributeName;
+
+		skipSpace(position);
+		if(attributeNameLength == 0 || *position != '=') return NULL;
+		++position;
+		skipSpace(position);
+
+		const char quote = *position;
+		if(quote != '"' && quote != '\'') return NULL;
+		const char *value = ++position;
+		const char *valueEnd = strchr(value, quote);
+		if(!valueEnd) return NULL;
+		position = valueEnd + 1;
+
+		Attribute *attribute = reinterpret_cast<Attribute*>(m_SpareArena->allocate(sizeof(Attribute)));
+		char *copiedName = m_SpareArena->allocate(attributeNameLength + 1);
+		memcpy(copiedName, attributeName, attributeNameLength);
+		copiedName[attributeNameLength] = '\0';
+		attribute->name = copiedName;
+		attribute->value = copyText(value, valueEnd, true);
+		if(!attribute->value) return NULL;
+		attribute->next = element->attributes;
+		element->attributes = attribute;
+	}
+
+	// contents
+	Element *lastChild = NULL;
+	while(true) {
+		if(*position == '\0') {
+			// unterminated element
+			return NULL;
+		}
+		else if(startsWith(position, "</")) {
+			// end tag (has to match)
+			position += 2;
+			if(strncmp(position, element->name, nameLength) != 0) return NULL;
+			position += nameLength;
+			skipSpace(position);
+			if(*position != '>') return NULL;
+			++position;
+			return element;
+		}
+		else if(startsWith(position, "<![CDATA[")) {
+			const char *text = position + 9;
+			const char *textEnd = strstr(text, "]]>");
+			if(!textEnd) return NULL;
+			appendText(element, text, textEnd - text);
+			position = textEnd + 3;
+		}
+		else if(startsWith(position, "<!") || startsWith(position, "<?")) {
+			if(!skipMarkup(position)) return NULL;
+		}
+		else if(*position == '<') {
+			Element *child = parseElement(position, depth + 1);
+			if(!child) return NULL;
+
+			if(lastChild) {
+				lastChild->next = child;
+			}
+			else {
+				element->children = child;
+			}
+			lastChild = child;
+		}
+		else {
+			const char *textEnd = strchr(position, '<');
+			if(!textEnd) return NULL;
+			const char *text = copyText(position, textEnd, false);
+			if(!text) return NULL;
+			appendText(element, text, strlen(text));
+			position = textEnd;
+		}
+	}
+}
+
+bool SimpleXMLAdapter::skipMarkup(const char *&position)
+{
+	const char *end = NULL;
+
+	if(startsWith(position, "<!--")) {
+		end = strstr(position + 4, "-->");
+		if(end) end += 3;
+	}
+	else if(startsWith(position, "<?")) {
+		end = strstr(position + 2, "?>");
+		if(end) end += 2;
+	}
+	else {
+		// declaration (e.g. DOCTYPE, might contain an internal subset)
+		int brackets = 0;
+		for(end = position + 2; *end; ++end) {
+			if(*end == '[') ++brackets;
+			else if(*end == ']') --brackets;
+			else if(*end == '>' && brackets <= 0) break;
+		}
+		end = *end ? end + 1 : NULL;
+	}
+
+	if(!end) return false;
+
+	position = end;
+	return true;
+}
+
+const char* SimpleXMLAdapter::copyText(const char *begin, const char *end, bool attribute)
+{
+	// decoded text is never longer than the encoded one
+	char *text = m_SpareArena->allocate(end - begin + 1);
+	char *output = text;
+
+	for(const char *position = begin; position < end; ++position) {
+		if(*position == '&') {
+			const char *reference = position + 1;
+			const char *referenceEnd = reference;
+			while(referenceEnd < end && *referenceEnd != ';') ++referenceEnd;
+			if(referenceEnd == end) return NULL;
+
+			const size_t length = referenceEnd - reference;
+			if(length == 2 && strncmp(reference, "lt", 2) == 0) *output++ = '<';
+			else if(length == 2 && strncmp(reference, "gt", 2) == 0) *output++ = '>';
+			else if(length == 3 && strncmp(reference, "amp", 3) == 0) *output++ = '&';
+			else if(length == 4 && strncmp(reference, "quot", 4) == 0) *output++ = '"';
+			else if(length == 4 && strncmp(reference, "apos", 4) == 0) *output++ = '\'';
+			else if(length > 1 && reference[0] == '#') {
+				// numeric character reference (encoded as UTF-8)
+				char *numberEnd = NULL;
+				const unsigned long code = (reference[1] == 'x') ?
+											strtoul(reference + 2, &numberEnd, 16) :
+											strtoul(reference + 1, &numberEnd, 10);
+				if(numberEnd != referenceEnd || code == 0 || code > 0x10FFFF) return NULL;
+
+				if(code < 0x80) {
+					*output++ = (char) code;
+				}
+				else if(code < 0x800) {
+					*output++ = (char) (0xC0 | (code >> 6));
+					*output++ = (char) (0x80 | (code & 0x3F));
+				}
+				else if(code < 0x10000) {
+					*output++ = (char) (0xE0 | (code >> 12));
+					*output++ = (char) (0x80 | ((code >> 6) & 0x3F));
+					*output++ = (char) (0x80 | (code & 0x3F));
+				}
+				else {
+					*output++ = (char) (0xF0 | (code >> 18));
+					*output++ = (char) (0x80 | ((code >> 12) & 0x3F));
+					*output++ = (char) (0x80 | ((code >> 6) & 0x3F));
+					*output++ = (char) (0x80 | (code & 0x3F));
+				}
+			}
+			else {
+				// custom entities aren't supported
+				return NULL;
+			}
+
+			position = referenceEnd;
+		}
+		else if(attribute && isSpace(*position)) {
+			// attribute value normalization
+			*output++ = ' ';
+		}
+		else {
+			*output++ = *position;
+		}
+	}
+
+	*output = '\0';
+	return text;
+}
+
+void SimpleXMLAdapter::appendText(Element *element, const char *text, size_t length)
+{
+	if(length == 0) return;
+
+	// concatenate with previous text (mixed contents are rare)
+	const size_t previousLength = strlen(element->text);
+	char *combined = m_SpareArena->allocate(previousLength + length + 1);
+	memcpy(combined, element->text, previousLength);
+	memcpy(combined + previousLength, text, length);
+	combined[previousLength + length] = '\0';
+
+	element->text = combined;
+}
+
+bool SimpleXMLAdapter::compile(const string& xpath, Expression& expression)
+{
+	const char *position = xpath.c_str();
+
+	expression.steps.clear();
+	expression.attribute.clear();
+
+	// absolute location paths only (no abbreviated descendant axis)
+	if(*position != '/') return false;
+
+	while(*position == '/') {
+		++position;
+
+		// final attribute step
+		if(*position == '@') {
+			const char *name = ++position;
+			while(*position && *position != '/' && *position != '[') ++position;
+			if(*position != '\0' || position == name) return false;
+			expression.attribute.assign(name, position);
+			return !expression.steps.empty();
+		}
+
+		// final text step (same as the element content)
+		if(strcmp(position, "text()") == 0) {
+			return !expression.steps.empty();
+		}
+
+		// element step
+		Step step;
+		const char *name = position;
+		while(*position && *position != '/' && *position != '[') ++position;
+		if(position == name) return false;
+		step.name.assign(name, position);
+		if(step.name == "*") step.name.clear();
+
+		// predicates
+		while(*position == '[') {
+			Predicate predicate;
+			predicate.hasValue = false;
+			predicate.position = 0;
+
+			++position;
+			if(*position == '@') {
+				const char *attribute = ++position;
+				while(*position && *position != '=' && *position != ']') ++position;
+				if(position == attribute) return false;
+				predicate.attribute.assign(attribute, position);
+
+				if(*position == '=') {
+					const char quote = *++position;
+					if(quote != '\'' && quote != '"') return false;
+					const char *value = ++position;
+					while(*position && *position != quote) ++position;
+					if(*position != quote) return false;
+					predicate.value.assign(value, position);
+					predicate.hasValue = true;
+					++position;
+				}
+			}
+			else {
+				char *numberEnd = NULL;
+				predicate.position = strtoul(position, &numberEnd, 10);
+				if(numberEnd == position || predicate.position == 0) return false;
+				position = numberEnd;
+			}
+
+			if(*position != ']') return false;
+			++position;
+
+			step.predicates.push_back(predicate);
+		}
+
+		if(*position != '\0' && *position != '/') return false;
+
+		expression.steps.push_back(step);
+	}
+
+	return *position == '\0' && !expression.steps.empty();
+}
+
+const SimpleXMLAdapter::Expression& SimpleXMLAdapter::compiledExpression(const string& xpath)
+{
+	// already compiled?
+	map<string, Expression>::iterator cached = m_Expressions.find(xpath);
+	if(cached != m_Expressions.end()) return cached->second;
+
+	// compile xpath expression (cache invalid ones as well, they won't get any better)
+	Expression &expression = m_Expressions[xpath];
+	expression.valid = compile(xpath, expression);
+	if(!expression.valid) {
+		cerr << "Error preparing XPath expression: " << xpath << endl;
+	}
+
+	return expression;
+}
+
+const char* SimpleXMLAdapter::attributeValue(const Element *element, const string& name)
+{
+	for(const Attribute *attribute = element->attributes; attribute; attribute = attribute->next) {
+		if(name == attribute->name) return attribute->value;
+	}
+
+	return NULL;
+}
+
+SimpleXMLAdapter::NodeResult SimpleXMLAdapter::evaluateSingleNode(const string& xpath, string& content)
+{
+	content.clear();
+
+	// no document available!
+	if(!m_Root) return NodeError;
+
+	const Expression &expression = compiledExpression(xpath);
+	if(!expression.valid) return NodeError;
+
+	// the first step is matched against the root element itself
+	m_Nodes.clear();
+	for(size_t i = 0; i < expression.steps.size(); ++i) {
+		const Step &step = expression.steps[i];
+		m_Matches.clear();
+
+		// evaluate per parent (positions are relative to the parent)
+		const size_t parents = (i == 0) ? 1 : m_Nodes.size();
+		for(size_t parent = 0; parent < parents; ++parent) {
+			m_Candidates.clear();
+
+			const Element *child = (i == 0) ? m_Root : m_Nodes[parent]->children;
+			for(; child; child = (i == 0) ? NULL : child->next) {
+				if(step.name.empty() || step.name == child->name) {
+					m_Candidates.push_back(child);
+				}
+			}
+
+			for(size_t p = 0; p < step.predicates.size(); ++p) {
+				const Predicate &predicate = step.predicates[p];
+
+				if(predicate.attribute.empty()) {
+					// position predicate
+					if(predicate.position <= m_Candidates.size()) {
+						const Element *selected = m_Candidates[predicate.position - 1];
+						m_Candidates.assign(1, selected);
+					}
+					else {
+						m_Candidates.clear();
+					}
+				}
+				else {
+					// attribute predicate
+					size_t kept = 0;
+					for(size_t c = 0; c < m_Candidates.size(); ++c) {
+						const char *value = attributeValue(m_Candidates[c], predicate.attribute);
+						if(value && (!predicate.hasValue || predicate.value == value)) {
+							m_Candidates[kept++] = m_Candidates[c];
+						}
+					}
+					m_Candidates.resize(kept);
+				}
+			}
+
+			m_Matches.insert(m_Matches.end(), m_Candidates.begin(), m_Candidates.end());
+		}
+
+		m_Nodes.swap(m_Matches);
+		if(m_Nodes.empty()) return NodeNotFound;
+	}
+
+	// element content
+	if(expression.attribute.empty()) {
+		if(m_Nodes.size() > 1) return NodeAmbiguous;
+
+		content.assign(m_Nodes[0]->text);
+		return NodeFound;
+	}
+
+	// attribute content
+	const char *value = NULL;
+	for(size_t i = 0; i < m_Nodes.size(); ++i) {
+		const char *candidate = attributeValue(m_Nodes[i], expression.attribute);
+		if(candidate) {
+			if(value) return NodeAmbiguous;
+			value = candidate;
+		}
+	}
+
+	if(!value) return NodeNotFound;
+
+	content.assign(value);
+	return NodeFound;
+}
+
+string SimpleXMLAdapter::getSingleNodeContentByXPath(const string xpath)
+{
+	string result;
+
+	switch(evaluateSingleNode(xpath, result)) {
+		case NodeNotFound:
+			cerr << "No node found using XPath expression: " << xpath << endl;
+			break;
+		case NodeAmbiguous:
+			cerr << "More than node found using XPath expression: " << xpath << endl;
+			break;
+		default:
+			break;
+	}
+
+	return(result);
+}
+
+string SimpleXMLAdapter::getSingleNodeContentByXPath(const string xml, const string url, const string xpath)
+{
+	setXmlDocument(xml, url);
+	return(getSingleNodeContentByXPath(xpath));
+}
+
+int SimpleXMLAdapter::getSingleNodeContentsByXPath(const vector<string>& xpaths, vector<string>& contents)
+{
+	int found = 0;
+
+	contents.resize(xpaths.size());
+
+	for(size_t i = 0; i < xpaths.size(); ++i) {
+		NodeResult result = evaluateSingleNode(xpaths[i], contents[i]);
+
+		if(result == NodeFound) {
+			++found;
+		}
+		else if(result == NodeAmbiguous) {
+			cerr << "More than node found using XPath expression: " << xpaths[i] << endl;
+		}
+	}
+
+	return found;
+}
@@ -0,0 +1,269 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef SIMPLEXMLADAPTER_H_
+#define SIMPLEXMLADAPTER_H_
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include "XMLProcessorInterface.h"
+
+using namespace std;
+
+/**
+ * \addtogroup framework Framework
+ * @{
+ */
+
+/**
+ * \brief This class implements XMLProcessorInterface using a small built-in XML parser
+ *
+ * The XML documents processed by this framework (e.g. project preferences) are small and only
+ * queried for a handful of nodes. This adapter avoids the footprint and the global state of a full
+ * blown XML library: documents are parsed into a compact, read-only tree which is stored in an
+ * arena (memory is reused for the next document, no per-node allocations) and queried using
+ * a subset of XPath:
+ *
+ * \li absolute location paths with element name or \c * steps (e.g. \c /project_preferences/graphics)
+ * \li predicates testing attributes or positions (e.g. \c engine[\@name='starsphere'], \c engine[\@name], \c engine[2])
+ * \li an optional final attribute (e.g. \c /@fps) or \c text() step (mixed contents count as one text node)
+ *
+ * The parser is non-validating: it supports elements, attributes, comments, processing instructions,
+ * CDATA sections as well as predefined and numeric character references. DTDs are skipped, hence
+ * custom entities aren't supported.
+ *
+ * \see XMLProcessorInterface
+ * \see Libxml2Adapter
+ *
+ * \author Oliver Bock\n
+ * Max-Planck-Institute for Gravitational Physics\n
+ * Hannover, Germany
+ */
+class SimpleXMLAdapter : public XMLProcessorInterface
+{
+public:
+	/// Constructor
+	SimpleXMLAdapter();
+
+	/// Destructor
+	virtual ~SimpleXMLAdapter();
+
+	/**
+	 * \brief Sets the XML document to be processed
+	 *
+	 * The previous document is kept if the new one can't be parsed.
+	 *
+	 * \param xml The XML document to be used for processing
+	 * \param url The base URL of the document (unused)
+	 */
+	void setXmlDocument(const string xml, const string url);
+
+	/**
+	 * \brief Retrieves a single node's (element or attribute) content
+	 *
+	 * This method takes a XPath expression (see class description for the supported subset)
+	 * that properly defines how to search for a specific node (element or attribute). If the
+	 * XPath search results in more than one instance or if the node (or its content) can't be
+	 * found the return value is an empty string.
+	 *
+	 * \param xpath The XPath expression to be used for seaching
+	 *
+	 * \return The node's content or an empty string in case of an error
+	 */
+	string getSingleNodeContentByXPath(const string xpath);
+
+	/**
+	 * \brief Retrieves a single node's (element or attribute) content
+	 *
+	 * \param xml The XML document to be used for processing
+	 * \param url The base URL of the document (unused)
+	 * \param xpath The XPath expression to be used for seaching
+	 *
+	 * \return The node's content or an empty string in case of an error
+	 *
+	 * \see getSingleNodeContentByXPath(const string)
+	 */
+	string getSingleNodeContentByXPath(const string xml, const string url, const string xpath);
+
+	/**
+	 * \brief Retrieves the contents of several single nodes (elements or attributes) at once
+	 *
+	 * Nodes which can't be found result in empty contents without further notice.
+	 *
+	 * \param xpaths The XPath expressions to be used for searching
+	 * \param contents The nodes' contents (output, same order as \c xpaths)
+	 *
+	 * \return The number of nodes found
+	 */
+	int getSingleNodeContentsByXPath(const vector<string>& xpaths, vector<string>& contents);
+
+private:
+	/// Attribute of an element (stored in the arena)
+	struct Attribute {
+		const char *name;
+		const char *value;
+		Attribute *next;
+	};
+
+	/// Element (stored in the arena)
+	struct Element {
+		const char *name;
+		const char *text;
+		Attribute *attributes;
+		Element *children;
+		Element *next;
+	};
+
+	/**
+	 * \brief Simple arena allocator
+	 *
+	 * Memory is handed out from large blocks and released all at once by reset(),
+	 * the blocks themselves are kept for the next document.
+	 */
+	class Arena {
+	public:
+		Arena();
+		~Arena();
+
+		/// Allocates the given number of bytes (8 byte aligned)
+		char* allocate(size_t size);
+
+		/// Releases all allocations (blocks are reused)
+		void reset();
+
+	private:
+		/// Default block size
+		static const size_t BLOCK_SIZE;
+
+		/// The memory blocks
+		vector<pair<char*, size_t> > m_Blocks;
+
+		/// The block currently used
+		size_t m_Block;
+
+		/// The offset of the next allocation in the current block
+		size_t m_Offset;
+
+		// no copies
+		Arena(const Arena&);
+		Arena& operator=(const Arena&);
+	};
+
+	/// Predicate of a compiled XPath step
+	struct Predicate {
+		/// Attribute name (empty: position predicate)
+		string attribute;
+
+		/// Attribute value (only checked if \c hasValue is set)
+		string value;
+
+		/// Indicator for a predicate testing the attribute's value
+		bool hasValue;
+
+		/// Position (1-based, position predicates only)
+		size_t position;
+	};
+
+	/// Step of a compiled XPath expression
+	struct Step {
+		/// Element name (empty: any element)
+		string name;
+
+		/// Predicates (applied in order)
+		vector<Predicate> predicates;
+	};
+
+	/// Compiled XPath expression
+	struct Expression {
+		/// Indicator for a valid expression
+		bool valid;
+
+		/// The element steps
+		vector<Step> steps;
+
+		/// Attribute selected finally (empty: element content)
+		string attribute;
+	};
+
+	/// Results of evaluateSingleNode()
+	enum NodeResult {
+		NodeFound,
+		NodeNotFound,
+		NodeAmbiguous,
+		NodeError
+	};
+
+	/**
+	 * \brief Parses the given document into the spare arena
+	 *
+	 * \return The document's root element or NULL on errors
+	 */
+	Element* parseDocument(const char *xml);
+
+	/// Parses an element (the position points to its start tag, returns NULL on errors)
+	Element* parseElement(const char *&position, const int depth);
+
+	/// Skips comments, processing instructions and declarations (returns FALSE on errors)
+	static bool skipMarkup(const char *&position);
+
+	/// Copies (and decodes) text into the spare arena (returns NULL on errors)
+	const char* copyText(const char *begin, const char *end, bool attribute);
+
+	/// Appends text to the given element's text (stored in the spare arena)
+	void appendText(Element *element, const char *text, size_t length);
+
+	/// Retrieves the compiled version of the given XPath expression (compiled on first use)
+	const Expression& compiledExpression(const string& xpath);
+
+	/// Compiles the given XPath expression
+	static bool compile(const string& xpath, Expression& expression);
+
+	/// Evaluates the given XPath expression and retrieves the content of the single node found
+	NodeResult evaluateSingleNode(const string& xpath, string& content);
+
+	/// Looks up an attribute of an element (NULL if unavailable)
+	static const char* attributeValue(const Element *element, const string& name);
+
+	/// The arena holding the current document
+	Arena *m_Arena;
+
+	/// The arena receiving the next document (swapped after successful parsing)
+	Arena *m_SpareArena;
+
+	/// The current document's root element (NULL: no document available)
+	Element *m_Root;
+
+	/// Cache of compiled XPath expressions
+	map<string, Expression> m_Expressions;
+
+	/// Node sets used during evaluation (kept to avoid allocations)
+	vector<const Element*> m_Nodes, m_Matches, m_Candidates;
+
+	/// Maximum element nesting depth accepted by the parser
+	static const int MAX_DEPTH;
+};
+
+/**
+ * @}
+ */
+
+#endif /*SIMPLEXMLADAPTER_H_*/
@@ -0,0 +1,141 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef SNAPSHOTBUFFER_H_
+#define SNAPSHOTBUFFER_H_
+
+/**
+ * \addtogroup framework Framework
+ * @{
+ */
+
+/**
+ * \brief Lock-free buffer used to hand over data snapshots between two threads
+ *
+ * This class template passes immutable snapshots (e.g. preformatted BOINC information)
+ * from exactly one producer thread to exactly one consumer thread without any locking.
+ * It manages three slots: the producer fills the back slot and publishes it, the consumer
+ * takes over the latest published slot and reads it until it asks for the next one. Both
+ * sides only exchange slot indices (atomically), hence they never wait for each other and
+ * never see a partially written snapshot. Two slots wouldn't suffice here since the
+ * producer must not block while the consumer is still reading the front slot.
+ *
+ * The producer has to fill in \b all data of the back slot before publishing it since
+ * slots are recycled (they contain an older snapshot). Its members' memory is recycled
+ * as well, so no allocations are required once the buffers have grown to their final size.
+ *
+ * \tparam T The snapshot type (must be default constructible)
+ *
+ * \author Oliver Bock\n
+ * Max-Planck-Institute for Gravitational Physics\n
+ * Hannover, Germany
+ */
+template <class T>
+class SnapshotBuffer
+{
+public:
+	/// Constructor
+	SnapshotBuffer() : m_Back(0), m_Shared(1), m_Front(2) {}
+
+	/**
+	 * \brief Retrieves the slot to be filled by the producer
+	 *
+	 * \return The back slot (producer thread only)
+	 *
+	 * \see publish()
+	 */
+	T& back() { return m_Slots[m_Back]; }
+
+	/**
+	 * \brief Publishes the back slot (producer thread only)
+	 *
+	 * The filled back slot is exchanged with the shared slot, which becomes the new back slot.
+	 */
+	void publish()
+	{
+		m_Back = exchange(m_Back | FreshSnapshot) & SlotMask;
+	}
+
+	/**
+	 * \brief Takes over the latest published snapshot, if any (consumer thread only)
+	 *
+	 * The front slot returned by front() remains valid (and unchanged) until the next successful call.
+	 *
+	 * \return TRUE if a new snapshot has been taken over, FALSE otherwise
+	 */
+	bool update()
+	{
+		if(!(m_Shared & FreshSnapshot)) return false;
+
+		m_Front = exchange(m_Front) & SlotMask;
+		return true;
+	}
+
+	/**
+	 * \brief Retrieves the current snapshot (consumer thread only)
+	 *
+	 * \return The front slot
+	 *
+	 * \see update()
+	 */
+	const T& front() const { return m_Slots[m_Front]; }
+
+private:
+	/// Flags used to mark the shared slot index
+	enum SlotFlags {
+		SlotMask = 0x3,
+		FreshSnapshot = 0x4
+	};
+
+	/**
+	 * \brief Atomically exchanges the shared slot index (full memory barrier)
+	 *
+	 * \param slot The new shared slot index (including flags)
+	 *
+	 * \return The previous shared slot index (including flags)
+	 */
+	int exchange(const int slot)
+	{
+		int previous;
+		do {
+			previous = m_Shared;
+		} while(!__sync_bool_compare_and_swap(&m_Shared, previous, slot));
+
+		return previous;
+	}
+
+	/// The snapshot slots
+	T m_Slots[3];
+
+	/// Index of the slot owned by the producer
+	int m_Back;
+
+	/// Index of the slot in transit (plus flags)
+	volatile int m_Shared;
+
+	/// Index of the slot owned by the consumer
+	int m_Front;
+};
+
+/**
+ * @}
+ */
+
+#endif /*SNAPSHOTBUFFER_H_*/
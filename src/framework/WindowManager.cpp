@@ -23,11 +23,21 @@
 WindowManager::WindowManager()
 {
 	m_ScreensaverMode = false;
+	m_RenderEventPending = false;
+	m_FrameRate = 20;
+	m_WindowVisible = true;
+	m_WindowFocused = true;
+	m_BOINCUpdateInterval = 1000;
+	m_BOINCUpdateThread = NULL;
+	m_BOINCUpdateMutex = NULL;
+	m_BOINCUpdateCondition = NULL;
+	m_BOINCUpdateThreadQuit = false;
 	m_BoincAdapter = new BOINCClientAdapter("");
 }
 
 WindowManager::~WindowManager()
 {
+	stopBOINCUpdateThread();
 	delete m_BoincAdapter;
 }
 
@@ -64,7 +74,8 @@ bool WindowManager::initialize(const int width, const int height, const int fram
 	// override optional default values if preferred values are set
 	m_WindowedWidth = preferredWidth != 0 ? preferredWidth : width;
 	m_WindowedHeight = preferredHeight != 0 ? preferredHeight : height;
-	m_RenderEventInterval = 1000.0f / (preferredFrameRate != 0 ? preferredFrameRate : frameRate);
+	m_FrameRate = preferredFrameRate != 0 ? preferredFrameRate : frameRate;
+	m_FrameScheduler.setFrameRate(m_FrameRate);
 
 	/*
 	 * SDL_ASYNCBLIT - Surface benutzt asynchrone Blits, wenn möglich
@@ -192,9 +203,16 @@ void WindowManager::eventLoop()
 	// be sure there's at least one observer!
 	assert(eventObservers.size() > 0);
 
-	// set two main timers (interval in ms)
-	SDL_AddTimer(m_RenderEventInterval, &timerCallbackRenderEvent, NULL);
-	SDL_AddTimer(1000, &timerCallbackBOINCUpdateEvent, NULL);
+	// start BOINC update thread (fetches in the background), render events are scheduled per frame
+	m_BOINCUpdateThreadQuit = false;
+	m_BOINCUpdateMutex = SDL_CreateMutex();
+	m_BOINCUpdateCondition = SDL_CreateCond();
+	m_BOINCUpdateThread = SDL_CreateThread(&threadBOINCUpdate, this);
+	if(!m_BOINCUpdateThread) {
+		cerr << "BOINC update thread could not be started: " << SDL_GetError() << endl;
+	}
+	m_FrameScheduler.reset(SDL_GetTicks());
+	scheduleRenderEvent();
 
 	// events we don't ignore, hence use
 	//SDL_EventState(SDL_QUIT, SDL_IGNORE);
@@ -205,14 +223,12 @@ void WindowManager::eventLoop()
 	//SDL_EventState(SDL_USEREVENT, SDL_IGNORE);
 
 	// events we ignore
-	SDL_EventState(SDL_ACTIVEEVENT, SDL_IGNORE);
 	SDL_EventState(SDL_KEYUP, SDL_IGNORE);
 	SDL_EventState(SDL_JOYAXISMOTION, SDL_IGNORE);
 	SDL_EventState(SDL_JOYBALLMOTION, SDL_IGNORE);
 	SDL_EventState(SDL_JOYHATMOTION, SDL_IGNORE);
 	SDL_EventState(SDL_JOYBUTTONDOWN, SDL_IGNORE);
 	SDL_EventState(SDL_JOYBUTTONUP, SDL_IGNORE);
-	SDL_EventState(SDL_VIDEOEXPOSE, SDL_IGNORE);
 	SDL_EventState(SDL_SYSWMEVENT, SDL_IGNORE);
 
 	SDL_Event event;
@@ -221,6 +237,11 @@ void WindowManager::eventLoop()
 		if (event.type == SDL_USEREVENT &&
 			event.user.code == RenderEvent) {
 
+			m_RenderEventPending = false;
+
+			// don't render (nor schedule) anything while we're not visible
+			if(!m_WindowVisible) continue;
+
 #ifdef DEBUG_VALGRIND
 			// stop after i iterations when running valgrinded
 			static int i = 0;
@@ -228,7 +249,12 @@ void WindowManager::eventLoop()
 				i++;
 #endif
 				// notify our observers (currently exactly one, hence front())
+				m_FrameScheduler.beginFrame(SDL_GetTicks());
 				eventObservers.front()->render(dtime());
+				m_FrameScheduler.endFrame(SDL_GetTicks());
+
+				// schedule next frame (measured cost, late frames are dropped)
+				scheduleRenderEvent();
 #ifdef DEBUG_VALGRIND
 			}
 			else {
@@ -240,14 +266,28 @@ void WindowManager::eventLoop()
 		else if (event.type == SDL_USEREVENT &&
 				 event.user.code == BOINCUpdateEvent) {
 
-			// notify observers (currently exactly one, hence front()) to fetch a BOINC update
+			// notify observers (currently exactly one, hence front()) to take over the BOINC update
 			eventObservers.front()->refreshBOINCInformation();
 		}
+		else if (event.type == SDL_ACTIVEEVENT) {
+			// track window visibility (note: SDL can't tell us about occlusion by other windows)
+			if (event.active.state & SDL_APPACTIVE) {
+				setWindowVisibility(event.active.gain != 0, m_WindowFocused);
+			}
+			if (event.active.state & SDL_APPINPUTFOCUS) {
+				setWindowVisibility(m_WindowVisible, event.active.gain != 0);
+			}
+		}
+		else if (event.type == SDL_VIDEOEXPOSE) {
+			// window contents got damaged: redraw (coalesced with any pending render event)
+			scheduleRenderEvent();
+		}
 		else if (m_ScreensaverMode &&
 				(event.type == SDL_MOUSEMOTION || event.type == SDL_MOUSEBUTTONDOWN ||
 				 event.type == SDL_KEYDOWN)) {
 
 			// we're in screensaver mode so exit on user input
+			stopBOINCUpdateThread();
 			SDL_Quit();
 		}
 		else if (event.motion.state & (SDL_BUTTON(1) | SDL_BUTTON(3)) &&
@@ -288,6 +328,7 @@ void WindowManager::eventLoop()
 				(event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_ESCAPE)) {
 
 			// just exit (SDL_FreeSurface is called automatically)
+			stopBOINCUpdateThread();
 			SDL_Quit();
 
 			break;
@@ -339,6 +380,8 @@ void WindowManager::eventLoop()
 			}
 		}
 	}
+	// no-op when we've already stopped it
+	stopBOINCUpdateThread();
 }
 
 void WindowManager::registerEventObserver(AbstractGraphicsEngine *engine)
@@ -352,6 +395,65 @@ void WindowManager::unregisterEventObserver(AbstractGraphicsEngine *engine)
 	eventObservers.remove(engine);
 }
 
+void WindowManager::scheduleRenderEvent()
+{
+	// coalesce render requests (there's at most one pending), pause while invisible
+	if(m_RenderEventPending || !m_WindowVisible) return;
+	m_RenderEventPending = true;
+
+	Uint32 delay = m_FrameScheduler.delay(SDL_GetTicks());
+	if(delay > 0) {
+		// one-shot timer
+		if(SDL_AddTimer(delay, &timerCallbackRenderEvent, NULL)) return;
+
+		cerr << "Could not schedule render event: " << SDL_GetError() << endl;
+	}
+
+	// due already (or timer unavailable)
+	timerCallbackRenderEvent(0, NULL);
+}
+
+void WindowManager::setWindowVisibility(const bool visible, const bool focused)
+{
+	const bool resumed = visible && !m_WindowVisible;
+
+	m_WindowVisible = visible;
+	m_WindowFocused = focused;
+
+	if(!visible) {
+		// paused: render events are no longer scheduled, BOINC updates are slowed down
+		setBOINCUpdateInterval(5000);
+		return;
+	}
+
+	// unfocused windows (e.g. in the background) are rendered at a lower rate
+	setBOINCUpdateInterval(1000);
+	m_FrameScheduler.setFrameRate(focused ? m_FrameRate : m_FrameRate / 4.0);
+
+	if(resumed) {
+		// the time we were hidden doesn't count as dropped frames, resume with a single redraw
+		m_FrameScheduler.reset(SDL_GetTicks());
+		scheduleRenderEvent();
+	}
+}
+
+void WindowManager::setBOINCUpdateInterval(const Uint32 interval)
+{
+	// thread not running (yet)
+	if(!m_BOINCUpdateMutex) {
+		m_BOINCUpdateInterval = interval;
+		return;
+	}
+
+	SDL_mutexP(m_BOINCUpdateMutex);
+	if(interval < m_BOINCUpdateInterval) {
+		// don't let the thread wait for the previous (longer) interval
+		SDL_CondSignal(m_BOINCUpdateCondition);
+	}
+	m_BOINCUpdateInterval = interval;
+	SDL_mutexV(m_BOINCUpdateMutex);
+}
+
 Uint32 WindowManager::timerCallbackRenderEvent(Uint32 interval, void *param)
 {
 	SDL_Event event;
@@ -367,12 +469,14 @@ Uint32 WindowManager::timerCallbackRenderEvent(Uint32 interval, void *param)
 
 	SDL_PushEvent(&event);
 
-	return interval;
+	// one-shot timer (rearmed by scheduleRenderEvent())
+	return 0;
 }
 
-Uint32 WindowManager::timerCallbackBOINCUpdateEvent(Uint32 interval,
-        void *param)
+int WindowManager::threadBOINCUpdate(void *param)
 {
+	WindowManager *windowManager = (WindowManager*) param;
+
 	SDL_Event event;
 	SDL_UserEvent userevent;
 
@@ -384,9 +488,51 @@ Uint32 WindowManager::timerCallbackBOINCUpdateEvent(Uint32 interval,
 	event.type = SDL_USEREVENT;
 	event.user = userevent;
 
-	SDL_PushEvent(&event);
+	SDL_mutexP(windowManager->m_BOINCUpdateMutex);
+	while(!windowManager->m_BOINCUpdateThreadQuit) {
+		SDL_mutexV(windowManager->m_BOINCUpdateMutex);
+
+		// fetch and publish (currently exactly one observer, hence front())
+		windowManager->eventObservers.front()->fetchBOINCInformation();
 
-	return interval;
+		// notify the render thread
+		SDL_PushEvent(&event);
+
+		// wait for the next update (the interval depends on the window visibility)
+		SDL_mutexP(windowManager->m_BOINCUpdateMutex);
+		if(!windowManager->m_BOINCUpdateThreadQuit) {
+			SDL_CondWaitTimeout(windowManager->m_BOINCUpdateCondition,
+								windowManager->m_BOINCUpdateMutex,
+								windowManager->m_BOINCUpdateInterval);
+		}
+	}
+	SDL_mutexV(windowManager->m_BOINCUpdateMutex);
+
+	return 0;
+}
+
+void WindowManager::stopBOINCUpdateThread()
+{
+	if(m_BOINCUpdateThread) {
+		// tell the thread to quit and wake it up
+		SDL_mutexP(m_BOINCUpdateMutex);
+		m_BOINCUpdateThreadQuit = true;
+		SDL_CondSignal(m_BOINCUpdateCondition);
+		SDL_mutexV(m_BOINCUpdateMutex);
+
+		SDL_WaitThread(m_BOINCUpdateThread, NULL);
+		m_BOINCUpdateThread = NULL;
+	}
+
+	if(m_BOINCUpdateCondition) {
+		SDL_DestroyCond(m_BOINCUpdateCondition);
+		m_BOINCUpdateCondition = NULL;
+	}
+
+	if(m_BOINCUpdateMutex) {
+		SDL_DestroyMutex(m_BOINCUpdateMutex);
+		m_BOINCUpdateMutex = NULL;
+	}
 }
 
 int WindowManager::windowWidth() const
@@ -488,3 +634,13 @@ void WindowManager::setScreensaverMode(const bool enabled)
 {
 	m_ScreensaverMode = enabled;
 }
+
+float WindowManager::frameRate() const
+{
+	return m_FrameScheduler.achievedFrameRate();
+}
+
+float WindowManager::frameTimeJitter() const
+{
+	return m_FrameScheduler.frameTimeJitter();
+}
@@ -32,6 +32,7 @@
 
 #include "AbstractGraphicsEngine.h"
 #include "BOINCClientAdapter.h"
+#include "FrameScheduler.h"
 
 using namespace std;
 
@@ -173,21 +174,77 @@ public:
 	 */
 	void setScreensaverMode(const bool enabled);
 
+	/**
+	 * \brief Retrieve the achieved frame rate
+	 *
+	 * \return The achieved frame rate (frames per second, smoothed)
+	 *
+	 * \see FrameScheduler::achievedFrameRate()
+	 */
+	float frameRate() const;
+
+	/**
+	 * \brief Retrieve the frame time jitter
+	 *
+	 * \return The mean deviation of the frame time from the target frame interval (ms, smoothed)
+	 *
+	 * \see FrameScheduler::frameTimeJitter()
+	 */
+	float frameTimeJitter() const;
+
 private:
+	/**
+	 * \brief Schedules the next render event
+	 *
+	 * A one-shot timer is armed to trigger the next \ref RenderEvent as determined
+	 * by the frame scheduler. There's never more than one render event pending, so
+	 * subsequent calls are ignored until the pending event has been handled.
+	 *
+	 * \see FrameScheduler::delay()
+	 */
+	void scheduleRenderEvent();
+
+	/**
+	 * \brief Updates the window visibility state
+	 *
+	 * Rendering is paused while the window is hidden (e.g. minimized) and done at a
+	 * lower frame rate while the window isn't focused. BOINC updates are slowed down
+	 * while the window is hidden. When the window becomes visible again a single
+	 * redraw is triggered right away.
+	 *
+	 * Note: SDL doesn't report whether the window is fully covered by other windows,
+	 * in that case we can only rely on expose events and the focus.
+	 *
+	 * \param visible The new visibility state of the window
+	 * \param focused The new input focus state of the window
+	 */
+	void setWindowVisibility(const bool visible, const bool focused);
+
+	/**
+	 * \brief Sets the interval of the BOINC update thread
+	 *
+	 * The interval is guarded by \ref m_BOINCUpdateMutex. When it gets shorter the thread
+	 * is woken up, so it doesn't keep waiting for the longer interval (e.g. when resuming
+	 * from a hidden window it fetches right away).
+	 *
+	 * \param interval The new interval (in ms)
+	 */
+	void setBOINCUpdateInterval(const Uint32 interval);
+
 	/**
 	 * \brief Timer callback to trigger render events
 	 *
-	 * This callback is used by a SDL timer registered in \ref eventLoop().
-	 * It creates a \ref RenderEvent which is handled by eventLoop().
-	 * In order to use a constant timer interval, \c interval is
-	 * returned as it was passed.
+	 * This callback is used by a one-shot SDL timer registered in \ref scheduleRenderEvent().
+	 * It creates a \ref RenderEvent which is handled by eventLoop(). The timer is
+	 * cancelled afterwards (returns 0) and rearmed once the frame has been rendered.
 	 *
 	 * \param interval The current timer interval
 	 * \param param The user supplied parameter of the timer event
 	 *
-	 * \return The timer interval to be used for the following events
+	 * \return Always 0 (one-shot timer)
 	 *
 	 * \see eventLoop()
+	 * \see scheduleRenderEvent()
 	 * \see EventCodes
 	 *
 	 * \todo Work around static callback, otherwise we might get event conflicts
@@ -196,12 +253,13 @@ private:
     static Uint32 timerCallbackRenderEvent(Uint32 interval, void *param);
 
 	/**
-	 * \brief Timer callback to trigger BOINC update events
+	 * \brief Thread function fetching BOINC information in the background
 	 *
-	 * This callback is used by a SDL timer registered in \ref eventLoop().
-	 * It creates a \ref BOINCUpdateEvent which is handled by eventLoop().
-	 * In order to use a constant timer interval, \c interval is
-	 * returned as it was passed.
+	 * This function is run by a thread started in \ref eventLoop(). It periodically calls
+	 * AbstractGraphicsEngine::fetchBOINCInformation() (which may take a while, e.g. when
+	 * reading checkpoints) and then creates a \ref BOINCUpdateEvent which is handled by
+	 * eventLoop(), so the render thread only needs to take over the published snapshot.
+	 * The interval is adjusted to the current window visibility.
 	 *
 	 * Note: it might seem a bit strange to trigger the BOINC updates here but it's
 	 * here where \b all event controlling and propagation takes place. BOINCClientAdapter
@@ -209,24 +267,55 @@ private:
 	 * actually handling it itself. Thus AbstractGraphicsEngine handles this event
 	 * and \b uses its BOINC adapter accordingly.
 	 *
-	 * \param interval The current timer interval
-	 * \param param The user supplied parameter of the timer event
+	 * \param param The %WindowManager instance
 	 *
-	 * \return The timer interval to be used for the following events
+	 * \return Always 0
 	 *
 	 * \see eventLoop()
+	 * \see stopBOINCUpdateThread()
 	 * \see EventCodes
+	 */
+    static int threadBOINCUpdate(void *param);
+
+	/**
+	 * \brief Stops the BOINC update thread (if it's running) and waits for it to exit
 	 *
-	 * \todo Work around static callback, otherwise we might get event conflicts
-	 * when more than one instance. Maybe we should use a singleton here anyway...
+	 * \see threadBOINCUpdate()
 	 */
-    static Uint32 timerCallbackBOINCUpdateEvent(Uint32 interval, void *param);
+	void stopBOINCUpdateThread();
 
     /// Local BOINC adapter instance to read project preferences
     BOINCClientAdapter *m_BoincAdapter;
 
-    /// The render event interval (in ms) for invoking the render event observer
-    float m_RenderEventInterval;
+    /// The frame scheduler (render event timing)
+    FrameScheduler m_FrameScheduler;
+
+    /// Indicator for a scheduled (pending) render event
+    bool m_RenderEventPending;
+
+    /// The preferred frame rate (frames per second)
+    float m_FrameRate;
+
+    /// Indicator for window visibility (not minimized/hidden)
+    bool m_WindowVisible;
+
+    /// Indicator for window input focus
+    bool m_WindowFocused;
+
+    /// The BOINC update event interval (in ms, depends on the window visibility, see setBOINCUpdateInterval())
+    Uint32 m_BOINCUpdateInterval;
+
+    /// The BOINC update thread handle
+    SDL_Thread *m_BOINCUpdateThread;
+
+    /// Mutex guarding the BOINC update thread's quit indicator and interval
+    SDL_mutex *m_BOINCUpdateMutex;
+
+    /// Condition used to wake up the BOINC update thread (when it should quit)
+    SDL_cond *m_BOINCUpdateCondition;
+
+    /// The BOINC update thread's quit indicator
+    bool m_BOINCUpdateThreadQuit;
 
     /// The current width of the host's desktop
     int m_DesktopWidth;
@@ -269,7 +358,7 @@ private:
      *
      * \see eventLoop()
      * \see timerCallbackRenderEvent()
-     * \see timerCallbackBOINCUpdateEvent()
+     * \see threadBOINCUpdate()
      */
     enum EventCodes {
         RenderEvent,
@@ -0,0 +1,262 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef XMLFIELDSCANNER_H_
+#define XMLFIELDSCANNER_H_
+
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <stdint.h>
+
+using namespace std;
+
+/**
+ * \addtogroup framework Framework
+ * @{
+ */
+
+/**
+ * \brief Single-pass scanner for flat XML fragments with a fixed set of fields
+ *
+ * Science applications publish their information as small, flat XML fragments (e.g.
+ * \c graphics_info). Instead of building a document or running a generic parser this
+ * scanner walks the fragment once and converts the text contents of known elements
+ * directly into the members of a target object, without copying any strings.
+ *
+ * The fields are declared once per target class as a static table, each entry binding an
+ * element (tag) name either to a \c double member or to a member function which converts
+ * the raw text itself:
+ *
+ \code
+ const XMLFieldScanner<Adapter>::Field Adapter::FIELDS[] = {
+ 	{"fraction_done", &Adapter::m_FractionDone, NULL},
+ 	{"power_spectrum", NULL, &Adapter::parsePowerSpectrum}
+ };
+ \endcode
+ *
+ * Element names are dispatched via a perfect hash table which is set up by the constructor,
+ * hence every element costs one hash (computed while reading its name) plus one comparison.
+ * The order of the elements as well as any whitespace (also around values) doesn't matter,
+ * attributes, end tags, comments and unknown elements are skipped.
+ *
+ * \tparam T The target class
+ *
+ * \author Oliver Bock\n
+ * Max-Planck-Institute for Gravitational Physics\n
+ * Hannover, Germany
+ */
+template <class T>
+class XMLFieldScanner
+{
+public:
+	/// Converter for raw text contents (text isn't zero terminated, returns FALSE on errors)
+	typedef bool (T::*Handler)(const char *text, size_t length);
+
+	/// Field declaration (either \c number or \c handler has to be set)
+	struct Field {
+		/// The element (tag) name
+		const char *tag;
+
+		/// The member receiving the element's contents as number
+		double T::*number;
+
+		/// The member function converting the element's contents
+		Handler handler;
+	};
+
+	/**
+	 * \brief Constructor
+	 *
+	 * \param fields The field table (unique names, has to outlive the scanner, usually static)
+	 * \param count The number of fields
+	 */
+	XMLFieldScanner(const Field *fields, const size_t count) :
+		m_Fields(fields),
+		m_FieldCount(count)
+	{
+		buildHashTable();
+	}
+
+	/**
+	 * \brief Scans the given XML fragment and converts the contents of all declared fields
+	 *
+	 * \param target The object receiving the converted contents
+	 * \param xml The zero terminated XML fragment
+	 *
+	 * \return The number of fields found and converted successfully
+	 */
+	int scan(T &target, const char *xml) const
+	{
+		int converted = 0;
+		const char *position = xml;
+
+		while((position = strchr(position, '<')) != NULL) {
+			++position;
+
+			// skip end tags, comments, declarations and processing instructions
+			if(*position == '/' || *position == '!' || *position == '?') continue;
+
+			// read (and hash) element name
+			const char *name = position;
+			uint32_t hash = m_Seed;
+			while(isNameCharacter(*position)) {
+				hash = hashStep(hash, *position);
+				++position;
+			}
+			const size_t nameLength = position - name;
+
+			// skip attributes (and empty elements)
+			const char *tagEnd = strchr(position, '>');
+			if(!tagEnd) break;
+			position = tagEnd + 1;
+			if(tagEnd[-1] == '/') continue;
+
+			const Field *field = lookup(name, nameLength, hash);
+			if(!field) continue;
+
+			// the contents end with the next tag (i.e. the end tag)
+			const char *text = position;
+			const char *textEnd = strchr(text, '<');
+			if(!textEnd) break;
+			position = textEnd;
+
+			// trim whitespace
+			while(text < textEnd && isspace((unsigned char) *text)) ++text;
+			while(textEnd > text && isspace((unsigned char) textEnd[-1])) --textEnd;
+
+			if(convert(target, *field, text, textEnd - text)) {
+				++converted;
+			}
+		}
+
+		return converted;
+	}
+
+private:
+	/**
+	 * \brief Sets up the perfect hash table for the declared field names
+	 *
+	 * The table size and hash seed are chosen such that no two field names collide.
+	 */
+	void buildHashTable()
+	{
+		size_t size = 1;
+		while(size < 2 * m_FieldCount) size <<= 1;
+
+		for(;; size <<= 1) {
+			for(uint32_t seed = 2166136261u; seed < 2166136261u + 1024; ++seed) {
+				m_Slots.assign(size, -1);
+				m_Seed = seed;
+				m_Mask = size - 1;
+
+				size_t i = 0;
+				for(; i < m_FieldCount; ++i) {
+					const uint32_t slot = hash(m_Fields[i].tag) & m_Mask;
+					if(m_Slots[slot] != -1) break;
+					m_Slots[slot] = i;
+				}
+
+				if(i == m_FieldCount) return;
+			}
+		}
+	}
+
+	/**
+	 * \brief Looks up a field by its (hashed) name
+	 *
+	 * \return The field or NULL if the name wasn't declared
+	 */
+	const Field* lookup(const char *name, const size_t length, const uint32_t hash) const
+	{
+		const int index = m_Slots[hash & m_Mask];
+		if(index == -1) return NULL;
+
+		const char *tag = m_Fields[index].tag;
+		if(strncmp(tag, name, length) != 0 || tag[length] != '\0') return NULL;
+
+		return &m_Fields[index];
+	}
+
+	/**
+	 * \brief Converts the (trimmed) contents of a field
+	 *
+	 * \return TRUE on success, FALSE otherwise
+	 */
+	static bool convert(T &target, const Field &field, const char *text, const size_t length)
+	{
+		if(field.handler) {
+			return (target.*field.handler)(text, length);
+		}
+
+		if(length == 0) return false;
+
+		// the contents are followed by whitespace or a tag, both terminate the number
+		char *end = NULL;
+		const double value = strtod(text, &end);
+		if(end != text + length) return false;
+
+		target.*field.number = value;
+		return true;
+	}
+
+	/// Hashes a zero terminated name (see hashStep)
+	uint32_t hash(const char *name) const
+	{
+		uint32_t result = m_Seed;
+		while(*name) result = hashStep(result, *name++);
+		return result;
+	}
+
+	/// Incremental hash (FNV-1a, seeded)
+	static uint32_t hashStep(const uint32_t hash, const char character)
+	{
+		return (hash ^ (unsigned char) character) * 16777619u;
+	}
+
+	/// Characters allowed in element names
+	static bool isNameCharacter(const char character)
+	{
+		return isalnum((unsigned char) character) || character == '_' || character == '-' ||
+			   character == ':' || character == '.';
+	}
+
+	/// The field table
+	const Field *m_Fields;
+
+	/// The number of fields
+	size_t m_FieldCount;
+
+	/// Hash table slots (field indices, -1: empty)
+	vector<int> m_Slots;
+
+	/// Hash seed (collision free for the declared fields)
+	uint32_t m_Seed;
+
+	/// Hash table index mask
+	uint32_t m_Mask;
+};
+
+/**
+ * @}
+ */
+
+#endif /*XMLFIELDSCANNER_H_*/
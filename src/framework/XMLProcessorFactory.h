@@ -0,0 +1,65 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef XMLPROCESSORFACTORY_H_
+#define XMLPROCESSORFACTORY_H_
+
+#include "XMLProcessorInterface.h"
+
+/**
+ * \addtogroup framework Framework
+ * @{
+ */
+
+/**
+ * \brief Factory to create XML processors
+ *
+ * The XML processor implementation is selected at build time: Libxml2Adapter if
+ * \c XMLPROCESSOR_LIBXML2 is defined, SimpleXMLAdapter otherwise. The Makefiles define it
+ * by default (\c XMLPROCESSOR=libxml2), use \c XMLPROCESSOR=builtin when building both
+ * the framework and the application to drop the libxml2 dependency.
+ *
+ * \author Oliver Bock\n
+ * Max-Planck-Institute for Gravitational Physics\n
+ * Hannover, Germany
+ */
+class XMLProcessorFactory
+{
+public:
+	/// Destructor
+	virtual ~XMLProcessorFactory();
+
+	/**
+	 * \brief Instantiates a new XML processor
+	 *
+	 * \return The pointer to the new XML processor instance (to be deleted by the caller)
+	 */
+	static XMLProcessorInterface * createInstance();
+
+private:
+	/// Contructor (private since this a purely static factory)
+	XMLProcessorFactory();
+};
+
+/**
+ * @}
+ */
+
+#endif /*XMLPROCESSORFACTORY_H_*/
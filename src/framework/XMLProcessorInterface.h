@@ -22,6 +22,7 @@
 #define XMLPROCESSORINTERFACE_H_
 
 #include <string>
+#include <vector>
 
 using namespace std;
 
@@ -87,6 +88,20 @@ public:
 	 * \return The node's content or NULL in case of an error
 	 */
 	virtual string getSingleNodeContentByXPath(const string xml, const string url, const string xpath) = 0;
+
+	/**
+	 * \brief Retrieves the contents of several single nodes (elements or attributes) at once
+	 *
+	 * This method resolves a batch of XPath expressions against the current document. Each
+	 * content is set as described for getSingleNodeContentByXPath(), nodes which can't be
+	 * found (e.g. optional settings) result in empty contents without further notice.
+	 *
+	 * \param xpaths The XPath expressions to be used for searching
+	 * \param contents The nodes' contents (output, same order as \c xpaths)
+	 *
+	 * \return The number of nodes found
+	 */
+	virtual int getSingleNodeContentsByXPath(const vector<string>& xpaths, vector<string>& contents) = 0;
 };
 
 /**
@@ -0,0 +1,147 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <cstdlib>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#include "LZ4Encoder.h"
+#include "LZ4Decoder.h"
+
+using namespace std;
+
+/**
+ * \brief LZ4 resource compression test and benchmark
+ *
+ * This tool compresses randomized buffers (random, repetitive and text-like contents) with
+ * the resource compiler's LZ4Encoder, using both the fast and the high search depth, and
+ * makes sure LZ4Decoder restores them. Truncated blocks have to be rejected and corrupted
+ * ones must not make the decoder crash. Afterwards it measures ratio, compression and
+ * decompression time for the given files (e.g. the resources listed in \c resources.orc).
+ */
+
+/// Search depths under test
+const int SEARCH_DEPTHS[] = {LZ4Encoder::FAST_SEARCH_DEPTH, LZ4Encoder::HIGH_SEARCH_DEPTH};
+
+/// Names of the search depths (as used in orc resource specifications)
+const char *SEARCH_DEPTH_NAMES[] = {"lz4", "lz4hc"};
+
+/// Number of search depths under test
+const int SEARCH_DEPTH_COUNT = sizeof(SEARCH_DEPTHS) / sizeof(SEARCH_DEPTHS[0]);
+
+void printUsage() {
+	cerr << "Invalid command-line options!" << endl;
+	cerr << "Usage: lz4bench [<test buffers> [<benchmark iterations> [<file> ...]]]" << endl;
+}
+
+void fillBuffer(vector<unsigned char>& data) {
+	// random bytes, runs, a small alphabet or text-like data with short repetitions
+	const int mode = rand() % 4;
+
+	for(size_t i = 0; i < data.size(); ++i) {
+		if(mode == 0) data[i] = (unsigned char) rand();
+		else if(mode == 1) data[i] = 'a';
+		else if(mode == 2) data[i] = (unsigned char) (rand() % 3);
+		else data[i] = (i > 20 && rand() % 8) ? data[i - 1 - rand() % 20] : (unsigned char) rand();
+	}
+}
+
+bool decompress(const vector<unsigned char>& input, const size_t inputSize, vector<unsigned char>& output) {
+	return LZ4Decoder::decompress(input.empty() ? NULL : &input[0], inputSize,
+								  output.empty() ? NULL : &output[0], output.size());
+}
+
+int main(int argc, char *argv[])
+{
+	const int buffers = argc > 1 ? atoi(argv[1]) : 3000;
+	const int iterations = argc > 2 ? atoi(argv[2]) : 200;
+	if(buffers < 0 || iterations <= 0) {
+		printUsage();
+		exit(1);
+	}
+
+	// make sure all blocks survive the round trip and broken ones are handled gracefully
+	srand(1);
+	int failures = 0;
+	vector<unsigned char> input, compressed, output;
+	for(int i = 0; i < buffers; ++i) {
+		// all short lengths (end of block rules), then random ones beyond the maximum offset
+		input.resize(i < 100 ? i : rand() % 70000);
+		output.resize(input.size());
+		fillBuffer(input);
+
+		for(int d = 0; d < SEARCH_DEPTH_COUNT; ++d) {
+			LZ4Encoder::compress(input, compressed, SEARCH_DEPTHS[d]);
+
+			if(!decompress(compressed, compressed.size(), output) || output != input) ++failures;
+
+			// truncated blocks have to be rejected
+			if(compressed.size() > 1 && decompress(compressed, compressed.size() - 1, output)) ++failures;
+
+			// corrupted blocks may be accepted but must not cause invalid accesses
+			if(compressed.size() > 2) {
+				compressed[rand() % compressed.size()] ^= 1 << (rand() % 8);
+				decompress(compressed, compressed.size(), output);
+			}
+		}
+	}
+
+	printf("Test: %d buffers, %d failures\n", buffers, failures);
+
+	// benchmark all given files
+	for(int f = 3; f < argc; ++f) {
+		ifstream file(argv[f], ios::binary);
+		if(!file) {
+			cerr << "Could not open file: " << argv[f] << endl;
+			++failures;
+			continue;
+		}
+
+		input.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+		output.resize(input.size());
+		printf("Benchmark: %s, %lu bytes, %d iterations\n", argv[f], (unsigned long) input.size(), iterations);
+
+		for(int d = 0; d < SEARCH_DEPTH_COUNT; ++d) {
+			clock_t start = clock();
+			LZ4Encoder::compress(input, compressed, SEARCH_DEPTHS[d]);
+			const double compressionTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+			bool valid = true;
+			start = clock();
+			for(int i = 0; i < iterations; ++i) valid &= decompress(compressed, compressed.size(), output);
+			const double decompressionTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+			if(!valid || output != input) ++failures;
+
+			printf("%-6s %10lu bytes (%5.1f%%), %10.3f ms to compress, %10.3f us to decompress%s\n",
+				   SEARCH_DEPTH_NAMES[d], (unsigned long) compressed.size(),
+				   input.empty() ? 0.0 : 100.0 * compressed.size() / input.size(),
+				   compressionTime * 1e3, decompressionTime * 1e6 / iterations,
+				   valid && output == input ? "" : " (FAILED)");
+		}
+	}
+
+	exit(failures == 0 ? 0 : 1);
+}
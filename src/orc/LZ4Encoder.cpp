@@ -0,0 +1,165 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "LZ4Encoder.h"
+
+const int LZ4Encoder::FAST_SEARCH_DEPTH = 1;
+const int LZ4Encoder::HIGH_SEARCH_DEPTH = 256;
+
+void LZ4Encoder::compress(const vector<unsigned char>& input, vector<unsigned char>& output, const int searchDepth)
+{
+	const size_t size = input.size();
+	const unsigned char *data = size > 0 ? &input[0] : NULL;
+
+	output.clear();
+	output.reserve(size + size / 255 + 16);
+
+	size_t anchor = 0;
+
+	// blocks too small for any match are stored as literals only
+	if(size > MATCH_FIND_LIMIT) {
+
+		// hash chains: most recent position per hash and previous position per position
+		vector<long> head(1 << HASH_BITS, -1);
+		vector<long> chain(size, -1);
+
+		const size_t matchStartLimit = size - MATCH_FIND_LIMIT;
+		const size_t matchEndLimit = size - LAST_LITERALS;
+		size_t nextInsert = 0;
+		size_t position = 0;
+
+		while(position < matchStartLimit) {
+
+			// insert all preceding positions into the hash chains
+			for(; nextInsert < position; ++nextInsert) {
+				unsigned int hash = hashValue(data + nextInsert);
+				chain[nextInsert] = head[hash];
+				head[hash] = nextInsert;
+			}
+
+			size_t matchOffset = 0;
+			size_t matchLength = findMatch(data, position, matchEndLimit, searchDepth, head, chain, matchOffset);
+
+			if(matchLength < MIN_MATCH) {
+				++position;
+				continue;
+			}
+
+			// lazy matching: emit a literal if the next position yields a longer match
+			while(searchDepth > 1 && position + 1 < matchStartLimit) {
+				unsigned int hash = hashValue(data + position);
+				chain[position] = head[hash];
+				head[hash] = position;
+				nextInsert = position + 1;
+
+				size_t nextOffset = 0;
+				size_t nextLength = findMatch(data, position + 1, matchEndLimit, searchDepth, head, chain, nextOffset);
+				if(nextLength <= matchLength) break;
+
+				++position;
+				matchLength = nextLength;
+				matchOffset = nextOffset;
+			}
+
+			// store sequence and continue after the match
+			writeSequence(output, data + anchor, position - anchor, matchOffset, matchLength);
+			position += matchLength;
+			anchor = position;
+		}
+	}
+
+	// store final literals
+	writeSequence(output, data + anchor, size - anchor, 0, 0);
+}
+
+size_t LZ4Encoder::findMatch(const unsigned char *data,
+							 const size_t position,
+							 const size_t matchEndLimit,
+							 const int searchDepth,
+							 const vector<long>& head,
+							 const vector<long>& chain,
+							 size_t& offset)
+{
+	size_t matchLength = 0;
+
+	// walk the chain (most recent candidates first)
+	long candidate = head[hashValue(data + position)];
+	for(int depth = 0;
+		depth < searchDepth && candidate >= 0 && position - candidate <= MAX_OFFSET;
+		++depth, candidate = chain[candidate])
+	{
+		size_t length = 0;
+		while(position + length < matchEndLimit && data[candidate + length] == data[position + length]) {
+			++length;
+		}
+
+		if(length > matchLength) {
+			matchLength = length;
+			offset = position - candidate;
+		}
+	}
+
+	return matchLength;
+}
+
+unsigned int LZ4Encoder::hashValue(const unsigned char *data)
+{
+	// multiplicative hash of the next four bytes
+	unsigned int value = data[0] | data[1] << 8 | data[2] << 16 | (unsigned int)data[3] << 24;
+	return (value * 2654435761U) >> (32 - HASH_BITS);
+}
+
+void LZ4Encoder::writeSequence(vector<unsigned char>& output,
+							   const unsigned char *literals,
+							   const size_t literalLength,
+							   const size_t offset,
+							   const size_t matchLength)
+{
+	// token: literal length (high nibble) and match length (low nibble)
+	unsigned char token = (literalLength < 15 ? literalLength : 15) << 4;
+	if(offset > 0) {
+		token |= (matchLength - MIN_MATCH < 15 ? matchLength - MIN_MATCH : 15);
+	}
+	output.push_back(token);
+
+	// literals
+	if(literalLength >= 15) {
+		writeLength(output, literalLength - 15);
+	}
+	output.insert(output.end(), literals, literals + literalLength);
+
+	// match (little endian offset)
+	if(offset > 0) {
+		output.push_back(offset & 0xff);
+		output.push_back(offset >> 8);
+		if(matchLength - MIN_MATCH >= 15) {
+			writeLength(output, matchLength - MIN_MATCH - 15);
+		}
+	}
+}
+
+void LZ4Encoder::writeLength(vector<unsigned char>& output, size_t length)
+{
+	while(length >= 255) {
+		output.push_back(255);
+		length -= 255;
+	}
+	output.push_back(length);
+}
@@ -0,0 +1,143 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef LZ4ENCODER_H_
+#define LZ4ENCODER_H_
+
+#include <cstddef>
+#include <vector>
+
+using namespace std;
+
+/**
+ * \addtogroup orc Open Resource Compiler
+ * @{
+ */
+
+/**
+ * \brief Compressor producing LZ4 compressed blocks
+ *
+ * This class compresses a byte sequence into the LZ4 block format (without frame
+ * header or checksums) which can be decompressed very quickly by LZ4Decoder.
+ * Matches are found using hash chains: a search depth of 1 yields fast greedy
+ * compression, larger search depths additionally enable lazy matching and trade
+ * compression time (which only matters when running \c orc) for a better ratio.
+ * The decoding speed is the same for all search depths.
+ *
+ * The output conforms to the LZ4 block format rules (the last five bytes are
+ * always literals) and can therefore also be decompressed by the reference implementation.
+ *
+ * \author Oliver Bock\n
+ * Max-Planck-Institute for Gravitational Physics\n
+ * Hannover, Germany
+ */
+class LZ4Encoder
+{
+public:
+	/// Search depth used for fast (greedy) compression
+	static const int FAST_SEARCH_DEPTH;
+
+	/// Search depth used for high (lazy) compression
+	static const int HIGH_SEARCH_DEPTH;
+
+	/**
+	 * \brief Compresses the given data into an LZ4 block
+	 *
+	 * \param input The data to be compressed
+	 * \param output The compressed block (output, replaces any previous contents)
+	 * \param searchDepth Maximum number of match candidates examined per position
+	 */
+	static void compress(const vector<unsigned char>& input, vector<unsigned char>& output, const int searchDepth);
+
+private:
+	/**
+	 * \brief Finds the longest match for the given position
+	 *
+	 * \param data Pointer to the data to be compressed
+	 * \param position The position to find a match for (not yet inserted into the hash chains)
+	 * \param matchEndLimit Position at which matches have to end
+	 * \param searchDepth Maximum number of match candidates examined
+	 * \param head Most recent position per hash value
+	 * \param chain Previous position (with the same hash value) per position
+	 * \param offset Distance of the longest match (output, only set if a match has been found)
+	 *
+	 * \return The length of the longest match (0 if there's none)
+	 */
+	static size_t findMatch(const unsigned char *data,
+							const size_t position,
+							const size_t matchEndLimit,
+							const int searchDepth,
+							const vector<long>& head,
+							const vector<long>& chain,
+							size_t& offset);
+
+	/**
+	 * \brief Computes the hash chain index of the four bytes at the given position
+	 *
+	 * \param data Pointer to the four bytes
+	 *
+	 * \return The hash value (\ref HASH_BITS wide)
+	 */
+	static unsigned int hashValue(const unsigned char *data);
+
+	/**
+	 * \brief Appends a sequence (literals followed by a match) to the output block
+	 *
+	 * \param output The compressed block
+	 * \param literals Pointer to the literals
+	 * \param literalLength Number of literals
+	 * \param offset Distance of the match (0 for the final literals-only sequence)
+	 * \param matchLength Length of the match (ignored for the final sequence)
+	 */
+	static void writeSequence(vector<unsigned char>& output,
+							  const unsigned char *literals,
+							  const size_t literalLength,
+							  const size_t offset,
+							  const size_t matchLength);
+
+	/**
+	 * \brief Appends a length continuation (sequence of 255 values plus remainder)
+	 *
+	 * \param output The compressed block
+	 * \param length The length exceeding the token's nibble
+	 */
+	static void writeLength(vector<unsigned char>& output, size_t length);
+
+	/// Minimum match length of the format
+	static const size_t MIN_MATCH = 4;
+
+	/// Number of trailing bytes which have to be literals
+	static const size_t LAST_LITERALS = 5;
+
+	/// Distance from the end of the block within which no match may start
+	static const size_t MATCH_FIND_LIMIT = 12;
+
+	/// Maximum match distance of the format
+	static const size_t MAX_OFFSET = 65535;
+
+	/// Number of bits of the hash table index
+	static const int HASH_BITS = 16;
+};
+
+/**
+ * @}
+ */
+
+#endif /*LZ4ENCODER_H_*/
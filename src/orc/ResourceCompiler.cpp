@@ -19,11 +19,23 @@
  ***************************************************************************/
 
 #include "ResourceCompiler.h"
+#include "LZ4Encoder.h"
 
-ResourceCompiler::ResourceCompiler(const string inputFilename, const string outputFilename)
+ResourceCompiler::ResourceCompiler(const string inputFilename, const string outputFilename, const string packFilename)
 {
 	m_ResourceSpecFile = inputFilename;
 	m_ResourceCodeFile = outputFilename;
+	m_ResourcePackFile = packFilename;
+	
+	// derive blob filename from code filename (replace extension)
+	size_t extension = m_ResourceCodeFile.find_last_of('.');
+	size_t directory = m_ResourceCodeFile.find_last_of("/\\");
+	if(extension == string::npos || (directory != string::npos && extension < directory)) {
+		m_ResourceBlobFile = m_ResourceCodeFile + ".bin";
+	}
+	else {
+		m_ResourceBlobFile = m_ResourceCodeFile.substr(0, extension) + ".bin";
+	}
 }
 
 ResourceCompiler::~ResourceCompiler()
@@ -38,17 +50,27 @@ void ResourceCompiler::compile()
 	// load the binary files (resource <-> data mapping)
 	loadBinaryData();
 	
+	// compress them as specified
+	compressBinaryData();
+	
+	// store the resource data (referenced by the code file)
+	writeBinaryData();
+	
+	// store the resource pack (optional)
+	if(!m_ResourcePackFile.empty()) {
+		writePackFile();
+	}
+	
 	// temporary variables
 	ostringstream resourceIdentifierInitializer;
 	ostringstream resourceIndexInitializer;
-	ostringstream resourceStorageInitializer;
+	ostringstream resourceHashInitializer;
 	
 	map<string, vector<unsigned char> >::iterator mapPos;
-	vector<unsigned char>::iterator dataPos;
 	unsigned int currentIndex = 0;
 	
 	// store total amount of resources
-	resourceIndexInitializer << "{0x" << hex << m_ResourceDataMap.size() << ", 0x0},";
+	resourceIndexInitializer << "{0x" << hex << m_ResourceDataMap.size() << ", 0x0, 0x0, 0x0},";
 	
 	// iterate over all resource data mappings we have
 	for(mapPos = m_ResourceDataMap.begin(); mapPos != m_ResourceDataMap.end(); ++mapPos) {
@@ -56,16 +78,23 @@ void ResourceCompiler::compile()
 		// store identifier
 		resourceIdentifierInitializer << "\"" << mapPos->first << "\",";
 		
-		// store data base index
+		// store data base index, stored size, original size and compression method
 		resourceIndexInitializer << "{0x" << hex << currentIndex << ",";
-		resourceIndexInitializer << "0x" << hex << mapPos->second.size() << "},";
+		resourceIndexInitializer << "0x" << hex << mapPos->second.size() << ",";
+		resourceIndexInitializer << "0x" << hex << m_ResourceSizeMap[mapPos->first] << ",";
+		resourceIndexInitializer << "0x" << hex << m_ResourceCompressionMap[mapPos->first] << "},";
 		currentIndex += mapPos->second.size();
-
-		// iterate over the data content byte by byte
-		for(dataPos = mapPos->second.begin(); dataPos != mapPos->second.end(); ++dataPos) {
-			// store byte value as part of array initializer
-			resourceStorageInitializer << "0x" << hex << (int)*dataPos << ",";
-		}
+	}
+	
+	// store perfect hash parameters (seed, mask) and slots (index rows)
+	vector<unsigned int> hashSlots;
+	unsigned int hashSeed = 0;
+	buildHashTable(hashSlots, hashSeed);
+	
+	resourceHashInitializer << "0x" << hex << hashSeed << ",";
+	resourceHashInitializer << "0x" << hex << hashSlots.size() - 1 << ",";
+	for(size_t i = 0; i < hashSlots.size(); ++i) {
+		resourceHashInitializer << "0x" << hex << hashSlots[i] << ",";
 	}
 	
 	// open the output code file
@@ -79,22 +108,44 @@ void ResourceCompiler::compile()
 	outputFile.exceptions(ios::failbit | ios::badbit);
 	
 	try {
-		// write header
-		outputFile << "#include <string>" << endl << endl;
+		// write resource storage (assembled from blob file, symbol and section depend on object format)
+		outputFile << "#define ORC_STRING(x) #x" << endl;
+		outputFile << "#define ORC_SYMBOL(prefix, name) ORC_STRING(prefix) #name" << endl << endl;
+		outputFile << "#if defined(__APPLE__)" << endl;
+		outputFile << "#define ORC_SECTION_BEGIN \".pushsection __DATA,__const\"" << endl;
+		outputFile << "#define ORC_SECTION_END \".popsection\"" << endl;
+		outputFile << "#elif defined(_WIN32)" << endl;
+		outputFile << "// COFF assemblers have no section stack: this block precedes all code and data," << endl;
+		outputFile << "// i.e. the compiler hasn't selected a section yet and re-selects one afterwards" << endl;
+		outputFile << "#define ORC_SECTION_BEGIN \".section .rdata,\\\"dr\\\"\"" << endl;
+		outputFile << "#define ORC_SECTION_END \".text\"" << endl;
+		outputFile << "#else" << endl;
+		outputFile << "#define ORC_SECTION_BEGIN \".pushsection .rodata\"" << endl;
+		outputFile << "#define ORC_SECTION_END \".popsection\"" << endl;
+		outputFile << "#endif" << endl << endl;
+		outputFile << "__asm__(" << endl;
+		outputFile << "\tORC_SECTION_BEGIN \"\\n\"" << endl;
+		outputFile << "\t\".globl \" ORC_SYMBOL(__USER_LABEL_PREFIX__, c_ResourceStorage) \"\\n\"" << endl;
+		outputFile << "\t\".balign 16\\n\"" << endl;
+		outputFile << "\tORC_SYMBOL(__USER_LABEL_PREFIX__, c_ResourceStorage) \":\\n\"" << endl;
+		outputFile << "\t\".incbin \\\"" << escapeAssemblerString(m_ResourceBlobFile) << "\\\"\\n\"" << endl;
+		outputFile << "\t\".byte 0\\n\"" << endl;
+		outputFile << "\tORC_SECTION_END \"\\n\"" << endl;
+		outputFile << ");" << endl << endl;
 		
 		// write code file contents (remove trailing commas)
 		string output = resourceIdentifierInitializer.str();
-		outputFile << "extern const std::string c_ResourceIdentifiers[] = {" << endl;
+		outputFile << "extern const char* const c_ResourceIdentifiers[] = {" << endl;
 		outputFile << output.substr(0, output.length() - 1);
 		outputFile << endl << "};" << endl << endl;
 		
 		output = resourceIndexInitializer.str();
-		outputFile << "extern const unsigned int c_ResourceIndex[][2] = {" << endl;		
+		outputFile << "extern const unsigned int c_ResourceIndex[][4] = {" << endl;		
 		outputFile << output.substr(0, output.length() - 1);
 		outputFile << endl << "};" << endl << endl;
 		
-		output = resourceStorageInitializer.str();
-		outputFile << "extern const unsigned char c_ResourceStorage[] = {" << endl;
+		output = resourceHashInitializer.str();
+		outputFile << "extern const unsigned int c_ResourceHashTable[] = {" << endl;
 		outputFile << output.substr(0, output.length() - 1);
 		outputFile << endl << "};" << endl << endl;
 	}
@@ -107,6 +158,30 @@ void ResourceCompiler::compile()
 	outputFile.close();
 }
 
+void ResourceCompiler::buildHashTable(vector<unsigned int>& slots, unsigned int& seed) const
+{
+	map<string, vector<unsigned char> >::const_iterator pos;
+	
+	size_t size = 1;
+	while(size < 2 * m_ResourceDataMap.size()) size <<= 1;
+	
+	// find table size and seed without collisions (slots store index rows, 0 is empty)
+	for(;; size <<= 1) {
+		for(seed = 2166136261u; seed < 2166136261u + 1024; ++seed) {
+			slots.assign(size, 0);
+			
+			unsigned int row = 1;
+			for(pos = m_ResourceDataMap.begin(); pos != m_ResourceDataMap.end(); ++pos, ++row) {
+				const unsigned int slot = ResourcePack::hashIdentifier(pos->first.c_str(), pos->first.length(), seed) & (size - 1);
+				if(slots[slot] != 0) break;
+				slots[slot] = row;
+			}
+			
+			if(pos == m_ResourceDataMap.end()) return;
+		}
+	}
+}
+
 void ResourceCompiler::parseInputFile()
 {
 	// open input file
@@ -124,21 +199,38 @@ void ResourceCompiler::parseInputFile()
 		// read input file line by line
 		while(getline(inputFile, line)) {
 			
-			unsigned int firstCharacter = line.find_first_not_of(" \t\r\n\f");
+			// ignore trailing whitespace (e.g. DOS line endings)
+			line.erase(line.find_last_not_of(" \t\r\n\f") + 1);
+			
+			size_t firstCharacter = line.find_first_not_of(" \t\r\n\f");
 			
 			// we (sort of) allow for empty lines and comments
 			if(firstCharacter != string::npos && line.substr(firstCharacter, 1) != "#") { 
 				
-				// find our token delimiter
-				unsigned int separator = line.find("|");
+				// find our token delimiters (the second one is optional)
+				size_t separator = line.find("|");
+				size_t methodSeparator = line.rfind("|");
+				
+				string method = "none";
+				if(methodSeparator != separator) {
+					method = line.substr(methodSeparator + 1);
+				}
+				else {
+					methodSeparator = string::npos;
+				}
 				
-				// make sure there's exactly one delimiter
-				if(separator == string::npos || separator != line.rfind("|")) {
+				// make sure there are one or two delimiters and a known compression method
+				if(separator == string::npos || count(line.begin(), line.end(), '|') > 2) {
 					cerr << "Unexpected resource specification: " << line << endl;
 				}
+				else if(method != "none" && method != "lz4" && method != "lz4hc") {
+					cerr << "Unexpected resource compression: " << line << endl;
+				}
 				else {
 					// store tokens in resource file map
-					m_ResourceFileMap[line.substr(0, separator)] = line.substr(separator + 1);
+					string name = line.substr(0, separator);
+					m_ResourceFileMap[name] = line.substr(separator + 1, methodSeparator == string::npos ? string::npos : methodSeparator - separator - 1);
+					m_ResourceMethodMap[name] = method;
 				}
 			}
 		}
@@ -172,26 +264,190 @@ void ResourceCompiler::loadBinaryData()
 		binaryFile.exceptions(ios::failbit | ios::badbit);
 		
 		try {
-			// store binary resource file using stream iterators
-//			copy(	istream_iterator<unsigned char>(binaryFile),
-//					istream_iterator<unsigned char>(),
-//					back_inserter(m_ResourceDataMap[pos->first])
-//			);
+			// determine file size
+			binaryFile.seekg(0, ios::end);
+			streamoff size = binaryFile.tellg();
+			binaryFile.seekg(0, ios::beg);
 			
-			// "copy" ends prematurely, so use the crude way instead
-			char c = 0;
-			while(binaryFile.get(c)) {
-				m_ResourceDataMap[pos->first].push_back(c);
+			// store binary resource file in one go
+			vector<unsigned char>& data = m_ResourceDataMap[pos->first];
+			data.resize(static_cast<size_t>(size));
+			if(size > 0) {
+				binaryFile.read(reinterpret_cast<char*>(&data[0]), size);
 			}
 		}
 		catch(const ios::failure& error) {
-			// check stream state for real error
-			if(!binaryFile.eof()) {
-				cerr << "Error during binary file processing: " << error.what();
-			}	
+			cerr << "Error during binary file processing: " << error.what() << endl;
+			exit(1);
 		}
 
 		// close current file
 		binaryFile.close();
 	}
 }
+
+void ResourceCompiler::compressBinaryData()
+{
+	map<string, vector<unsigned char> >::iterator pos;
+	
+	// iterate over all resources we have
+	for(pos = m_ResourceDataMap.begin(); pos != m_ResourceDataMap.end(); ++pos) {
+		
+		const string& method = m_ResourceMethodMap[pos->first];
+		m_ResourceSizeMap[pos->first] = pos->second.size();
+		m_ResourceCompressionMap[pos->first] = Uncompressed;
+		
+		if(method == "lz4" || method == "lz4hc") {
+			vector<unsigned char> compressed;
+			LZ4Encoder::compress(pos->second, compressed,
+								 method == "lz4hc" ? LZ4Encoder::HIGH_SEARCH_DEPTH : LZ4Encoder::FAST_SEARCH_DEPTH);
+			
+			// only keep compressed data if it's actually smaller
+			if(compressed.size() < pos->second.size()) {
+				pos->second.swap(compressed);
+				m_ResourceCompressionMap[pos->first] = LZ4;
+			}
+		}
+	}
+}
+
+void ResourceCompiler::writeBinaryData()
+{
+	// open the output blob file
+	ofstream blobFile(m_ResourceBlobFile.c_str(), ios::out | ios::binary);
+	if(!blobFile) {
+		cerr << "Couldn't open output file \"" <<  m_ResourceBlobFile << "\"!" << endl,
+		exit(1);
+	}
+	
+	// let's get some exceptions
+	blobFile.exceptions(ios::failbit | ios::badbit);
+	
+	try {
+		map<string, vector<unsigned char> >::iterator pos;
+		
+		// store resources in index order
+		for(pos = m_ResourceDataMap.begin(); pos != m_ResourceDataMap.end(); ++pos) {
+			if(!pos->second.empty()) {
+				blobFile.write(reinterpret_cast<const char*>(&pos->second[0]), pos->second.size());
+			}
+		}
+		
+		blobFile.flush();
+	}
+	catch(const ios::failure& error) {
+		cerr << "Error during blob file processing: " << error.what() << endl;
+		exit(1);
+	}
+	
+	// close blob file
+	blobFile.close();
+}
+
+void ResourceCompiler::writePackFile()
+{
+	map<string, vector<unsigned char> >::iterator pos;
+	
+	// set up hash table (same as for the compiled-in resources)
+	vector<unsigned int> hashSlots;
+	unsigned int hashSeed = 0;
+	buildHashTable(hashSlots, hashSeed);
+	
+	// determine layout: header, index, hash table, identifiers, payloads
+	ResourcePack::Header header;
+	memcpy(header.magic, ResourcePack::magic(), sizeof(header.magic));
+	header.version = ResourcePack::VERSION;
+	header.count = m_ResourceDataMap.size();
+	header.hashSeed = hashSeed;
+	header.hashMask = hashSlots.size() - 1;
+	header.indexOffset = sizeof(ResourcePack::Header);
+	header.hashTableOffset = header.indexOffset + header.count * sizeof(ResourcePack::Entry);
+	header.namesOffset = header.hashTableOffset + hashSlots.size() * sizeof(uint32_t);
+	
+	vector<ResourcePack::Entry> entries;
+	uint64_t offset = header.namesOffset;
+	
+	for(pos = m_ResourceDataMap.begin(); pos != m_ResourceDataMap.end(); ++pos) {
+		ResourcePack::Entry entry;
+		entry.nameOffset = offset;
+		entry.nameLength = pos->first.length();
+		entry.storedSize = pos->second.size();
+		entry.size = m_ResourceSizeMap[pos->first];
+		entry.compression = m_ResourceCompressionMap[pos->first];
+		entries.push_back(entry);
+		offset += pos->first.length() + 1;
+	}
+	
+	for(size_t i = 0; i < entries.size(); ++i) {
+		offset = (offset + ResourcePack::ALIGNMENT - 1) / ResourcePack::ALIGNMENT * ResourcePack::ALIGNMENT;
+		entries[i].offset = offset;
+		offset += entries[i].storedSize;
+	}
+	
+	// all offsets are 32 bit values
+	if(offset > 0xffffffffu) {
+		cerr << "Resources exceed the maximum size of a resource pack!" << endl;
+		exit(1);
+	}
+	header.fileSize = offset;
+	
+	// assemble pack contents
+	vector<char> contents(header.fileSize, 0);
+	memcpy(&contents[0], &header, sizeof(header));
+	if(!entries.empty()) {
+		memcpy(&contents[header.indexOffset], &entries[0], entries.size() * sizeof(ResourcePack::Entry));
+	}
+	for(size_t i = 0; i < hashSlots.size(); ++i) {
+		const uint32_t slot = hashSlots[i];
+		memcpy(&contents[header.hashTableOffset + i * sizeof(uint32_t)], &slot, sizeof(slot));
+	}
+	size_t i = 0;
+	for(pos = m_ResourceDataMap.begin(); pos != m_ResourceDataMap.end(); ++pos, ++i) {
+		memcpy(&contents[entries[i].nameOffset], pos->first.c_str(), pos->first.length() + 1);
+		if(!pos->second.empty()) {
+			memcpy(&contents[entries[i].offset], &pos->second[0], pos->second.size());
+		}
+	}
+	
+	// open the output pack file
+	ofstream packFile(m_ResourcePackFile.c_str(), ios::out | ios::binary);
+	if(!packFile) {
+		cerr << "Couldn't open output file \"" <<  m_ResourcePackFile << "\"!" << endl,
+		exit(1);
+	}
+	
+	// let's get some exceptions
+	packFile.exceptions(ios::failbit | ios::badbit);
+	
+	try {
+		packFile.write(&contents[0], contents.size());
+		packFile.flush();
+	}
+	catch(const ios::failure& error) {
+		cerr << "Error during pack file processing: " << error.what() << endl;
+		exit(1);
+	}
+	
+	// close pack file
+	packFile.close();
+}
+
+string ResourceCompiler::escapeAssemblerString(const string& text)
+{
+	string result;
+	
+	// escape backslashes and quotes (twice: assembler string inside C string literal)
+	for(size_t i = 0; i < text.length(); ++i) {
+		if(text[i] == '\\') {
+			result += "\\\\\\\\";
+		}
+		else if(text[i] == '"') {
+			result += "\\\\\\\"";
+		}
+		else {
+			result += text[i];
+		}
+	}
+	
+	return result;
+}
@@ -22,13 +22,18 @@
 #define RESOURCECOMPILER_H_
 
 #include <cstdlib>
+#include <cstring>
 #include <string>
+#include <algorithm>
 #include <map>
 #include <vector>
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <iterator>
+#include <stdint.h>
+
+#include "ResourcePack.h"
 
 using namespace std;
 
@@ -41,26 +46,47 @@ using namespace std;
  * \brief Helper class that converts binary resources into source code ready for compilation
  * 
  * This "compiler" takes a resource specification file, opens and loads the physical
- * files and converts their contents into normal C/C++ source code. The source code
- * comprises three arrays which can be subsequently compiled into object code which is
- * then referenced by ResourceFactory using external linkage.\n
+ * files and converts them into normal C/C++ source code plus a binary blob file. The source
+ * code comprises three small arrays (identifiers, index and a perfect hash table) and the
+ * resource storage which is assembled directly from the blob file using the assembler's
+ * \c .incbin directive. Thus the compiler never has to parse the resource data itself,
+ * even for large resources. All arrays can be subsequently compiled into object code
+ * which is then referenced by ResourceFactory using external linkage. They are plain
+ * constant data (no constructors run), so they can be used at any time, even during
+ * static initialization.\n
+ * \n
+ * The blob file is named after the source code file, using the extension \c .bin instead
+ * (e.g. \c resources.cpp and \c resources.bin). Its name is embedded as a relative path,
+ * so the source code file has to be compiled in the directory it was generated in.\n
  * \n
  * %Resource specification file format:
  * - Simple text file (*.orc)
  * - Each line describes one resource
- * - The descriptor has to look like this: <code>LogicalResourceName|PhysicalResourceName</code>
+ * - The descriptor has to look like this: <code>LogicalResourceName|PhysicalResourceName[|Compression]</code>
  * - <code>PhysicalResourceName</code> is the actual file name of the resource
+ * - <code>Compression</code> is optional and selects how the resource is stored:
+ *   - \c none: uncompressed (default)
+ *   - \c lz4: LZ4 compressed, fast compression
+ *   - \c lz4hc: LZ4 compressed, better ratio at the same decompression speed
  * - Lines starting with # are treated as comments
  * - Empty lines are ignored
  * 
  * As you can see the logical and the physical (file) resource name are delimited by the pipe (|) character.
  * The logical resource name will be used again later. It is the identifier used to request a resource via
- * ResourceFactory::createInstance() 
+ * ResourceFactory::createInstance() \n
+ * \n
+ * Optionally the same resources can be written into a versioned resource pack file (see
+ * ResourcePack) which ResourceFactory can memory map at runtime instead of using the
+ * compiled-in resources. Assets can thus be updated without rebuilding the application.\n
+ * \n
+ * Compressed resources are decompressed by ResourceFactory on first access. Resources
+ * which don't get any smaller are stored uncompressed regardless of the selected compression.
  * 
  * \see ResourceFactory
  * \see ResourceFactory::c_ResourceIdentifiers
  * \see ResourceFactory::c_ResourceIndex
  * \see ResourceFactory::c_ResourceStorage
+ * \see ResourceFactory::c_ResourceHashTable
  * 
  * \author Oliver Bock\n
  * Max-Planck-Institute for Gravitational Physics\n
@@ -74,8 +100,9 @@ public:
 	 * 
 	 * \param inputFilename Name of the resource specification file (source, \c *.orc)
 	 * \param outputFilename Name of the converted recources file (destination, \c *.cpp)
+	 * \param packFilename Name of the optional resource pack file (destination, empty: none)
 	 */
-	ResourceCompiler(const string inputFilename, const string outputFilename);
+	ResourceCompiler(const string inputFilename, const string outputFilename, const string packFilename = "");
 	
 	/// Destructor
 	virtual ~ResourceCompiler();
@@ -84,8 +111,9 @@ public:
 	 * \brief Converts the specified resources into the specified source code file
 	 * 
 	 * It iterates over all resources found in the local cache and stores their data
-	 * and meta information as source code in the destination file. Thus parseInputFile()
-	 * and loadBinaryData() have to be called first for this to work.
+	 * in the blob file and their meta information as source code in the destination file.
+	 * Thus parseInputFile() and loadBinaryData() have to be called first for this to work.
+	 * If a resource pack file has been specified, the same resources are written into it as well.
 	 * 
 	 * \see parseInputFile
 	 * \see loadBinaryData
@@ -93,6 +121,12 @@ public:
 	void compile();
 	
 private:
+	/// Compression methods (as stored in the resource index, see ResourceFactory::Compression)
+	enum Compression {
+		Uncompressed = 0,
+		LZ4 = 1
+	};
+	
 	/**
 	 * \brief Parses the specified input file
 	 * 
@@ -107,21 +141,86 @@ private:
 	 * \brief Loads binary resource file data into the local cache
 	 * 
 	 * This methods tries to open all resource files found by loadBinaryData()
-	 * and copies their binary data into the local cache.
+	 * and copies their binary data into the local cache (one bulk read per file).
 	 * 
 	 * \see parseInputFile
 	 */
 	void loadBinaryData();
 	
+	/**
+	 * \brief Compresses the cached resources as specified
+	 * 
+	 * The cached data is replaced by the compressed data (if that's smaller).
+	 * The original sizes and the compression methods used are recorded for the index.
+	 * 
+	 * \see m_ResourceSizeMap
+	 * \see m_ResourceCompressionMap
+	 */
+	void compressBinaryData();
+	
+	/**
+	 * \brief Sets up the perfect hash table for the resource identifiers
+	 * 
+	 * The table size (power of two) and the hash seed are chosen such that no
+	 * two identifiers collide.
+	 * 
+	 * \param slots The hash table (output, index rows of the resources, 0: empty slot)
+	 * \param seed The hash seed (output)
+	 * 
+	 * \see ResourcePack::hashIdentifier
+	 */
+	void buildHashTable(vector<unsigned int>& slots, unsigned int& seed) const;
+	
+	/**
+	 * \brief Writes the data of all cached resources into the blob file
+	 * 
+	 * The resources are stored in the same (sorted) order as their index entries.
+	 * 
+	 * \see m_ResourceBlobFile
+	 */
+	void writeBinaryData();
+	
+	/**
+	 * \brief Writes all cached resources into the resource pack file
+	 * 
+	 * \see ResourcePack
+	 * \see m_ResourcePackFile
+	 */
+	void writePackFile();
+	
+	/**
+	 * \brief Escapes the given string for use as an assembler string literal
+	 * 
+	 * \param text The string to be escaped
+	 * 
+	 * \return The escaped string (without enclosing quotes)
+	 */
+	static string escapeAssemblerString(const string& text);
+	
 	/// Path and filename of the resource specification file (source)
 	string m_ResourceSpecFile;
 	
 	/// Path and filename of the converted source code file (destination)
 	string m_ResourceCodeFile;
 	
+	/// Path and filename of the resource data blob file (destination, referenced by the source code)
+	string m_ResourceBlobFile;
+	
+	/// Path and filename of the resource pack file (optional destination, empty: none)
+	string m_ResourcePackFile;
+	
 	/// Mapping between logical and physical resource names
 	map<string, string> m_ResourceFileMap;
 	
+	/// Mapping between logical resource names and their specified compression (\c none, \c lz4, \c lz4hc)
+	map<string, string> m_ResourceMethodMap;
+	
+	/// Mapping between logical resource names and their compression method (as stored)
+	map<string, Compression> m_ResourceCompressionMap;
+	
+	/// Mapping between logical resource names and their original (uncompressed) size
+	map<string, size_t> m_ResourceSizeMap;
+	
 	/// %Resource cache (identified by logical resource name)
 	map<string, vector<unsigned char> > m_ResourceDataMap;
 };
@@ -26,28 +26,30 @@
 
 void printUsage() {
 	cerr << "Invalid command-line options!" << endl;
-	cerr << "Usage: orc <input filename> <output filename>" << endl;
+	cerr << "Usage: orc <input filename> <output filename> [<pack filename>]" << endl;
 }
 
 int main(int argc, char *argv[])
 {
-	if(argc != 3) {
+	if(argc != 3 && argc != 4) {
 		printUsage();
 		exit(1);
 	}
 	else {
 		string inputFilename(argv[1]);
 		string outputFilename(argv[2]);
+		string packFilename(argc == 4 ? argv[3] : "");
 		
 		// TODO: better filename checking
 		if( inputFilename == "." || inputFilename == ".." ||
-			outputFilename == "." || outputFilename == "..")
+			outputFilename == "." || outputFilename == ".." ||
+			packFilename == "." || packFilename == "..")
 		{
 			printUsage();
 			exit(1);
 		}
 		
-		ResourceCompiler rc(inputFilename, outputFilename);
+		ResourceCompiler rc(inputFilename, outputFilename, packFilename);
 		rc.compile();
 		
 		exit(0);
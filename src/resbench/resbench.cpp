@@ -0,0 +1,199 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#include "ResourceFactory.h"
+
+using namespace std;
+
+/**
+ * \brief Compiled resource test and benchmark
+ *
+ * This tool is linked against the resources compiled by ORC from the given specification.
+ * It makes sure every compiled-in resource (and, if given, every resource of the external
+ * pack) yields exactly the contents of its source file and that unknown identifiers aren't
+ * found. Afterwards it measures the time needed to create all resources using a new factory
+ * (first access, including decompression) and using the same one again (cached access).
+ */
+
+void printUsage() {
+	cerr << "Invalid command-line options!" << endl;
+	cerr << "Usage: resbench <resource specification> [<resource pack> [<benchmark iterations>]]" << endl;
+}
+
+bool loadSpecification(const char *filename, map<string, string>& files) {
+	ifstream specFile(filename);
+	if(!specFile) {
+		cerr << "Couldn't open resource specification \"" << filename << "\"!" << endl;
+		return false;
+	}
+
+	// same format as read by ORC: identifier|file[|compression], comments start with #
+	string line;
+	while(getline(specFile, line)) {
+		line.erase(line.find_last_not_of(" \t\r\n\f") + 1);
+		const size_t firstCharacter = line.find_first_not_of(" \t\r\n\f");
+		if(firstCharacter == string::npos || line[firstCharacter] == '#') continue;
+
+		const size_t separator = line.find('|');
+		const size_t methodSeparator = line.find('|', separator + 1);
+		if(separator == string::npos) continue;
+
+		files[line.substr(0, separator)] = line.substr(separator + 1,
+			methodSeparator == string::npos ? string::npos : methodSeparator - separator - 1);
+	}
+
+	return true;
+}
+
+int checkResources(ResourceFactory& factory, const map<string, string>& files) {
+	int failures = 0;
+
+	map<string, string>::const_iterator file;
+	for(file = files.begin(); file != files.end(); ++file) {
+		ifstream sourceFile(file->second.c_str(), ios::binary);
+		const vector<unsigned char> source((istreambuf_iterator<char>(sourceFile)), istreambuf_iterator<char>());
+
+		const Resource *resource = factory.createInstance(file->first);
+		const Resource *cached = factory.createInstance(file->first);
+
+		if(!sourceFile.is_open() || !resource || !cached ||
+		   resource->size() != source.size() || cached->data() != resource->data() ||
+		   (!source.empty() && memcmp(resource->data(), &source[0], source.size()) != 0))
+		{
+			printf("Resource %s (%s) doesn't match its source file!\n", file->first.c_str(), file->second.c_str());
+			++failures;
+		}
+
+		delete resource;
+		delete cached;
+	}
+
+	// unknown identifiers (including prefixes and extensions of known ones) have to miss
+	vector<string> unknown(1, "");
+	unknown.push_back("NoSuchResource");
+	for(file = files.begin(); file != files.end(); ++file) {
+		unknown.push_back(file->first + "x");
+		unknown.push_back(file->first.substr(0, file->first.length() - 1));
+	}
+
+	for(size_t i = 0; i < unknown.size(); ++i) {
+		if(files.count(unknown[i])) continue;
+
+		const Resource *resource = factory.createInstance(unknown[i]);
+		if(resource) {
+			printf("Unknown resource \"%s\" has been found!\n", unknown[i].c_str());
+			++failures;
+			delete resource;
+		}
+	}
+
+	return failures;
+}
+
+void createResources(ResourceFactory& factory, const map<string, string>& files) {
+	map<string, string>::const_iterator file;
+	for(file = files.begin(); file != files.end(); ++file) {
+		delete factory.createInstance(file->first);
+	}
+}
+
+double benchmark(const map<string, string>& files, const int iterations, const bool cached) {
+	// the shared factory has already decompressed everything when timing starts
+	ResourceFactory factory;
+	createResources(factory, files);
+
+	const clock_t start = clock();
+	for(int i = 0; i < iterations; ++i) {
+		if(cached) {
+			createResources(factory, files);
+		}
+		else {
+			ResourceFactory fresh;
+			createResources(fresh, files);
+		}
+	}
+
+	return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char *argv[])
+{
+	if(argc < 2 || argc > 4) {
+		printUsage();
+		exit(1);
+	}
+
+	const int iterations = argc > 3 ? atoi(argv[3]) : 200;
+	if(iterations <= 0) {
+		printUsage();
+		exit(1);
+	}
+
+	map<string, string> files;
+	if(!loadSpecification(argv[1], files)) exit(1);
+
+	// the compiled-in resources have to match the specification
+	int failures = 0;
+	const unsigned int count = c_ResourceIndex[0][0];
+	if(count != files.size()) {
+		printf("Compiled resources: %u, specified resources: %lu\n", count, (unsigned long) files.size());
+		++failures;
+	}
+
+	for(unsigned int i = 0; i < count; ++i) {
+		if(!files.count(c_ResourceIdentifiers[i])) {
+			printf("Resource %s hasn't been specified!\n", c_ResourceIdentifiers[i]);
+			++failures;
+		}
+	}
+
+	ResourceFactory factory;
+	failures += checkResources(factory, files);
+	printf("Test: %lu compiled resources, %d failures\n", (unsigned long) files.size(), failures);
+
+	// the external resource pack (optional) has to match as well
+	if(argc > 2) {
+		ResourceFactory packFactory;
+		const int packFailures = packFactory.openPackFile(argv[2]) ? checkResources(packFactory, files) : 1;
+		printf("Test: resource pack %s, %d failures\n", argv[2], packFailures);
+		failures += packFailures;
+	}
+
+	// benchmark resource creation
+	const double firstTime = benchmark(files, iterations, false);
+	const double cachedTime = benchmark(files, iterations, true);
+
+	printf("Benchmark: %lu resources, %d iterations\n", (unsigned long) files.size(), iterations);
+	printf("first:  %10.3f us per resource set\n", firstTime * 1e6 / iterations);
+	printf("cached: %10.3f us per resource set\n", cachedTime * 1e6 / iterations);
+
+	exit(failures == 0 ? 0 : 1);
+}
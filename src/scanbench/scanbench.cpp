@@ -0,0 +1,208 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <cstdlib>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <sstream>
+
+#include <libxml/xmlreader.h>
+
+#include "XMLFieldScanner.h"
+
+using namespace std;
+
+/**
+ * \brief Shared memory parser benchmark
+ *
+ * This tool compares the XMLFieldScanner with the libxml2 based (xmlTextReader) parsing
+ * previously used by the adapters. Both parse the same \c pulsar_info fragment (Einstein\@Home
+ * Radio Pulsar shared memory data) into the same fields.
+ */
+
+class PulsarInformation
+{
+public:
+	PulsarInformation() : spectrum(40, 0) {}
+
+	bool parseSpectrum(const char *text, size_t length)
+	{
+		if(length % 2 != 0) return false;
+
+		spectrum.resize(length / 2);
+		for(size_t i = 0; i < length / 2; ++i) {
+			spectrum[i] = (unsigned char) ((hexValue(text[2*i]) << 4) | hexValue(text[2*i + 1]));
+		}
+
+		return true;
+	}
+
+	static int hexValue(const char digit)
+	{
+		if(digit >= '0' && digit <= '9') return digit - '0';
+		if(digit >= 'a' && digit <= 'f') return digit - 'a' + 10;
+		if(digit >= 'A' && digit <= 'F') return digit - 'A' + 10;
+		return 0;
+	}
+
+	static const XMLFieldScanner<PulsarInformation>::Field FIELDS[];
+
+	double rightAscension;
+	double declination;
+	double dispersion;
+	double orbitalRadius;
+	double orbitalPeriod;
+	double orbitalPhase;
+	double fractionDone;
+	double cpuTime;
+	vector<unsigned char> spectrum;
+};
+
+const XMLFieldScanner<PulsarInformation>::Field PulsarInformation::FIELDS[] = {
+	{"skypos_rac", &PulsarInformation::rightAscension, NULL},
+	{"skypos_dec", &PulsarInformation::declination, NULL},
+	{"dispersion", &PulsarInformation::dispersion, NULL},
+	{"orb_radius", &PulsarInformation::orbitalRadius, NULL},
+	{"orb_period", &PulsarInformation::orbitalPeriod, NULL},
+	{"orb_phase", &PulsarInformation::orbitalPhase, NULL},
+	{"power_spectrum", NULL, &PulsarInformation::parseSpectrum},
+	{"fraction_done", &PulsarInformation::fractionDone, NULL},
+	{"cpu_time", &PulsarInformation::cpuTime, NULL}
+};
+
+void printUsage() {
+	cerr << "Invalid command-line options!" << endl;
+	cerr << "Usage: scanbench [<iterations>] [<power spectrum bins>]" << endl;
+}
+
+string generateInput(const int bins) {
+	stringstream buffer;
+
+	buffer	<< "<pulsar_info>\n"
+			<< "  <skypos_rac>1.234567</skypos_rac>\n"
+			<< "  <skypos_dec>-0.456789</skypos_dec>\n"
+			<< "  <dispersion>123.456</dispersion>\n"
+			<< "  <orb_radius>0.987</orb_radius>\n"
+			<< "  <orb_period>5432.1</orb_period>\n"
+			<< "  <orb_phase>2.345</orb_phase>\n"
+			<< "  <power_spectrum>";
+
+	for(int i = 0; i < bins; ++i) {
+		const char digits[] = "0123456789abcdef";
+		buffer << digits[(i * 7) % 16] << digits[(i * 13) % 16];
+	}
+
+	buffer	<< "</power_spectrum>\n"
+			<< "  <fraction_done>0.5</fraction_done>\n"
+			<< "  <cpu_time>3600.0</cpu_time>\n"
+			<< "</pulsar_info>\n";
+
+	return buffer.str();
+}
+
+bool parseWithScanner(const XMLFieldScanner<PulsarInformation>& scanner, PulsarInformation& target, const string& input) {
+	return scanner.scan(target, input.c_str()) == 9;
+}
+
+bool parseWithLibxml2(xmlTextReaderPtr& reader, PulsarInformation& target, const string& input) {
+	if(!reader) {
+		reader = xmlReaderForMemory(input.c_str(), input.length(), "http://einstein.phys.uwm.edu", "UTF-8", 0);
+		if(!reader) return false;
+	}
+	else if(xmlReaderNewMemory(reader, input.c_str(), input.length(), "http://einstein.phys.uwm.edu", "UTF-8", 0)) {
+		return false;
+	}
+
+	int fields = 0;
+	while(xmlTextReaderRead(reader) == 1) {
+		if(xmlTextReaderNodeType(reader) != XML_READER_TYPE_ELEMENT) continue;
+
+		const xmlChar *name = xmlTextReaderConstLocalName(reader);
+		if(!name || xmlTextReaderRead(reader) != 1 || !xmlTextReaderHasValue(reader)) continue;
+
+		const char *value = (const char*) xmlTextReaderConstValue(reader);
+		if(!value) continue;
+
+		if(xmlStrEqual(name, BAD_CAST("skypos_rac"))) target.rightAscension = strtod(value, NULL);
+		else if(xmlStrEqual(name, BAD_CAST("skypos_dec"))) target.declination = strtod(value, NULL);
+		else if(xmlStrEqual(name, BAD_CAST("dispersion"))) target.dispersion = strtod(value, NULL);
+		else if(xmlStrEqual(name, BAD_CAST("orb_radius"))) target.orbitalRadius = strtod(value, NULL);
+		else if(xmlStrEqual(name, BAD_CAST("orb_period"))) target.orbitalPeriod = strtod(value, NULL);
+		else if(xmlStrEqual(name, BAD_CAST("orb_phase"))) target.orbitalPhase = strtod(value, NULL);
+		else if(xmlStrEqual(name, BAD_CAST("power_spectrum"))) target.parseSpectrum(value, strlen(value));
+		else if(xmlStrEqual(name, BAD_CAST("fraction_done"))) target.fractionDone = strtod(value, NULL);
+		else if(xmlStrEqual(name, BAD_CAST("cpu_time"))) target.cpuTime = strtod(value, NULL);
+		else continue;
+
+		++fields;
+	}
+
+	return fields == 9;
+}
+
+int main(int argc, char *argv[])
+{
+	if(argc > 3) {
+		printUsage();
+		exit(1);
+	}
+
+	const int iterations = argc > 1 ? atoi(argv[1]) : 100000;
+	const int bins = argc > 2 ? atoi(argv[2]) : 40;
+	if(iterations <= 0 || bins <= 0) {
+		printUsage();
+		exit(1);
+	}
+
+	const string input = generateInput(bins);
+	XMLFieldScanner<PulsarInformation> scanner(PulsarInformation::FIELDS, sizeof(PulsarInformation::FIELDS) / sizeof(PulsarInformation::FIELDS[0]));
+	xmlTextReaderPtr reader = NULL;
+	PulsarInformation scanned, parsed;
+
+	// warm up and make sure both agree
+	if(!parseWithScanner(scanner, scanned, input) || !parseWithLibxml2(reader, parsed, input) ||
+	   scanned.rightAscension != parsed.rightAscension || scanned.cpuTime != parsed.cpuTime ||
+	   scanned.spectrum != parsed.spectrum)
+	{
+		cerr << "Parsers disagree, aborting!" << endl;
+		exit(1);
+	}
+
+	clock_t start = clock();
+	for(int i = 0; i < iterations; ++i) parseWithScanner(scanner, scanned, input);
+	const double scannerTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+	start = clock();
+	for(int i = 0; i < iterations; ++i) parseWithLibxml2(reader, parsed, input);
+	const double libxml2Time = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+	xmlFreeTextReader(reader);
+	xmlCleanupParser();
+
+	printf("Input: %lu bytes (%d power spectrum bins), %d iterations\n", (unsigned long) input.length(), bins, iterations);
+	printf("XMLFieldScanner: %10.3f us per parse\n", scannerTime * 1e6 / iterations);
+	printf("libxml2 reader:  %10.3f us per parse\n", libxml2Time * 1e6 / iterations);
+	printf("Speedup:         %10.1fx\n", libxml2Time / scannerTime);
+
+	exit(0);
+}
@@ -0,0 +1,168 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+#include "boinc_api.h"
+#include "graphics2.h"
+#include "util.h"
+
+#include "SharedMemoryArea.h"
+
+using namespace std;
+
+/**
+ * \brief Local shared memory publisher
+ *
+ * This tool mimics a science application publishing its graphics information,
+ * hence graphics applications can be tested without BOINC (run both in the same directory).
+ * It publishes either the contents of the given file (reread for every update) or
+ * generated \b Einstein\@Home S5R3 style information. The versioned protocol
+ * (SharedMemoryArea) is used by default, \c --legacy writes plain strings instead.
+ * An interval of 0 ms continuously rewrites the contents (useful to provoke torn reads).
+ */
+
+void printUsage() {
+	cerr << "Invalid command-line options!" << endl;
+	cerr << "Usage: shmpub [--legacy] [--interval <ms>] [--size <bytes>] <identifier> [<input filename>]" << endl;
+}
+
+bool readInput(const string& filename, string& contents) {
+	ifstream input(filename.c_str(), ios::in | ios::binary);
+	if(!input) {
+		cerr << "Could not open input file: " << filename << endl;
+		return false;
+	}
+
+	stringstream buffer;
+	buffer << input.rdbuf();
+	contents = buffer.str();
+
+	return true;
+}
+
+void generateInput(const unsigned long update, string& contents) {
+	char buffer[256];
+
+	// slowly moving sky position and progress
+	snprintf(buffer, sizeof(buffer),
+			 "<graphics_info>\n"
+			 "  <skypos_rac>%f</skypos_rac>\n"
+			 "  <skypos_dec>%f</skypos_dec>\n"
+			 "  <fraction_done>%f</fraction_done>\n"
+			 "  <cpu_time>%f</cpu_time>\n"
+			 "  <update>%lu</update>\n"
+			 "</graphics_info>\n",
+			 (update % 628) / 100.0,
+			 ((update % 314) - 157) / 100.0,
+			 (update % 1000) / 1000.0,
+			 (double) update,
+			 update);
+
+	contents = buffer;
+}
+
+int main(int argc, char *argv[])
+{
+	bool legacy = false;
+	int interval = 1000;
+	int size = 4096;
+	string identifier;
+	string inputFilename;
+
+	for(int i = 1; i < argc; ++i) {
+		string option(argv[i]);
+
+		if(option == "--legacy") {
+			legacy = true;
+		}
+		else if(option == "--interval" && i + 1 < argc) {
+			interval = atoi(argv[++i]);
+		}
+		else if(option == "--size" && i + 1 < argc) {
+			size = atoi(argv[++i]);
+		}
+		else if(identifier.empty()) {
+			identifier = option;
+		}
+		else if(inputFilename.empty()) {
+			inputFilename = option;
+		}
+		else {
+			printUsage();
+			exit(1);
+		}
+	}
+
+	if(identifier.empty() || interval < 0 || size <= (int) sizeof(SharedMemoryArea::Header)) {
+		printUsage();
+		exit(1);
+	}
+
+	// use the same slot (and hence name) as the graphics application
+	boinc_parse_init_data_file();
+
+	char *area = (char*) boinc_graphics_make_shmem((char*) identifier.c_str(), size);
+	if(!area) {
+		cerr << "Could not create shared memory area: " << identifier << endl;
+		exit(1);
+	}
+
+	SharedMemoryArea::Header *header = NULL;
+	if(!legacy) {
+		// a new generation per run (the sequence restarts at 0)
+		header = SharedMemoryArea::initialize(area, size, getpid());
+	}
+
+	cout << "Publishing " << (legacy ? "legacy" : "versioned") << " contents to shared memory area "
+		 << identifier << " (" << size << " bytes)..." << endl;
+
+	string contents;
+	for(unsigned long update = 1; ; ++update) {
+		if(!inputFilename.empty()) {
+			if(!readInput(inputFilename, contents)) exit(1);
+		}
+		else {
+			generateInput(update, contents);
+		}
+
+		if(legacy) {
+			// no way to tell readers about an update in progress
+			strncpy(area, contents.c_str(), size - 1);
+			area[size - 1] = '\0';
+		}
+		else {
+			SharedMemoryArea::write(header, contents.c_str());
+		}
+
+		if(interval > 0) {
+			boinc_sleep(interval / 1000.0);
+		}
+	}
+
+	exit(0);
+}
@@ -0,0 +1,190 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <ctime>
+#include <vector>
+#include <iostream>
+
+#include "SkyProjection.h"
+
+using namespace std;
+
+// former per-vertex conversion of Starsphere (SIN and COS take arguments in DEGREES)
+#define PI 3.14159265
+#define PI2 (2*PI)
+#define COS(X)   cos( (X) * PI2/360.0 )
+#define SIN(X)   sin( (X) * PI2/360.0 )
+
+/**
+ * \brief Sky coordinate conversion (SkyProjection) test and benchmark
+ *
+ * This tool checks the accuracy of all SkyProjection kernels supported by the host against
+ * a double precision libm loop, both for the coordinate ranges used by %Starsphere and for
+ * angles requiring range reduction. Afterwards it measures their throughput compared to the
+ * former per-vertex conversion using the COS/SIN macros.
+ */
+
+/// Available kernels
+const SkyProjection::KernelType KERNELS[] = {SkyProjection::ScalarKernel, SkyProjection::SSE2Kernel, SkyProjection::AVX2Kernel};
+
+/// Number of available kernels
+const int KERNEL_COUNT = sizeof(KERNELS) / sizeof(KERNELS[0]);
+
+/// Maximum error accepted (relative to the radius)
+const double MAX_ERROR = 1e-6;
+
+/// Structure of arrays holding celestial and cartesian coordinates
+struct Coordinates {
+	Coordinates(const size_t count) :
+		ra(count), de(count), radius(count), x(count), y(count), z(count) {}
+
+	vector<float> ra, de, radius, x, y, z;
+};
+
+void printUsage() {
+	cerr << "Invalid command-line options!" << endl;
+	cerr << "Usage: skybench [<coordinates> [<iterations>]]" << endl;
+}
+
+double randomValue(const double minimum, const double maximum) {
+	return minimum + (maximum - minimum) * rand() / RAND_MAX;
+}
+
+void fillCoordinates(Coordinates &coordinates, const double range) {
+	for(size_t i = 0; i < coordinates.ra.size(); ++i) {
+		coordinates.ra[i] = randomValue(-range, range + 360.0);
+		coordinates.de[i] = randomValue(-90.0 - range, 90.0 + range);
+		coordinates.radius[i] = randomValue(0.1, 100.0);
+	}
+}
+
+void convertLibm(Coordinates &coordinates) {
+	for(size_t i = 0; i < coordinates.ra.size(); ++i) {
+		const double ra = coordinates.ra[i] * (M_PI / 180.0);
+		const double de = coordinates.de[i] * (M_PI / 180.0);
+
+		coordinates.x[i] = coordinates.radius[i] * cos(de) * cos(ra);
+		coordinates.y[i] = coordinates.radius[i] * sin(de);
+		coordinates.z[i] = -coordinates.radius[i] * cos(de) * sin(ra);
+	}
+}
+
+void convertMacros(Coordinates &coordinates) {
+	for(size_t i = 0; i < coordinates.ra.size(); ++i) {
+		const float RAdeg = coordinates.ra[i], DEdeg = coordinates.de[i], radius = coordinates.radius[i];
+
+		coordinates.x[i] = radius * COS(DEdeg) * COS(RAdeg);
+		coordinates.y[i] = radius * SIN(DEdeg);
+		coordinates.z[i] = -radius * COS(DEdeg) * SIN(RAdeg);
+	}
+}
+
+void convertKernel(SkyProjection::Kernel kernel, Coordinates &coordinates) {
+	kernel(&coordinates.ra[0], &coordinates.de[0], &coordinates.radius[0],
+		   &coordinates.x[0], &coordinates.y[0], &coordinates.z[0], coordinates.ra.size());
+}
+
+double maximumError(const Coordinates &result, const Coordinates &reference) {
+	double maximum = 0.0;
+
+	for(size_t i = 0; i < result.ra.size(); ++i) {
+		const double error = max(fabs(result.x[i] - reference.x[i]),
+								 max(fabs(result.y[i] - reference.y[i]), fabs(result.z[i] - reference.z[i])));
+		maximum = max(maximum, error / reference.radius[i]);
+	}
+
+	return maximum;
+}
+
+int main(int argc, char *argv[])
+{
+	if(argc > 3) {
+		printUsage();
+		exit(1);
+	}
+
+	const int count = argc > 1 ? atoi(argv[1]) : 100000;
+	const int iterations = argc > 2 ? atoi(argv[2]) : 100;
+	if(count <= 0 || iterations <= 0) {
+		printUsage();
+		exit(1);
+	}
+
+	// accuracy: sky ranges and (reduced) angles beyond them
+	const double ranges[] = {0.0, 1080.0};
+	bool failed = false;
+
+	srand(1);
+	printf("Selected kernel: %s\n", SkyProjection::kernelName());
+	for(int r = 0; r < 2; ++r) {
+		Coordinates reference(count), result(count);
+		fillCoordinates(reference, ranges[r]);
+		result = reference;
+		convertLibm(reference);
+
+		printf("Accuracy (%s, %d coordinates, error relative to radius):\n",
+			   r == 0 ? "sky range" : "range reduction", count);
+
+		for(int k = 0; k < KERNEL_COUNT; ++k) {
+			SkyProjection::Kernel kernel = SkyProjection::kernel(KERNELS[k]);
+			if(!kernel) continue;
+
+			convertKernel(kernel, result);
+			const double error = maximumError(result, reference);
+			failed |= error > MAX_ERROR;
+
+			printf("%-6s %10.3g%s\n", SkyProjection::kernelName(KERNELS[k]), error,
+				   error > MAX_ERROR ? " (too large!)" : "");
+		}
+
+		convertMacros(result);
+		printf("%-6s %10.3g\n", "macros", maximumError(result, reference));
+	}
+
+	// throughput: former per-vertex macros vs. all supported kernels
+	Coordinates coordinates(count);
+	fillCoordinates(coordinates, 0.0);
+	printf("Benchmark: %d coordinates, %d iterations\n", count, iterations);
+
+	clock_t start = clock();
+	for(int i = 0; i < iterations; ++i) convertMacros(coordinates);
+	const double macroTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+	printf("%-6s %10.3f ns per vertex\n", "macros", macroTime * 1e9 / iterations / count);
+
+	for(int k = 0; k < KERNEL_COUNT; ++k) {
+		SkyProjection::Kernel kernel = SkyProjection::kernel(KERNELS[k]);
+		if(!kernel) {
+			printf("%-6s not supported\n", SkyProjection::kernelName(KERNELS[k]));
+			continue;
+		}
+
+		start = clock();
+		for(int i = 0; i < iterations; ++i) convertKernel(kernel, coordinates);
+		const double time = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+		printf("%-6s %10.3f ns per vertex (%.1fx)\n", SkyProjection::kernelName(KERNELS[k]),
+			   time * 1e9 / iterations / count, time > 0 ? macroTime / time : 0.0);
+	}
+
+	exit(failed ? 1 : 0);
+}
@@ -0,0 +1,142 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "CatalogCompiler.h"
+
+#include <vector>
+
+/// Constellation & star coordinates (starlist.C)
+extern float star_info[][2];
+
+/// Total number of stars
+extern int Nstars;
+
+/// Pulsar coordinates are (pulsar_list.C)
+extern float pulsar_info[][2];
+
+/// Total number of pulsars
+extern int Npulsars;
+
+/// SNR coordinates (snr_list.C)
+extern float SNR_info[][2];
+
+/// Total number of SNRs
+extern int NSNRs;
+
+// degrees to radians
+#define DEG2RAD 0.017453292519943295
+
+// quantization of catalog coordinates (degrees) used for identity
+#define CATALOG_QUANTUM 1.0e-5
+
+CatalogCompiler::CatalogCompiler(const string outputFilename)
+{
+	m_CatalogCodeFile = outputFilename;
+}
+
+CatalogCompiler::~CatalogCompiler()
+{
+}
+
+void CatalogCompiler::compile()
+{
+	ostringstream catalogInitializer;
+
+	// stars: unique positions only (same stars appear more than once in constellations)
+	vector<int> index(Nstars);
+	int count = uniqueEntries(star_info, Nstars, &index[0]);
+	convertCatalog("c_StarVertices", "c_StarVertexCount", star_info, &index[0], count, catalogInitializer);
+
+	// constellations: all pairs of star positions (lines)
+	for(int i = 0; i < Nstars; ++i) index[i] = i;
+	convertCatalog("c_ConstellationVertices", "c_ConstellationVertexCount", star_info, &index[0], Nstars, catalogInitializer);
+
+	// pulsars and SNRs: unique positions only
+	index.resize(Npulsars);
+	count = uniqueEntries(pulsar_info, Npulsars, &index[0]);
+	convertCatalog("c_PulsarVertices", "c_PulsarVertexCount", pulsar_info, &index[0], count, catalogInitializer);
+
+	index.resize(NSNRs);
+	count = uniqueEntries(SNR_info, NSNRs, &index[0]);
+	convertCatalog("c_SNRVertices", "c_SNRVertexCount", SNR_info, &index[0], count, catalogInitializer);
+
+	// open the output code file
+	ofstream outputFile(m_CatalogCodeFile.c_str(), ios::out);
+	if(!outputFile) {
+		cerr << "Couldn't open output file \"" <<  m_CatalogCodeFile << "\"!" << endl;
+		exit(1);
+	}
+
+	// let's get some exceptions
+	outputFile.exceptions(ios::failbit | ios::badbit);
+
+	try {
+		// write header
+		outputFile << "// Starsphere catalogs (cartesian coordinates on the unit sphere)" << endl;
+		outputFile << "// generated by starcat from starlist.C, pulsar_list.C and snr_list.C" << endl << endl;
+
+		// write code file contents
+		outputFile << catalogInitializer.str();
+	}
+	catch(const ios::failure& error) {
+		cerr << "Error during output file processing: " << error.what() << endl;
+		exit(1);
+	}
+
+	// clean up and close file
+	outputFile.flush();
+	outputFile.close();
+}
+
+void CatalogCompiler::convertCatalog(const string identifier, const string countIdentifier,
+									 const float coordinates[][2], const int *index, const int count,
+									 ostream &output)
+{
+	output << "extern const float " << identifier << "[][3] = {" << endl;
+
+	// note: a zero length array isn't valid C++, so there's always a trailing dummy vertex
+	output << setprecision(9) << fixed;
+	for(int i = 0; i < count; ++i) {
+		const double ra = coordinates[index[i]][0] * DEG2RAD;
+		const double de = coordinates[index[i]][1] * DEG2RAD;
+
+		output << "{" << cos(de) * cos(ra) << "f," << sin(de) << "f," << -cos(de) * sin(ra) << "f}," << endl;
+	}
+	output << "{0.0f,0.0f,0.0f}" << endl << "};" << endl;
+
+	output << "extern const int " << countIdentifier << " = " << dec << count << ";" << endl << endl;
+}
+
+int CatalogCompiler::uniqueEntries(const float coordinates[][2], const int count, int *index)
+{
+	set<pair<long, long> > known;
+	int unique = 0;
+
+	for(int i = 0; i < count; ++i) {
+		pair<long, long> key((long) floor(coordinates[i][0] / CATALOG_QUANTUM + 0.5),
+							 (long) floor(coordinates[i][1] / CATALOG_QUANTUM + 0.5));
+
+		if(known.insert(key).second) {
+			index[unique++] = i;
+		}
+	}
+
+	return unique;
+}
@@ -0,0 +1,114 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef CATALOGCOMPILER_H_
+#define CATALOGCOMPILER_H_
+
+#include <cstdlib>
+#include <cmath>
+#include <string>
+#include <set>
+#include <utility>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+using namespace std;
+
+/**
+ * \addtogroup starcat Starsphere Catalog Compiler
+ * @{
+ */
+
+/**
+ * \brief Helper class that converts the built-in %Starsphere catalogs into ready-to-upload vertex data
+ *
+ * The star (constellation), pulsar and supernova remnant catalogs (starlist.C, pulsar_list.C
+ * and snr_list.C) list their objects as right ascension/declination pairs (in degrees). This
+ * "compiler" is linked against these catalogs, converts them into cartesian coordinates on the
+ * unit sphere and writes the results as C/C++ source code. The generated arrays are subsequently
+ * compiled into the %Starsphere binary which thus doesn't have to do any catalog trigonometry
+ * (or de-duplication) at runtime. The coordinates only need to be scaled by the sphere radius.
+ *
+ * The generated code comprises the following arrays (and their lengths):
+ * - \c c_StarVertices / \c c_StarVertexCount: unique star positions
+ * - \c c_ConstellationVertices / \c c_ConstellationVertexCount: pairs of star positions (lines)
+ * - \c c_PulsarVertices / \c c_PulsarVertexCount: unique pulsar positions
+ * - \c c_SNRVertices / \c c_SNRVertexCount: unique supernova remnant positions
+ *
+ * \author Oliver Bock\n
+ * Max-Planck-Institute for Gravitational Physics\n
+ * Hannover, Germany
+ */
+class CatalogCompiler
+{
+public:
+	/**
+	 * \brief Constructor
+	 *
+	 * \param outputFilename Name of the converted catalog file (destination, \c *.cpp)
+	 */
+	CatalogCompiler(const string outputFilename);
+
+	/// Destructor
+	virtual ~CatalogCompiler();
+
+	/// Converts the built-in catalogs into the specified source code file
+	void compile();
+
+private:
+	/**
+	 * \brief Converts a single catalog into a vertex array definition
+	 *
+	 * \param identifier The name of the vertex array to be generated
+	 * \param countIdentifier The name of the vertex count constant to be generated
+	 * \param coordinates The catalog coordinates (right ascension, declination)
+	 * \param index The indices of the catalog entries to be converted
+	 * \param count The number of indices
+	 * \param output The stream receiving the generated code
+	 */
+	void convertCatalog(const string identifier, const string countIdentifier,
+						const float coordinates[][2], const int *index, const int count,
+						ostream &output);
+
+	/**
+	 * \brief Determines the unique entries of a catalog
+	 *
+	 * Entries are considered identical if their coordinates match after quantization
+	 * (\c CATALOG_QUANTUM). The unique entries are listed in order of their first appearance.
+	 *
+	 * \param coordinates The catalog coordinates (right ascension, declination)
+	 * \param count The number of catalog entries
+	 * \param index The array receiving the indices of the unique entries (at least \c count elements)
+	 *
+	 * \return The number of unique entries
+	 */
+	int uniqueEntries(const float coordinates[][2], const int count, int *index);
+
+	/// Path and filename of the converted source code file (destination)
+	string m_CatalogCodeFile;
+};
+
+/**
+ * @}
+ */
+
+#endif /*CATALOGCOMPILER_H_*/
@@ -0,0 +1,51 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <cstdlib>
+#include <string>
+#include <iostream>
+
+#include "CatalogCompiler.h"
+
+void printUsage() {
+	cerr << "Invalid command-line options!" << endl;
+	cerr << "Usage: starcat <output filename>" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+	if(argc != 2) {
+		printUsage();
+		exit(1);
+	}
+	else {
+		string outputFilename(argv[1]);
+
+		if(outputFilename == "." || outputFilename == "..") {
+			printUsage();
+			exit(1);
+		}
+
+		CatalogCompiler cc(outputFilename);
+		cc.compile();
+
+		exit(0);
+	}
+}
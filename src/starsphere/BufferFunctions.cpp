@@ -0,0 +1,74 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "BufferFunctions.h"
+
+#include <string>
+#include <cstring>
+#include <cstdio>
+
+using namespace std;
+
+BufferFunctions::BufferFunctions()
+{
+	reset();
+}
+
+bool BufferFunctions::resolve()
+{
+	// prefer core entry points (OpenGL 1.5), but SDL might return stubs for
+	// unsupported functions, so check the version first
+	const char *version = (const char*) glGetString(GL_VERSION);
+	int major = 0, minor = 0;
+	if(version && sscanf(version, "%d.%d", &major, &minor) == 2 &&
+	   (major > 1 || (major == 1 && minor >= 5)) && resolve(""))
+	{
+		return true;
+	}
+
+	// fall back to extension (GL_ARB_vertex_buffer_object)
+	const char *extensions = (const char*) glGetString(GL_EXTENSIONS);
+	if(extensions && strstr(extensions, "GL_ARB_vertex_buffer_object") && resolve("ARB")) {
+		return true;
+	}
+
+	reset();
+	return false;
+}
+
+bool BufferFunctions::resolve(const char *suffix)
+{
+	genBuffers = (PFNGLGENBUFFERSPROC) SDL_GL_GetProcAddress((string("glGenBuffers") + suffix).c_str());
+	bindBuffer = (PFNGLBINDBUFFERPROC) SDL_GL_GetProcAddress((string("glBindBuffer") + suffix).c_str());
+	bufferData = (PFNGLBUFFERDATAPROC) SDL_GL_GetProcAddress((string("glBufferData") + suffix).c_str());
+	bufferSubData = (PFNGLBUFFERSUBDATAPROC) SDL_GL_GetProcAddress((string("glBufferSubData") + suffix).c_str());
+	deleteBuffers = (PFNGLDELETEBUFFERSPROC) SDL_GL_GetProcAddress((string("glDeleteBuffers") + suffix).c_str());
+
+	return genBuffers && bindBuffer && bufferData && bufferSubData && deleteBuffers;
+}
+
+void BufferFunctions::reset()
+{
+	genBuffers = 0;
+	bindBuffer = 0;
+	bufferData = 0;
+	bufferSubData = 0;
+	deleteBuffers = 0;
+}
@@ -0,0 +1,94 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef BUFFERFUNCTIONS_H_
+#define BUFFERFUNCTIONS_H_
+
+#include <SDL.h>
+#include <SDL_opengl.h>
+
+/**
+ * \addtogroup starsphere Starsphere
+ * @{
+ */
+
+/**
+ * \brief OpenGL buffer object entry points
+ *
+ * Vertex buffer objects are part of the core API since OpenGL 1.5 and available via
+ * the GL_ARB_vertex_buffer_object extension before. This class resolves the entry points
+ * of either for the current context (see resolve()), so all users of buffer objects
+ * (SkyGeometryStore, ResultsBuffer) share the same lookup and fallback.
+ *
+ * \author Oliver Bock\n
+ * Max-Planck-Institute for Gravitational Physics\n
+ * Hannover, Germany
+ */
+class BufferFunctions
+{
+public:
+	/// Constructor (no entry points resolved)
+	BufferFunctions();
+
+	/**
+	 * \brief Resolves the entry points for the current context
+	 *
+	 * The core entry points are preferred (if the context supports OpenGL 1.5), the ARB
+	 * ones are used as fallback (if GL_ARB_vertex_buffer_object is supported).
+	 * If either set is incomplete all entry points are reset.
+	 *
+	 * \return TRUE if vertex buffer objects are supported, otherwise FALSE
+	 */
+	bool resolve();
+
+	/// Entry point of glGenBuffers() (or its ARB equivalent)
+	PFNGLGENBUFFERSPROC genBuffers;
+
+	/// Entry point of glBindBuffer() (or its ARB equivalent)
+	PFNGLBINDBUFFERPROC bindBuffer;
+
+	/// Entry point of glBufferData() (or its ARB equivalent)
+	PFNGLBUFFERDATAPROC bufferData;
+
+	/// Entry point of glBufferSubData() (or its ARB equivalent)
+	PFNGLBUFFERSUBDATAPROC bufferSubData;
+
+	/// Entry point of glDeleteBuffers() (or its ARB equivalent)
+	PFNGLDELETEBUFFERSPROC deleteBuffers;
+
+private:
+	/**
+	 * \brief Resolves all entry points using the given name suffix
+	 *
+	 * \param suffix The suffix of the entry point names ("" for core, "ARB" for the extension)
+	 *
+	 * \return TRUE if all entry points could be resolved, otherwise FALSE
+	 */
+	bool resolve(const char *suffix);
+
+	/// Resets all entry points
+	void reset();
+};
+
+/**
+ * @}
+ */
+
+#endif /*BUFFERFUNCTIONS_H_*/
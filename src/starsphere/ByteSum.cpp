@@ -0,0 +1,147 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "ByteSum.h"
+
+#ifdef BYTESUM_X86
+#include <immintrin.h>
+#endif
+
+ByteSum::Kernel ByteSum::m_Kernel = 0;
+const char *ByteSum::m_KernelName = "scalar";
+
+uint32_t ByteSum::sum(const char *data, const size_t length)
+{
+	if(!m_Kernel) selectKernel();
+	return m_Kernel(data, length);
+}
+
+const char *ByteSum::kernelName()
+{
+	if(!m_Kernel) selectKernel();
+	return m_KernelName;
+}
+
+ByteSum::Kernel ByteSum::kernel(const KernelType type)
+{
+	switch(type) {
+		case ScalarKernel:
+			return sumScalar;
+#ifdef BYTESUM_X86
+		case SSE2Kernel:
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("sse2") ? sumSSE2 : 0;
+		case AVX2Kernel:
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("avx2") ? sumAVX2 : 0;
+#endif
+		default:
+			return 0;
+	}
+}
+
+const char *ByteSum::kernelName(const KernelType type)
+{
+	switch(type) {
+		case SSE2Kernel:
+			return "sse2";
+		case AVX2Kernel:
+			return "avx2";
+		default:
+			return "scalar";
+	}
+}
+
+void ByteSum::selectKernel()
+{
+	// prefer the widest kernel supported by the host CPU
+	const KernelType preferred[] = {AVX2Kernel, SSE2Kernel, ScalarKernel};
+
+	for(size_t i = 0; i < sizeof(preferred) / sizeof(preferred[0]); ++i) {
+		Kernel candidate = kernel(preferred[i]);
+		if(candidate) {
+			m_Kernel = candidate;
+			m_KernelName = kernelName(preferred[i]);
+			return;
+		}
+	}
+}
+
+uint32_t ByteSum::sumScalar(const char *data, const size_t length)
+{
+	uint32_t sum = 0;
+
+	for(size_t i = 0; i < length; ++i) {
+		sum += data[i];
+	}
+
+	return sum;
+}
+
+#ifdef BYTESUM_X86
+
+/*
+ * Note: the SIMD kernels treat bytes as signed, just like char on x86.
+ * Flipping the sign bit maps a signed byte b to the unsigned byte b + 128,
+ * hence the signed sum is the unsigned (SAD) sum minus 128 per byte.
+ */
+
+__attribute__((target("sse2")))
+uint32_t ByteSum::sumSSE2(const char *data, const size_t length)
+{
+	const __m128i signBit = _mm_set1_epi8((char)0x80);
+	const __m128i zero = _mm_setzero_si128();
+	__m128i sum = _mm_setzero_si128();
+
+	const size_t blocks = length / 16;
+	for(size_t i = 0; i < blocks; ++i) {
+		const __m128i bytes = _mm_loadu_si128((const __m128i*)(data + i * 16));
+		sum = _mm_add_epi64(sum, _mm_sad_epu8(_mm_xor_si128(bytes, signBit), zero));
+	}
+
+	// fold both 64 bit lanes (only the lower 32 bits matter)
+	sum = _mm_add_epi64(sum, _mm_unpackhi_epi64(sum, sum));
+	const uint32_t result = (uint32_t)_mm_cvtsi128_si32(sum) - (uint32_t)(blocks * 16 * 128);
+
+	return result + sumScalar(data + blocks * 16, length - blocks * 16);
+}
+
+__attribute__((target("avx2")))
+uint32_t ByteSum::sumAVX2(const char *data, const size_t length)
+{
+	const __m256i signBit = _mm256_set1_epi8((char)0x80);
+	const __m256i zero = _mm256_setzero_si256();
+	__m256i sum = _mm256_setzero_si256();
+
+	const size_t blocks = length / 32;
+	for(size_t i = 0; i < blocks; ++i) {
+		const __m256i bytes = _mm256_loadu_si256((const __m256i*)(data + i * 32));
+		sum = _mm256_add_epi64(sum, _mm256_sad_epu8(_mm256_xor_si256(bytes, signBit), zero));
+	}
+
+	// fold all four 64 bit lanes (only the lower 32 bits matter)
+	__m128i folded = _mm_add_epi64(_mm256_castsi256_si128(sum), _mm256_extracti128_si256(sum, 1));
+	folded = _mm_add_epi64(folded, _mm_unpackhi_epi64(folded, folded));
+	const uint32_t result = (uint32_t)_mm_cvtsi128_si32(folded) - (uint32_t)(blocks * 32 * 128);
+
+	return result + sumScalar(data + blocks * 32, length - blocks * 32);
+}
+
+#endif
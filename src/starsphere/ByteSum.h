@@ -0,0 +1,129 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef BYTESUM_H_
+#define BYTESUM_H_
+
+#include <cstddef>
+#include <stdint.h>
+
+// SIMD kernels are available for x86 compilers supporting per-function target selection
+#if (defined(__x86_64__) || defined(__i386__)) && \
+	(defined(__clang__) || (defined(__GNUC__) && (__GNUC__ >= 5)))
+#define BYTESUM_X86
+#endif
+
+/**
+ * \addtogroup starsphere Starsphere
+ * @{
+ */
+
+/**
+ * \brief Sum of the (signed) bytes of a memory block
+ *
+ * This class computes the sum of all bytes of a memory block, interpreted as \c char
+ * and accumulated modulo 2^32, as used by the checksum of the Hough checkpoints.
+ * The result is identical to adding up all bytes one at a time.
+ *
+ * The sum is computed by SIMD kernels (AVX2: 32, SSE2: 16 bytes per iteration) which
+ * flip each byte's sign bit (mapping -128..127 to 0..255), sum the resulting unsigned
+ * bytes using SAD instructions and subtract the offset afterwards. The best kernel
+ * supported by the host CPU is selected at runtime. On other platforms (or CPUs) a
+ * scalar fallback is used.
+ *
+ * \author Oliver Bock\n
+ * Max-Planck-Institute for Gravitational Physics\n
+ * Hannover, Germany
+ */
+class ByteSum
+{
+public:
+	/// Signature of the summation kernels
+	typedef uint32_t (*Kernel)(const char*, const size_t);
+
+	/// Available summation kernels
+	enum KernelType {
+		ScalarKernel,
+		SSE2Kernel,
+		AVX2Kernel
+	};
+
+	/**
+	 * \brief Computes the sum of all bytes of a memory block
+	 *
+	 * \param data Pointer to the memory block
+	 * \param length Length of the memory block (in bytes)
+	 *
+	 * \return The sum of all bytes (interpreted as \c char, modulo 2^32)
+	 */
+	static uint32_t sum(const char *data, const size_t length);
+
+	/**
+	 * \brief Returns the name of the summation kernel used on this host
+	 *
+	 * \return The kernel name ("avx2", "sse2" or "scalar")
+	 */
+	static const char *kernelName();
+
+	/**
+	 * \brief Returns a specific summation kernel (e.g. to compare it to the others)
+	 *
+	 * \param type The kernel to be returned
+	 *
+	 * \return The kernel, NULL if it isn't supported by this build or host CPU
+	 */
+	static Kernel kernel(const KernelType type);
+
+	/**
+	 * \brief Returns the name of a specific summation kernel
+	 *
+	 * \param type The kernel whose name should be returned
+	 *
+	 * \return The kernel name ("avx2", "sse2" or "scalar")
+	 */
+	static const char *kernelName(const KernelType type);
+
+private:
+	/// Selects the kernel to be used on this host (done once)
+	static void selectKernel();
+
+	/// Scalar summation kernel (reference/fallback, also used for remainders)
+	static uint32_t sumScalar(const char *data, const size_t length);
+
+#ifdef BYTESUM_X86
+	/// SSE2 summation kernel (16 bytes per iteration)
+	static uint32_t sumSSE2(const char *data, const size_t length);
+
+	/// AVX2 summation kernel (32 bytes per iteration)
+	static uint32_t sumAVX2(const char *data, const size_t length);
+#endif
+
+	/// Kernel selected for this host
+	static Kernel m_Kernel;
+
+	/// Name of the kernel selected for this host
+	static const char *m_KernelName;
+};
+
+/**
+ * @}
+ */
+
+#endif /*BYTESUM_H_*/
@@ -0,0 +1,165 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "CheckpointWatcher.h"
+
+#include <iostream>
+#include <cstdio>
+#include <dirent.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#endif
+
+CheckpointWatcher::CheckpointWatcher(const string prefix, const string suffix)
+{
+	m_Prefix = prefix;
+	m_Suffix = suffix;
+	m_Path = "";
+	m_ModificationTime = 0;
+	m_Size = -1;
+	m_NotifyDescriptor = -1;
+
+#ifdef __linux__
+	// watch the current (slot) directory for files written or renamed (non-blocking)
+	m_NotifyDescriptor = inotify_init();
+	if(m_NotifyDescriptor >= 0) {
+		fcntl(m_NotifyDescriptor, F_SETFL, fcntl(m_NotifyDescriptor, F_GETFL) | O_NONBLOCK);
+
+		if(inotify_add_watch(m_NotifyDescriptor, ".", IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+			cerr << "Couldn't watch checkpoint directory, falling back to polling!" << endl;
+			close(m_NotifyDescriptor);
+			m_NotifyDescriptor = -1;
+		}
+	}
+#endif
+}
+
+CheckpointWatcher::~CheckpointWatcher()
+{
+#ifdef __linux__
+	if(m_NotifyDescriptor >= 0) close(m_NotifyDescriptor);
+#endif
+}
+
+bool CheckpointWatcher::changed()
+{
+	// not yet resolved: scan directory (only done until we've found it)
+	if(m_Path.empty()) {
+		if(!resolve()) return false;
+
+		// drop notifications preceding the scan, we're going to read it anyway
+		if(m_NotifyDescriptor >= 0) readNotifications();
+		checkStatus();
+
+		return true;
+	}
+
+	if(m_NotifyDescriptor >= 0) {
+		return readNotifications();
+	}
+
+	return checkStatus();
+}
+
+string CheckpointWatcher::path() const
+{
+	return m_Path;
+}
+
+bool CheckpointWatcher::matches(const string filename) const
+{
+	return filename.length() >= m_Prefix.length() + m_Suffix.length() &&
+		   filename.compare(0, m_Prefix.length(), m_Prefix) == 0 &&
+		   filename.compare(filename.length() - m_Suffix.length(), m_Suffix.length(), m_Suffix) == 0;
+}
+
+bool CheckpointWatcher::resolve()
+{
+	DIR *directory = opendir(".");
+	if(!directory) {
+		cerr << "Couldn't open checkpoint directory!" << endl;
+		return false;
+	}
+
+	struct dirent *entry;
+	while((entry = readdir(directory))) {
+		if(matches(entry->d_name)) {
+			m_Path = entry->d_name;
+			break;
+		}
+	}
+	closedir(directory);
+
+	return !m_Path.empty();
+}
+
+bool CheckpointWatcher::readNotifications()
+{
+	bool written = false;
+
+#ifdef __linux__
+	// buffer for (at least) one event of maximum size
+	char buffer[sizeof(struct inotify_event) + FILENAME_MAX + 1]
+		__attribute__ ((aligned(__alignof__(struct inotify_event))));
+
+	ssize_t length;
+	while((length = read(m_NotifyDescriptor, buffer, sizeof(buffer))) > 0) {
+		for(char *position = buffer; position < buffer + length; ) {
+			const struct inotify_event *event = (const struct inotify_event*) position;
+
+			// the checkpoint might be a new one (e.g. new work unit), hence check the pattern
+			if(event->len > 0 && matches(event->name)) {
+				m_Path = event->name;
+				written = true;
+			}
+
+			position += sizeof(struct inotify_event) + event->len;
+		}
+	}
+#endif
+
+	return written;
+}
+
+bool CheckpointWatcher::checkStatus()
+{
+	struct stat status;
+
+	if(stat(m_Path.c_str(), &status) != 0) {
+		// gone (e.g. work unit finished): resolve again
+		m_Path = "";
+		m_Size = -1;
+		return false;
+	}
+
+	if(status.st_mtime == m_ModificationTime && status.st_size == m_Size) {
+		return false;
+	}
+
+	m_ModificationTime = status.st_mtime;
+	m_Size = status.st_size;
+
+	return true;
+}
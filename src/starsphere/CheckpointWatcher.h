@@ -0,0 +1,138 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef CHECKPOINTWATCHER_H_
+#define CHECKPOINTWATCHER_H_
+
+#include <string>
+#include <ctime>
+#include <sys/types.h>
+
+using namespace std;
+
+/**
+ * \addtogroup starsphere Starsphere
+ * @{
+ */
+
+/**
+ * \brief Detects new checkpoints written by the science application
+ *
+ * This class resolves the checkpoint file (identified by its name's prefix and suffix)
+ * in the current (slot) directory and reports whenever the science application has
+ * written a new checkpoint. On Linux it uses inotify to watch the directory, so
+ * there's no I/O at all as long as nothing changes. It catches checkpoints written in
+ * place as well as written to a temporary file and renamed afterwards. On other
+ * platforms (or if inotify isn't available) it falls back to comparing the file's
+ * modification time and size.
+ *
+ * The directory is only scanned as long as the checkpoint file hasn't been resolved.
+ *
+ * \author Oliver Bock\n
+ * Max-Planck-Institute for Gravitational Physics\n
+ * Hannover, Germany
+ */
+class CheckpointWatcher
+{
+public:
+	/**
+	 * \brief Constructor
+	 *
+	 * \param prefix The prefix of the checkpoint's file name
+	 * \param suffix The suffix of the checkpoint's file name
+	 */
+	CheckpointWatcher(const string prefix, const string suffix);
+
+	/// Destructor
+	virtual ~CheckpointWatcher();
+
+	/**
+	 * \brief Checks whether a new checkpoint has been written
+	 *
+	 * The first successful call after the checkpoint has been resolved returns TRUE as well.
+	 *
+	 * \return TRUE if there's a new checkpoint (since the last call), FALSE otherwise
+	 *
+	 * \see path()
+	 */
+	bool changed();
+
+	/**
+	 * \brief Retrieves the name of the checkpoint file
+	 *
+	 * \return The checkpoint's file name (empty if it hasn't been resolved yet)
+	 */
+	string path() const;
+
+private:
+	/**
+	 * \brief Checks whether a file name matches the checkpoint's prefix and suffix
+	 *
+	 * \param filename The file name to be checked
+	 *
+	 * \return TRUE if the name matches, FALSE otherwise
+	 */
+	bool matches(const string filename) const;
+
+	/**
+	 * \brief Scans the current directory for the checkpoint file
+	 *
+	 * \return TRUE if the checkpoint has been found, FALSE otherwise
+	 */
+	bool resolve();
+
+	/**
+	 * \brief Processes pending inotify events
+	 *
+	 * \return TRUE if the checkpoint has been written, FALSE otherwise
+	 */
+	bool readNotifications();
+
+	/**
+	 * \brief Checks the checkpoint's status (fallback)
+	 *
+	 * \return TRUE if the checkpoint's modification time or size changed, FALSE otherwise
+	 */
+	bool checkStatus();
+
+	/// The prefix of the checkpoint's file name
+	string m_Prefix;
+
+	/// The suffix of the checkpoint's file name
+	string m_Suffix;
+
+	/// The resolved checkpoint file name
+	string m_Path;
+
+	/// The checkpoint's modification time at the last check (fallback)
+	time_t m_ModificationTime;
+
+	/// The checkpoint's size at the last check (fallback)
+	off_t m_Size;
+
+	/// The inotify instance (-1 if not available)
+	int m_NotifyDescriptor;
+};
+
+/**
+ * @}
+ */
+
+#endif /*CHECKPOINTWATCHER_H_*/
@@ -20,15 +20,48 @@
 
 #include "EinsteinRadioAdapter.h"
 
-#include <sstream>
 
 const string EinsteinRadioAdapter::SharedMemoryIdentifier = "EinsteinRadio";
 
+const signed char EinsteinRadioAdapter::HEX_DIGIT_VALUES[256] = {
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,
+	-1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
+const XMLFieldScanner<EinsteinRadioAdapter>::Field EinsteinRadioAdapter::PULSAR_INFO_FIELDS[] = {
+	{"skypos_rac", &EinsteinRadioAdapter::m_WUSkyPosRightAscension, NULL},
+	{"skypos_dec", &EinsteinRadioAdapter::m_WUSkyPosDeclination, NULL},
+	{"dispersion", &EinsteinRadioAdapter::m_WUDispersionMeasure, NULL},
+	{"orb_radius", &EinsteinRadioAdapter::m_WUTemplateOrbitalRadius, NULL},
+	{"orb_period", &EinsteinRadioAdapter::m_WUTemplateOrbitalPeriod, NULL},
+	{"orb_phase", &EinsteinRadioAdapter::m_WUTemplateOrbitalPhase, NULL},
+	{"power_spectrum", NULL, &EinsteinRadioAdapter::parsePowerSpectrum},
+	{"fraction_done", &EinsteinRadioAdapter::m_WUFractionDone, NULL},
+	{"cpu_time", &EinsteinRadioAdapter::m_WUCPUTime, NULL}
+};
+
+const int EinsteinRadioAdapter::PULSAR_INFO_FIELD_COUNT = sizeof(PULSAR_INFO_FIELDS) / sizeof(PULSAR_INFO_FIELDS[0]);
+
 EinsteinRadioAdapter::EinsteinRadioAdapter(BOINCClientAdapter *boincClient) :
+	m_InformationScanner(PULSAR_INFO_FIELDS, PULSAR_INFO_FIELD_COUNT),
 	m_WUTemplatePowerSpectrum(POWERSPECTRUM_BINS, 0)
 {
 	this->boincClient = boincClient;
-	m_xmlReader = NULL;
+	m_ApplicationInformationRevision = 0;
 
 	m_WUSkyPosRightAscension = 0.0;
 	m_WUSkyPosDeclination = 0.0;
@@ -38,8 +71,6 @@ EinsteinRadioAdapter::EinsteinRadioAdapter(BOINCClientAdapter *boincClient) :
 
 EinsteinRadioAdapter::~EinsteinRadioAdapter()
 {
-	if(m_xmlReader) xmlFreeTextReader(m_xmlReader);
-    xmlCleanupParser();
 }
 
 void EinsteinRadioAdapter::refresh()
@@ -50,149 +81,59 @@ void EinsteinRadioAdapter::refresh()
 
 void EinsteinRadioAdapter::parseApplicationInformation()
 {
+	// parse only when the science application updated its information
+	if(boincClient->applicationInformationRevision() == m_ApplicationInformationRevision) return;
+	m_ApplicationInformationRevision = boincClient->applicationInformationRevision();
+
 	// get updated application information
-	string info = boincClient->applicationInformation();
+	const string& info = boincClient->applicationInformation();
 
 	// do we have any data?
 	if(info.length() > 0) {
-		int result = 0;
-
-		// prepare conversion stream
-		stringstream converter;
-		converter.precision(3);
-		converter.exceptions(ios_base::badbit | ios_base::failbit);
-
-		if(!m_xmlReader) {
-			// set up SAX style XML reader (create instance)
-			m_xmlReader = xmlReaderForMemory(info.c_str(),
-											 info.length(),
-											 "http://einstein.phys.uwm.edu",
-											 "UTF-8",
-											 0);
-			if(!m_xmlReader) {
-				cerr << "Error creating XML reader for shared memory data!" << endl;
-				return;
-			}
-		}
-		else {
-			// set up SAX style XML reader (reusing existing instance)
-			if(xmlReaderNewMemory(m_xmlReader,
-								  info.c_str(),
-								  info.length(),
-								  "http://einstein.phys.uwm.edu",
-								  "UTF-8",
-								  0))
-			{
-				cerr << "Error updating XML reader for shared memory data!" << endl;
-				return;
-			}
+		// parse data into members (order and whitespace don't matter)
+		if(0 == m_InformationScanner.scan(*this, info.c_str())) {
+			cerr << "Incompatible shared memory data encountered!" << endl;
+			return;
 		}
 
-		// parse XML fragment and process nodes
-        result = xmlTextReaderRead(m_xmlReader);
-        while (result == 1) {
-        	processXmlNode(m_xmlReader, converter);
-            result = xmlTextReaderRead(m_xmlReader);
-        }
-
 		// convert radians to degrees
 		m_WUSkyPosRightAscension *= 180/PI;
 		m_WUSkyPosDeclination *= 180/PI;
-
-		// deserialize power spectrum data
-		if(m_WUTemplatePowerSpectrumString.length() == POWERSPECTRUM_BIN_BYTES) {
-			int spectrumBinValue;
-;
-			// iterate over all bins
-			for(int i = 0, j = 0; i < POWERSPECTRUM_BIN_BYTES; i += 2, ++j) {
-				try {
-					converter.clear();
-					converter.str(m_WUTemplatePowerSpectrumString.substr(i, 2));
-					// convert hex bin value to integer
-					converter >> hex >> spectrumBinValue;
-					// store bin power value
-					m_WUTemplatePowerSpectrum.at(j) = (unsigned char) spectrumBinValue;
-				}
-				catch(ios_base::failure) {
-					cerr << "Error processing power spectrum shared memory data!" << endl;
-					break;
-				}
-			}
-		}
-		else {
-			cerr << "Invalid power spectrum shared memory data encountered!" << endl;
-		}
-
 	}
 }
 
-void EinsteinRadioAdapter::processXmlNode(const xmlTextReaderPtr xmlReader, stringstream& converter)
+bool EinsteinRadioAdapter::parsePowerSpectrum(const char *text, size_t length)
 {
-	// we only parse element nodes
-    if(xmlTextReaderNodeType(xmlReader) != XML_READER_TYPE_ELEMENT) return;
-
-    // buffers (will be deallocated automatically)
-    const xmlChar *nodeName = NULL, *nodeValue = NULL;
-
-    // get element node's name
-    nodeName = xmlTextReaderConstLocalName(xmlReader);
-
-    if (nodeName == NULL) {
-		cerr << "Error parsing XML node (invalid name)" << endl;
-		return;
-    }
-
-	// move to node's text content (child node) or return if unavailable
-	if(! (xmlTextReaderRead(m_xmlReader) && xmlTextReaderHasValue(xmlReader))) {
-		return;
+	// two hex digits per bin
+	if(length == 0 || length % 2 != 0) {
+		cerr << "Invalid power spectrum shared memory data encountered!" << endl;
+		return false;
 	}
 
-	// get text node's value
-	nodeValue = xmlTextReaderConstValue(xmlReader);
+	// size changes are rare, hence the buffer usually doesn't get reallocated
+	const size_t bins = length / 2;
+	if(m_WUTemplatePowerSpectrum.size() != bins) {
+		m_WUTemplatePowerSpectrum.resize(bins);
+	}
 
-	if (nodeValue == NULL) {
-		cerr << "Error parsing XML node (invalid value)" << endl;
-		return;
+	// decode bins via lookup table (invalid digits are flagged by the sign bit)
+	unsigned char *spectrum = &m_WUTemplatePowerSpectrum[0];
+	int invalid = 0;
+	for(size_t i = 0; i < bins; ++i) {
+		const int high = HEX_DIGIT_VALUES[(unsigned char) text[2*i]];
+		const int low = HEX_DIGIT_VALUES[(unsigned char) text[2*i + 1]];
+		invalid |= high | low;
+		spectrum[i] = (unsigned char) ((high << 4) | low);
 	}
 
-    try {
-        // prepare converter stream
-        converter.clear();
-        converter.str("");
-        converter << nodeValue;
+	if(invalid < 0) {
+		// don't show garbage
+		m_WUTemplatePowerSpectrum.assign(bins, 0);
+		cerr << "Error processing power spectrum shared memory data!" << endl;
+		return false;
+	}
 
-		// assign node value to respective data member
-		if(xmlStrEqual(nodeName, BAD_CAST("skypos_rac"))) {
-			converter >> fixed >> m_WUSkyPosRightAscension;
-		}
-		else if(xmlStrEqual(nodeName, BAD_CAST("skypos_dec"))) {
-			converter >> fixed >> m_WUSkyPosDeclination;
-		}
-		else if(xmlStrEqual(nodeName, BAD_CAST("dispersion"))) {
-			converter >> fixed >> m_WUDispersionMeasure;
-		}
-		else if(xmlStrEqual(nodeName, BAD_CAST("orb_radius"))) {
-			converter >> fixed >> m_WUTemplateOrbitalRadius;
-		}
-		else if(xmlStrEqual(nodeName, BAD_CAST("orb_period"))) {
-			converter >> fixed >> m_WUTemplateOrbitalPeriod;
-		}
-		else if(xmlStrEqual(nodeName, BAD_CAST("orb_phase"))) {
-			converter >> fixed >> m_WUTemplateOrbitalPhase;
-		}
-		else if(xmlStrEqual(nodeName, BAD_CAST("power_spectrum"))) {
-			converter >> m_WUTemplatePowerSpectrumString;
-		}
-		else if(xmlStrEqual(nodeName, BAD_CAST("fraction_done"))) {
-			converter >> fixed >> m_WUFractionDone;
-		}
-		else if(xmlStrEqual(nodeName, BAD_CAST("cpu_time"))) {
-			converter >> fixed >> m_WUCPUTime;
-		}
-    }
-    catch(ios_base::failure) {
-    	cerr << "Error converting XML reader node content!" << endl;
-    }
+	return true;
 }
 
 double EinsteinRadioAdapter::wuSkyPosRightAscension() const
@@ -26,15 +26,13 @@
 #include <iomanip>
 #include <vector>
 
-#include <libxml/xmlreader.h>
-
 #include "BOINCClientAdapter.h"
+#include "XMLFieldScanner.h"
 
 using namespace std;
 
 #define PI 3.14159265
 #define POWERSPECTRUM_BINS 40
-#define POWERSPECTRUM_BIN_BYTES 80
 
 /**
  * \addtogroup starsphere Starsphere
@@ -149,28 +147,42 @@ private:
 	 * which is handled by the parent generic BOINC client adapter.
 	 *
 	 * \see boincClient
+	 * \see PULSAR_INFO_FIELDS
 	 */
 	void parseApplicationInformation();
 
 	/**
-	 * \brief Processes single element nodes found by the XML parser
+	 * \brief Decodes the power spectrum (two hex digits per bin) into \ref m_WUTemplatePowerSpectrum
+	 *
+	 * The number of bins is given by the length of the contents. The spectrum is cleared
+	 * if it contains invalid digits.
 	 *
-	 * This method can sort of resembles the callback method used in conjunction with SAX parsers.
-	 * It's called to process single XML nodes (in our case element nodes only) encountered
-	 * during XML document (tree) traversal.
+	 * \param text The \c power_spectrum element's contents (not zero terminated)
+	 * \param length The length of the contents
 	 *
-	 * \param xmlReader The pointer to the current xmlReader instance
-	 * \param converter Reference to an existing string stream for value/type conversion
+	 * \return TRUE if the power spectrum is valid, FALSE otherwise
 	 *
-	 * \see parseApplicationInformation()
+	 * \see PULSAR_INFO_FIELDS
 	 */
-	void processXmlNode(const xmlTextReaderPtr xmlReader, stringstream& converter);
+	bool parsePowerSpectrum(const char *text, size_t length);
+
+	/// Lookup table for hex digits (-1: invalid digit)
+	static const signed char HEX_DIGIT_VALUES[256];
+
+	/// Fields of the \c pulsar_info shared memory data
+	static const XMLFieldScanner<EinsteinRadioAdapter>::Field PULSAR_INFO_FIELDS[];
+
+	/// Number of fields of the \c pulsar_info shared memory data
+	static const int PULSAR_INFO_FIELD_COUNT;
 
 	/// Pointer to the (parent) BOINC client adapter
 	BOINCClientAdapter *boincClient;
 
-	/// Pointer to the XML reader (SAX style)
-	xmlTextReaderPtr m_xmlReader;
+	/// Revision of the application information parsed last
+	unsigned int m_ApplicationInformationRevision;
+
+	/// Scanner for the \c pulsar_info shared memory data
+	XMLFieldScanner<EinsteinRadioAdapter> m_InformationScanner;
 
 	/// Right ascension of the currently searched sky position (in degrees)
 	double m_WUSkyPosRightAscension;
@@ -190,9 +202,6 @@ private:
 	/// Initial orbital phase of the currently active template
 	double m_WUTemplateOrbitalPhase;
 
-	/// Power spectrum of the currently active template (string)
-	string m_WUTemplatePowerSpectrumString;
-
 	/// Power spectrum of the currently active template (values)
 	vector<unsigned char> m_WUTemplatePowerSpectrum;
 
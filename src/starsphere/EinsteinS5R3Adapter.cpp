@@ -21,32 +21,56 @@
 #include "EinsteinS5R3Adapter.h"
 #include <cstdio>
 #include <stdint.h>
-#include <dirent.h>
-#include "filesys.h" 
+#include <cstring>
+#include <cstddef>
+#include <sstream>
+#include <algorithm>
+
+#include "ByteSum.h"
 
 
 const string EinsteinS5R3Adapter::SharedMemoryIdentifier = "EinsteinHS";
 
 const long EinsteinS5R3Adapter::MAX_RESULT_COUNT = 10000;
 
+const int EinsteinS5R3Adapter::MAX_CHECKPOINT_READ_ATTEMPTS = 3;
+
+const XMLFieldScanner<EinsteinS5R3Adapter>::Field EinsteinS5R3Adapter::GRAPHICS_INFO_FIELDS[] = {
+	{"skypos_rac", &EinsteinS5R3Adapter::m_WUSkyPosRightAscension, NULL},
+	{"skypos_dec", &EinsteinS5R3Adapter::m_WUSkyPosDeclination, NULL},
+	{"fraction_done", &EinsteinS5R3Adapter::m_WUFractionDone, NULL},
+	{"cpu_time", &EinsteinS5R3Adapter::m_WUCPUTime, NULL}
+};
+
+const int EinsteinS5R3Adapter::GRAPHICS_INFO_FIELD_COUNT = sizeof(GRAPHICS_INFO_FIELDS) / sizeof(GRAPHICS_INFO_FIELDS[0]);
+
 
-EinsteinS5R3Adapter::EinsteinS5R3Adapter(BOINCClientAdapter *boincClient)
+EinsteinS5R3Adapter::EinsteinS5R3Adapter(BOINCClientAdapter *boincClient) :
+	m_InformationScanner(GRAPHICS_INFO_FIELDS, GRAPHICS_INFO_FIELD_COUNT),
+	m_CheckpointWatcher("h1_", ".cpt")
 {
 	this->boincClient = boincClient;
+	m_ApplicationInformationRevision = 0;
 
 	m_WUSkyPosRightAscension = 0.0;
 	m_WUSkyPosDeclination = 0.0;
-	m_last_RA = 0.0;
-	m_last_dec = 0.0;
 	m_WUFractionDone = 0.0;
 	m_WUCPUTime = 0.0;
-	m_last_WUCPUTime = 0.0;
+	m_CheckpointPending = false;
+	m_ProjectPreferencesRevision = 0;
+	m_PreferencesReader = XMLProcessorFactory::createInstance();
+	m_WorkUnitRevision = 0;
+	m_CandidateLimit = MAX_RESULT_COUNT;
+	m_CandidateMetric = HoughFStatMetric;
+	m_CandidateRanks.reserve(MAX_RESULT_COUNT);
 	m_Nresults= 0;
+	m_CandidateRevision = 0;
 	m_results = new EinsteinS5R3Result[MAX_RESULT_COUNT];
 }
 
 EinsteinS5R3Adapter::~EinsteinS5R3Adapter()
 {
+	delete m_PreferencesReader;
 	delete [] m_results;
 }
 
@@ -56,38 +80,51 @@ void EinsteinS5R3Adapter::refresh()
 	boincClient->refresh();
 	parseApplicationInformation();
 
-	// check that some time has past since last checkpoint file loading	
-	// if data is not loaded yet or marker position has changed
-	// try to load checkpoint_file
-	if( m_Nresults == 0 ||
-		  (m_WUCPUTime - m_last_WUCPUTime) >  60.0  &&  
-                    (m_last_RA != wuSkyPosRightAscension() || m_last_dec != wuSkyPosDeclination())) { 
-			loadCheckpointFile();
-			m_last_WUCPUTime = m_WUCPUTime;
-			m_last_RA = wuSkyPosRightAscension();
-			m_last_dec = wuSkyPosDeclination();
+	// reload candidate preferences only when the project preferences changed
+	if(boincClient->projectPreferencesRevision() != m_ProjectPreferencesRevision) {
+		const long limit = m_CandidateLimit;
+		const CandidateMetric metric = m_CandidateMetric;
+
+		readCandidatePreferences();
+		m_ProjectPreferencesRevision = boincClient->projectPreferencesRevision();
+
+		// select candidates again
+		if(m_CandidateLimit != limit || m_CandidateMetric != metric) {
+			m_CheckpointPending = true;
+		}
+	}
+
+	// a new work unit invalidates the candidates of the previous one
+	if(boincClient->workUnitRevision() != m_WorkUnitRevision) {
+		if(m_WorkUnitRevision != 0) {
+			m_Nresults = 0;
+			m_CandidateRevision++;
+			m_CheckpointPending = true;
+		}
+		m_WorkUnitRevision = boincClient->workUnitRevision();
+	}
+
+	// load checkpoint file only when the science app has written a new one
+	// (or when the last attempt failed)
+	if(m_CheckpointWatcher.changed() || m_CheckpointPending) {
+		m_CheckpointPending = loadCheckpointFile() != 0;
 	}
 }
 
 void EinsteinS5R3Adapter::parseApplicationInformation()
 {
+	// parse only when the science application updated its information
+	if(boincClient->applicationInformationRevision() == m_ApplicationInformationRevision) return;
+	m_ApplicationInformationRevision = boincClient->applicationInformationRevision();
+
 	// get updated application information
-	string info = boincClient->applicationInformation();
+	const string& info = boincClient->applicationInformation();
 
 	// do we have any data?
 	if(info.length() > 0) {
 
-		// parse data into members
-		if(4 != sscanf(info.c_str(),
-			  		"<graphics_info>\n"
-			  		"  <skypos_rac>%lf</skypos_rac>\n"
-			  		"  <skypos_dec>%lf</skypos_dec>\n"
-			  		"  <fraction_done>%lf</fraction_done>\n"
-			  		"  <cpu_time>%lf</cpu_time>\n",
-			  		&m_WUSkyPosRightAscension,
-			  		&m_WUSkyPosDeclination,
-			  		&m_WUFractionDone,
-			  		&m_WUCPUTime))
+		// parse data into members (order and whitespace don't matter)
+		if(GRAPHICS_INFO_FIELD_COUNT != m_InformationScanner.scan(*this, info.c_str()))
 		{
 			cerr << "Incompatible shared memory data encountered!" << endl;
 		}
@@ -99,47 +136,16 @@ void EinsteinS5R3Adapter::parseApplicationInformation()
 	}
 }
 
-void EinsteinS5R3Adapter::loadCheckpointFile() {
+int EinsteinS5R3Adapter::loadCheckpointFile() {
 	UINT4 counter;
-	int res;
-	string fname("");
-	// look for *.cpt file
-
-	// directory traversal, not entirely portable, tho.
-	DIR *pdir;
- 	struct dirent *pent;
-
- 	pdir=opendir("."); //"." refers to the current dir
-	if (!pdir){
- 		cerr << "opendir() failure;" << endl;
-		closedir(pdir);
-		return;
- 	}
-
- 	while ((pent=readdir(pdir))){
-		fname =  pent->d_name;
-		
-		string::size_type pos1 = fname.find("h1_");
-		string::size_type pos2 = fname.rfind(".cpt");
-
-		if(pos1 == 0 && pos2 == fname.length() -4) {			
-			break;
-		} 
- 	}
- 	closedir(pdir);
-	
-
-	if(fname != "") {
-		boinc_copy(fname.c_str(),"temp.cpt");
-	}
-	// try copying checkpoint file to tmp file
-	
 
-	// open tmp file and read candidates
-	// plus normalize data 	
+	// the watcher resolved the checkpoint file for us
+	if(m_CheckpointWatcher.path().empty()) return(-1);
+
+	// read candidates chunk by chunk (bounded copy, no temporary file required)
+	// plus normalize data
 	// and set the current buffer and result nr..
-	res=read_hfs_checkpoint("temp.cpt", &counter);
-	// no error handling, we can't do anything about it anyways
+	return read_hfs_checkpoint(m_CheckpointWatcher.path().c_str(), &counter);
 }
 
 double EinsteinS5R3Adapter::wuSkyPosRightAscension() const
@@ -178,99 +184,209 @@ long EinsteinS5R3Adapter::copyCandidates(float res [][3] , long n) const
 	return nr;
 }
 
+unsigned int EinsteinS5R3Adapter::candidateRevision() const
+{
+	return m_CandidateRevision;
+}
+
 
 
 int EinsteinS5R3Adapter::read_hfs_checkpoint(const char*filename, UINT4*counter) {
-  FILE*fp;
-  UINT4 len;
-  UINT4 checksum;
-  UINT4 tl_elems;
-  HoughFStatOutputEntry buffer[MAX_RESULT_COUNT];  
+  BufferedFile &checkpoint = m_CheckpointFile;
+  int res;
+
   /* counter should be 0 if we couldn't read a checkpoint */
   *counter = 0;
 
-  /* try to open file */
-  fp = fopen(filename, "rb");
-  if(!fp) {
+  /* the checkpoint might get written while we read it, hence we retry
+     until we got a consistent snapshot (file unchanged while reading) */
+  for(int attempt = 1; ; attempt++) {
+    if(!checkpoint.open(filename)) {
       cerr << "Checkpoint "<< filename << " couldn't be opened\n";
       return(-1);
-  }
+    }
 
-  /* read number of elements */
-  len = fread(&(tl_elems), sizeof(tl_elems), 1, fp);
-  
+    res = decode_hfs_checkpoint(checkpoint, filename, counter);
 
-  if(len != 1) {
-    cerr << "Couldn't read elems from " <<  filename << endl;
-    cerr << "fread() returned " << len << " , length was 1\n";
-    if(fclose(fp))
-      cerr << "In addition: couldn't close "<< filename << endl;
-    return(-1);
+    if(checkpoint.unchanged()) {
+      break;
+    }
+
+    if(attempt == MAX_CHECKPOINT_READ_ATTEMPTS) {
+      cerr << "Checkpoint " << filename << " kept changing while reading it\n";
+      res = -1;
+      break;
+    }
   }
-  /* sanity check */
-  if (tl_elems > MAX_RESULT_COUNT) {
-    cerr << "Number of elements read larger than max length of checkpoint data: " << tl_elems  << " > " << MAX_RESULT_COUNT <<"\n";
-    if(fclose(fp))
-      cerr << "In addition: couldn't close\n";
-    return(-2);
+
+  checkpoint.close();
+
+  if(res != 0) {
+    /* candidates might be inconsistent, invalidate them (triggers reload) */
+    *counter = 0;
+    m_Nresults = 0;
+    m_CandidateRevision++;
   }
 
-  /* read data */
-  len = fread(buffer, sizeof(HoughFStatOutputEntry), tl_elems, fp);
-  if(len != tl_elems) {
-    cerr << "Couldn't read data from " << filename << endl;
-    if(fclose(fp))
-      cerr << "In addition: couldn't close " << filename << endl;
+  return(res);
+}
+
+int EinsteinS5R3Adapter::decode_hfs_checkpoint(BufferedFile &checkpoint, const char*filename, UINT4*counter) {
+  const UINT4 chunk_elems = BufferedFile::CHUNK_SIZE / sizeof(HoughFStatOutputEntry);
+  const size_t size = checkpoint.size();
+  UINT4 checksum;
+  UINT4 sum;
+  UINT4 tl_elems;
+  UINT4 first;
+  UINT4 count;
+  const char *data;
+  HoughFStatOutputEntry entry;
+
+  /* read number of elements */
+  if(size < sizeof(tl_elems) || !(data = checkpoint.read(0, sizeof(tl_elems)))) {
+    cerr << "Couldn't read elems from " <<  filename << endl;
     return(-1);
   }
+  memcpy(&tl_elems, data, sizeof(tl_elems));
+  sum = ByteSum::sum(data, sizeof(tl_elems));
 
-  /* read counter */
-  len = fread(counter, sizeof(*counter), 1, fp);
-  if(len != 1) {
-    cerr << "Couldn't read counter from " << filename << endl;
-    cerr << "fread() returned "<< len << ", length was 1\n";
-    if(fclose(fp))
-      cerr << "In addition: couldn't close " <<  filename << endl;
+  /* check size (elements, counter and checksum) */
+  if((size - sizeof(tl_elems)) / sizeof(HoughFStatOutputEntry) < tl_elems ||
+     size != sizeof(tl_elems) + tl_elems * sizeof(HoughFStatOutputEntry) + sizeof(*counter) + sizeof(checksum)) {
+    cerr << "Couldn't read data from " << filename << endl;
+    cerr << "File size is " << size << ", expected data for " << tl_elems << " elements\n";
     return(-1);
   }
 
-  /* read checksum */
-  len = fread(&checksum, sizeof(checksum), 1, fp);
-  if(len != 1) {
-    cerr << "Couldn't read checksum to " <<  filename << endl;
-    cerr << "fread() returned "<< len << ", length was 1\n";
-    if(fclose(fp))
-      cerr << "In addition: couldn't close "<< filename << endl;
-    return(-1);
+  /* first pass: sum up and select the most significant candidates chunk by chunk */
+  m_CandidateRanks.clear();
+  for(first = 0 ; first < tl_elems ; first += count) {
+    count = min(chunk_elems, tl_elems - first);
+    if(!(data = checkpoint.read(sizeof(tl_elems) + first * sizeof(HoughFStatOutputEntry), count * sizeof(HoughFStatOutputEntry)))) {
+      cerr << "Couldn't read data from " << filename << endl;
+      return(-1);
+    }
+    sum += ByteSum::sum(data, count * sizeof(HoughFStatOutputEntry));
+    select_hfs_candidates(data, first, count);
   }
 
-  /* close file */
-  if(fclose(fp)) {
-    cerr << "Couldn't close " <<  filename << endl;
+  /* read counter and checksum */
+  if(!(data = checkpoint.read(size - sizeof(*counter) - sizeof(checksum), sizeof(*counter) + sizeof(checksum)))) {
+    cerr << "Couldn't read counter from " << filename << endl;
     return(-1);
   }
+  memcpy(counter, data, sizeof(*counter));
+  memcpy(&checksum, data + sizeof(*counter), sizeof(checksum));
+  sum += ByteSum::sum(data, sizeof(*counter));
 
-  /* verify checksum */
-  for(len = 0; len < sizeof(tl_elems); len++)
-    checksum -= *(((char*)&(tl_elems)) + len);
-  for(len = 0; len < (tl_elems * sizeof(HoughFStatOutputEntry)); len++)
-    checksum -= *(((char*)buffer) + len);
-  for(len = 0; len < sizeof(*counter); len++)
-    checksum -= *(((char*)counter) + len);
+  /* verify checksum (all bytes in front of it) */
+  checksum -= sum;
   if(checksum) {
     cerr << "Checksum error: "<< checksum << endl;
     return(-2);
   }
 
+  /* keep the display stable between checkpoints */
+  sort(m_CandidateRanks.begin(), m_CandidateRanks.end(), toplist_order);
 
-  for(UINT4 i=0 ; i < tl_elems ; i++) {
-	m_results[i].ra = buffer[i].Alpha / PI * 180.0;
-	m_results[i].dec= buffer[i].Delta / PI * 180.0;
-	m_results[i].maxsig = buffer[i].HoughFStat;
-	m_results[i].meansig = (buffer[i].MeanSig) > 0.0 ? buffer[i].MeanSig : 0.0 ; 
+  /* second pass: decode the selected candidates (chunks without any of them are skipped) */
+  for(size_t i=0 ; i < m_CandidateRanks.size() ; ) {
+    first = m_CandidateRanks[i].index - m_CandidateRanks[i].index % chunk_elems;
+    count = min(chunk_elems, tl_elems - first);
+    if(!(data = checkpoint.read(sizeof(tl_elems) + first * sizeof(HoughFStatOutputEntry), count * sizeof(HoughFStatOutputEntry)))) {
+      cerr << "Couldn't read data from " << filename << endl;
+      return(-1);
+    }
+
+    /* decode candidates directly (entries aren't necessarily aligned) */
+    for( ; i < m_CandidateRanks.size() && m_CandidateRanks[i].index < first + count ; i++) {
+      memcpy(&entry, data + (m_CandidateRanks[i].index - first) * sizeof(HoughFStatOutputEntry), sizeof(HoughFStatOutputEntry));
+      m_results[i].ra = entry.Alpha / PI * 180.0;
+      m_results[i].dec= entry.Delta / PI * 180.0;
+      m_results[i].maxsig = entry.HoughFStat;
+      m_results[i].meansig = (entry.MeanSig) > 0.0 ? entry.MeanSig : 0.0 ;
+    }
   }
-  m_Nresults= tl_elems;		
+  m_Nresults= m_CandidateRanks.size();
+  m_CandidateRevision++;
   /* all went well */
   return(0);
 }
 
+bool EinsteinS5R3Adapter::more_significant(const CandidateRank &a, const CandidateRank &b) {
+  return a.significance > b.significance;
+}
+
+bool EinsteinS5R3Adapter::toplist_order(const CandidateRank &a, const CandidateRank &b) {
+  return a.index < b.index;
+}
+
+void EinsteinS5R3Adapter::select_hfs_candidates(const char*entries, UINT4 first, UINT4 count) {
+  const size_t offset = (m_CandidateMetric == MeanSignificanceMetric) ?
+                        offsetof(HoughFStatOutputEntry, MeanSig) : offsetof(HoughFStatOutputEntry, HoughFStat);
+  CandidateRank rank;
+
+  /* stream the entries through the heap, only the metric is read */
+  for(UINT4 i=0 ; i < count ; i++) {
+    memcpy(&rank.significance, entries + i * sizeof(HoughFStatOutputEntry) + offset, sizeof(rank.significance));
+    rank.index = first + i;
+
+    if(m_CandidateRanks.size() < (size_t)m_CandidateLimit) {
+      m_CandidateRanks.push_back(rank);
+      push_heap(m_CandidateRanks.begin(), m_CandidateRanks.end(), more_significant);
+    }
+    else if(rank.significance > m_CandidateRanks.front().significance) {
+      pop_heap(m_CandidateRanks.begin(), m_CandidateRanks.end(), more_significant);
+      m_CandidateRanks.back() = rank;
+      push_heap(m_CandidateRanks.begin(), m_CandidateRanks.end(), more_significant);
+    }
+  }
+}
+
+void EinsteinS5R3Adapter::readCandidatePreferences()
+{
+	// XPath queries (resolved in one batch)
+	static const char *queries[] = {
+		"/project_preferences/graphics/engine[@name='starsphere']/candidates/@count",
+		"/project_preferences/graphics/engine[@name='starsphere']/candidates/@metric"
+	};
+	static const vector<string> xpaths(queries, queries + sizeof(queries) / sizeof(queries[0]));
+
+	vector<string> values;
+	long limit;
+	istringstream converter;
+	converter.exceptions(ios_base::badbit | ios_base::failbit);
+
+	// defaults apply unless set (again)
+	m_CandidateLimit = MAX_RESULT_COUNT;
+	m_CandidateMetric = HoughFStatMetric;
+
+	// prepare xml document
+	m_PreferencesReader->setXmlDocument(boincClient->projectInformation(), "http://einstein.phys.uwm.edu");
+
+	// use XPath queries to get attributes
+	m_PreferencesReader->getSingleNodeContentsByXPath(xpaths, values);
+
+	try {
+		if(values[0].length() > 0) {
+			converter.clear();
+			converter.str(values[0]);
+			converter >> dec >> limit;
+
+			// we can't display more than MAX_RESULT_COUNT candidates
+			if(limit > 0 && limit <= MAX_RESULT_COUNT) {
+				m_CandidateLimit = limit;
+			}
+			else {
+				cerr << "Invalid candidate count preference: " << values[0] << "! Using " << m_CandidateLimit << "..." << endl;
+			}
+		}
+
+		if(values[1] == "meansig") {
+			m_CandidateMetric = MeanSignificanceMetric;
+		}
+	}
+	catch(ios_base::failure) {
+		cerr << "Error parsing candidate preferences! Using defaults..." << endl;
+	}
+}
@@ -22,8 +22,13 @@
 #define EINSTEINS5R3ADAPTER_H_
 
 #include <string>
+#include <vector>
 
 #include "BOINCClientAdapter.h"
+#include "XMLFieldScanner.h"
+#include "XMLProcessorFactory.h"
+#include "CheckpointWatcher.h"
+#include "BufferedFile.h"
 
 using namespace std;
 
@@ -41,6 +46,22 @@ using namespace std;
  * This adapter class can be used to query the \b Einstein\@Home S5R3 application
  * for informational data about the current work unit like search details and progress.
  *
+ * Checkpoint toplists of any size are supported: only the most significant candidates
+ * (at most \ref MAX_RESULT_COUNT) are kept. Their number and the significance metric
+ * used to rank them can be set in the project preferences:
+ *
+ \verbatim
+ <project_preferences>
+ 	<graphics ...>
+ 		<engine name="starsphere">
+ 			<candidates count="10000" metric="houghfstat" />
+ 		</engine>
+ 	</graphics>
+ </project_preferences>
+ \endverbatim
+ *
+ * Supported metrics are \c houghfstat (default) and \c meansig.
+ *
  * \author Oliver Bock\n
  * Max-Planck-Institute for Gravitational Physics\n
  * Hannover, Germany
@@ -60,7 +81,18 @@ class EinsteinS5R3Adapter
 {
 public:
 
+	/// Maximum number of candidates provided (checkpoints may contain more)
 	static const long MAX_RESULT_COUNT;
+
+	/**
+	 * \brief Defined significance metrics used to select the candidates to be displayed
+	 *
+	 * \see readCandidatePreferences
+	 */
+	enum CandidateMetric {
+		HoughFStatMetric,
+		MeanSignificanceMetric
+	};
 	/**
 	 * \brief Constructor
 	 *
@@ -117,6 +149,19 @@ public:
     	 */
     	long copyCandidates(float res[][3], long n) const;	
 
+	/**
+	 * \brief Retrieves the revision of the candidates
+	 *
+	 * The revision is incremented whenever the candidates change (new checkpoint loaded
+	 * or candidates invalidated). Compare it to the revision seen last in order to copy
+	 * them only when necessary.
+	 *
+	 * \return The revision of the candidates
+	 *
+	 * \see copyCandidates
+	 */
+	unsigned int candidateRevision() const;
+
     	/// The identifier of the Einstein\@Home science application's shared memory area
     	static const string SharedMemoryIdentifier;
 
@@ -129,6 +174,7 @@ private:
 	 * which is handled by the parent generic BOINC client adapter.
 	 *
 	 * \see boincClient
+	 * \see GRAPHICS_INFO_FIELDS
 	 */
 	void parseApplicationInformation();
 
@@ -137,18 +183,101 @@ private:
 	 *
 	 * the candidates are stored in a private member buffer
 	 * 
+	 * \return 0 on success, negative values on errors (see read_hfs_checkpoint())
 	 *
+	 * \see m_CheckpointWatcher
 	 */
 
-	void loadCheckpointFile();
+	int loadCheckpointFile();
 
 
 
+	/**
+	 * \brief Reads the candidates of the given checkpoint file
+	 *
+	 * The file is read chunk by chunk via \ref m_CheckpointFile rather than mapped into
+	 * memory since the science application might rewrite (truncate) it in place. It is
+	 * retried until it didn't change while reading it (at most
+	 * \ref MAX_CHECKPOINT_READ_ATTEMPTS times).
+	 *
+	 * \param filename The name of the checkpoint file
+	 * \param counter The checkpoint counter (output, 0 if the checkpoint couldn't be read)
+	 *
+	 * \return 0 on success, -1 on read errors, -2 on invalid data
+	 */
 	int read_hfs_checkpoint(const char*filename, UINT4*counter);
 
+	/**
+	 * \brief Validates checkpoint data and decodes its candidates
+	 *
+	 * The checkpoint is read in two passes of fixed-size chunks: the first one verifies
+	 * the checksum and selects the candidates, the second one decodes the selected ones.
+	 * Hence the memory required doesn't depend on the size of the toplist.
+	 *
+	 * \param checkpoint The opened checkpoint file
+	 * \param filename The name of the checkpoint file (for error messages)
+	 * \param counter The checkpoint counter (output)
+	 *
+	 * \return 0 on success, -1 on read errors, -2 on invalid data
+	 */
+	int decode_hfs_checkpoint(BufferedFile &checkpoint, const char*filename, UINT4*counter);
+
+	/**
+	 * \brief Selects the most significant candidates of a chunk of toplist entries
+	 *
+	 * The toplist entries are streamed through a min-heap (\ref m_CandidateRanks) which
+	 * keeps the \ref m_CandidateLimit most significant ones of all chunks seen since it
+	 * was cleared (with respect to \ref m_CandidateMetric).
+	 *
+	 * \param entries Pointer to the (unaligned) toplist entries
+	 * \param first Toplist position of the first entry
+	 * \param count Number of toplist entries
+	 */
+	void select_hfs_candidates(const char*entries, UINT4 first, UINT4 count);
+
+	/**
+	 * \brief Reads the candidate selection settings from the project preferences
+	 *
+	 * This is done again whenever the project preferences change.
+	 *
+	 * \see m_CandidateLimit
+	 * \see m_CandidateMetric
+	 */
+	void readCandidatePreferences();
+
+	/// Significance and toplist position of a candidate (used for selection)
+	struct CandidateRank {
+		/// The candidate's significance (ranking metric)
+		double significance;
+
+		/// The candidate's position in the toplist
+		UINT4 index;
+	};
+
+	/// Min-heap ordering of candidates (the least significant one is on top)
+	static bool more_significant(const CandidateRank &a, const CandidateRank &b);
+
+	/// Toplist ordering of candidates (keeps the display stable between checkpoints)
+	static bool toplist_order(const CandidateRank &a, const CandidateRank &b);
+
+	/// Maximum number of attempts to read a consistent checkpoint
+	static const int MAX_CHECKPOINT_READ_ATTEMPTS;
+
+	/// Fields of the \c graphics_info shared memory data
+	static const XMLFieldScanner<EinsteinS5R3Adapter>::Field GRAPHICS_INFO_FIELDS[];
+
+	/// Number of fields of the \c graphics_info shared memory data
+	static const int GRAPHICS_INFO_FIELD_COUNT;
+
 	/// Pointer to the (parent) BOINC client adapter
 	BOINCClientAdapter *boincClient;
 
+	/// Revision of the application information parsed last
+	unsigned int m_ApplicationInformationRevision;
+
+	/// Scanner for the \c graphics_info shared memory data
+	XMLFieldScanner<EinsteinS5R3Adapter> m_InformationScanner;
+
 	/// Right ascension of the currently searched sky position (in degrees)
 	double m_WUSkyPosRightAscension;
 
@@ -167,14 +296,35 @@ private:
 	/// candidates from checkpoint file
 	EinsteinS5R3Result * m_results ;
 
-	/// Amount of CPU time consumed for the work unit at the time of last checkpoint reading
-	double m_last_WUCPUTime;
+	/// Revision of the candidates (see candidateRevision())
+	unsigned int m_CandidateRevision;
+
+	/// Watcher reporting new checkpoints written by the science application
+	CheckpointWatcher m_CheckpointWatcher;
+
+	/// Checkpoint file reader (its chunk buffer is reused for every checkpoint)
+	BufferedFile m_CheckpointFile;
+
+	/// Indicator for a checkpoint that couldn't be loaded yet (retried on next refresh)
+	bool m_CheckpointPending;
+
+	/// Revision of the work unit information seen last
+	unsigned int m_WorkUnitRevision;
+
+	/// Revision of the project preferences the candidate preferences were read from
+	unsigned int m_ProjectPreferencesRevision;
+
+	/// XML processor used to read the candidate preferences (caches its XPath expressions)
+	XMLProcessorInterface *m_PreferencesReader;
+
+	/// Maximum number of candidates to be kept (at most \ref MAX_RESULT_COUNT)
+	long m_CandidateLimit;
 
-	/// Right ascension at the time of last checkpoint reading (in degrees)
-	double m_last_RA;
+	/// Significance metric used to select the candidates to be kept
+	CandidateMetric m_CandidateMetric;
 
-	/// Declination at the time of last checkpoint reading (in degrees)
-	double m_last_dec;
+	/// Selection heap (fixed capacity, reused for every checkpoint)
+	vector<CandidateRank> m_CandidateRanks;
 };
 
 
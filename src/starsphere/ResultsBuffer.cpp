@@ -0,0 +1,311 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "ResultsBuffer.h"
+
+ResultsBuffer::ResultsBuffer(const int capacity)
+{
+	m_Capacity = capacity > 0 ? capacity : 0;
+	m_Count = 0;
+
+	m_RA.resize(m_Capacity);
+	m_DE.resize(m_Capacity);
+	m_Significance.resize(m_Capacity);
+	m_UnitRadius.assign(m_Capacity, 1.0);
+	for(int i = 0; i < 3; ++i) {
+		m_Direction[i].resize(m_Capacity);
+	}
+	m_Positions.resize(3 * m_Capacity);
+	m_Colors.resize(3 * m_Capacity);
+
+	m_ColorMap = 0;
+	m_ColorMapSize = 0;
+	m_DefaultMinimum = 0.0;
+	m_DefaultMaximum = 1.0;
+	m_Minimum = m_DefaultMinimum;
+	m_Maximum = m_DefaultMaximum;
+	m_AppliedMinimum = m_Minimum;
+	m_AppliedMaximum = m_Maximum;
+	m_Radius = 1.0;
+	m_PointSize = 1.0;
+	m_DirtyFirst = 0;
+	m_DirtyLast = 0;
+
+	m_Resolved = false;
+	m_VertexBuffer = 0;
+}
+
+ResultsBuffer::~ResultsBuffer()
+{
+	// note: we can't release the buffer object here as the GL context might be gone already
+}
+
+void ResultsBuffer::setColorMap(const float colorMap[][3], const int size)
+{
+	if(colorMap == m_ColorMap && size == m_ColorMapSize) return;
+
+	m_ColorMap = colorMap;
+	m_ColorMapSize = size;
+
+	recolor(0, m_Count);
+	markDirty(0, m_Count);
+}
+
+void ResultsBuffer::setRangeDefaults(const float minimum, const float maximum)
+{
+	if(minimum == m_DefaultMinimum && maximum == m_DefaultMaximum) return;
+
+	m_DefaultMinimum = minimum;
+	m_DefaultMaximum = maximum;
+
+	rescanRange();
+	applyRange(0, 0);
+}
+
+void ResultsBuffer::setRadius(const GLfloat radius)
+{
+	if(radius == m_Radius) return;
+
+	m_Radius = radius;
+
+	recolor(0, m_Count);
+	markDirty(0, m_Count);
+}
+
+void ResultsBuffer::setPointSize(const GLfloat size)
+{
+	m_PointSize = size;
+}
+
+void ResultsBuffer::update(const float results[][3], const int count)
+{
+	const int newCount = count < 0 ? 0 : (count > m_Capacity ? m_Capacity : count);
+	const int common = newCount < m_Count ? newCount : m_Count;
+	int first = newCount;
+	int last = 0;
+	bool rescan = false;
+
+	// find changed candidates (replacing a range defining one requires a rescan)
+	for(int i = 0; i < common; ++i) {
+		if(results[i][0] != m_RA[i] || results[i][1] != m_DE[i] || results[i][2] != m_Significance[i]) {
+			if(m_Significance[i] == m_Minimum || m_Significance[i] == m_Maximum) rescan = true;
+
+			m_RA[i] = results[i][0];
+			m_DE[i] = results[i][1];
+			m_Significance[i] = results[i][2];
+
+			if(i < first) first = i;
+			last = i + 1;
+		}
+	}
+
+	// removed candidates
+	for(int i = newCount; i < m_Count; ++i) {
+		if(m_Significance[i] == m_Minimum || m_Significance[i] == m_Maximum) rescan = true;
+	}
+
+	// new candidates
+	for(int i = m_Count; i < newCount; ++i) {
+		m_RA[i] = results[i][0];
+		m_DE[i] = results[i][1];
+		m_Significance[i] = results[i][2];
+
+		if(i < first) first = i;
+		last = i + 1;
+	}
+
+	m_Count = newCount;
+
+	if(first < last) {
+		// directions of changed candidates (batch conversion)
+		SkyProjection::toCartesian(&m_RA[first], &m_DE[first], &m_UnitRadius[first],
+								   &m_Direction[0][first], &m_Direction[1][first], &m_Direction[2][first],
+								   last - first);
+	}
+
+	// update significance range
+	if(rescan) {
+		rescanRange();
+	}
+	else {
+		for(int i = first; i < last; ++i) {
+			if(m_Significance[i] < m_Minimum) m_Minimum = m_Significance[i];
+			if(m_Significance[i] > m_Maximum) m_Maximum = m_Significance[i];
+		}
+	}
+
+	applyRange(first, last);
+}
+
+void ResultsBuffer::rescanRange()
+{
+	m_Minimum = m_DefaultMinimum;
+	m_Maximum = m_DefaultMaximum;
+
+	for(int i = 0; i < m_Count; ++i) {
+		if(m_Significance[i] < m_Minimum) m_Minimum = m_Significance[i];
+		if(m_Significance[i] > m_Maximum) m_Maximum = m_Significance[i];
+	}
+}
+
+void ResultsBuffer::applyRange(const int first, const int last)
+{
+	float minimum = m_Minimum;
+	float maximum = m_Maximum;
+	if(minimum == maximum) minimum = maximum - 1.0;
+
+	if(minimum != m_AppliedMinimum || maximum != m_AppliedMaximum) {
+		// range changed: all candidates have to be rescaled/recolored
+		m_AppliedMinimum = minimum;
+		m_AppliedMaximum = maximum;
+		recolor(0, m_Count);
+		markDirty(0, m_Count);
+	}
+	else if(first < last) {
+		recolor(first, last);
+		markDirty(first, last);
+	}
+}
+
+void ResultsBuffer::recolor(const int first, const int last)
+{
+	if(first >= last) return;
+
+	const float minimum = m_AppliedMinimum;
+	const float range = m_AppliedMaximum - m_AppliedMinimum;
+	const float radius = m_Radius;
+
+	const GLfloat *significance = &m_Significance[0];
+	const GLfloat *x = &m_Direction[0][0];
+	const GLfloat *y = &m_Direction[1][0];
+	const GLfloat *z = &m_Direction[2][0];
+	GLfloat *position = &m_Positions[0];
+
+	// positions: distance to origin given by normalized significance (branch-free, vectorizable)
+	for(int i = first; i < last; ++i) {
+		const GLfloat distance = (significance[i] - minimum) / range * radius;
+		position[3 * i] = x[i] * distance;
+		position[3 * i + 1] = y[i] * distance;
+		position[3 * i + 2] = z[i] * distance;
+	}
+
+	if(!m_ColorMap || m_ColorMapSize <= 0) return;
+
+	// colors: color map lookup (most significant candidates use the first color)
+	const int maxBin = m_ColorMapSize - 1;
+	GLfloat *color = &m_Colors[0];
+
+	for(int i = first; i < last; ++i) {
+		const float norm = (significance[i] - minimum) / range;
+		int bin = (int) (maxBin * (1.0 - norm));
+
+		if(bin < 0) bin = 0;
+		if(bin > maxBin) bin = maxBin;
+
+		color[3 * i] = m_ColorMap[bin][0];
+		color[3 * i + 1] = m_ColorMap[bin][1];
+		color[3 * i + 2] = m_ColorMap[bin][2];
+	}
+}
+
+void ResultsBuffer::markDirty(const int first, const int last)
+{
+	if(first >= last) return;
+
+	if(m_DirtyFirst >= m_DirtyLast) {
+		m_DirtyFirst = first;
+		m_DirtyLast = last;
+	}
+	else {
+		if(first < m_DirtyFirst) m_DirtyFirst = first;
+		if(last > m_DirtyLast) m_DirtyLast = last;
+	}
+}
+
+void ResultsBuffer::upload()
+{
+	// set up OpenGL objects once per context (see release())
+	if(!m_Resolved) {
+		if(m_Buffers.resolve()) {
+			// positions and colors are stored in two consecutive blocks of fixed size
+			m_Buffers.genBuffers(1, &m_VertexBuffer);
+			m_Buffers.bindBuffer(GL_ARRAY_BUFFER, m_VertexBuffer);
+			m_Buffers.bufferData(GL_ARRAY_BUFFER, 6 * m_Capacity * sizeof(GLfloat), 0, GL_DYNAMIC_DRAW);
+			m_Buffers.bindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+		else {
+			cerr << "Vertex buffer objects not supported! Using client-side vertex arrays..." << endl;
+		}
+
+		m_Resolved = true;
+		markDirty(0, m_Count);
+	}
+
+	if(m_VertexBuffer && m_DirtyFirst < m_DirtyLast) {
+		const GLsizeiptr offset = 3 * m_DirtyFirst * sizeof(GLfloat);
+		const GLsizeiptr size = 3 * (m_DirtyLast - m_DirtyFirst) * sizeof(GLfloat);
+
+		m_Buffers.bindBuffer(GL_ARRAY_BUFFER, m_VertexBuffer);
+		m_Buffers.bufferSubData(GL_ARRAY_BUFFER, offset, size, &m_Positions[3 * m_DirtyFirst]);
+		m_Buffers.bufferSubData(GL_ARRAY_BUFFER, 3 * m_Capacity * sizeof(GLfloat) + offset, size, &m_Colors[3 * m_DirtyFirst]);
+		m_Buffers.bindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	m_DirtyFirst = 0;
+	m_DirtyLast = 0;
+}
+
+void ResultsBuffer::render() const
+{
+	if(m_Count == 0) return;
+
+	// source vertex data from buffer object (offsets) or client memory (pointers)
+	const GLvoid *positions = &m_Positions[0];
+	const GLvoid *colors = &m_Colors[0];
+	if(m_VertexBuffer) {
+		m_Buffers.bindBuffer(GL_ARRAY_BUFFER, m_VertexBuffer);
+		positions = 0;
+		colors = (const GLubyte*) 0 + 3 * m_Capacity * sizeof(GLfloat);
+	}
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glEnableClientState(GL_COLOR_ARRAY);
+	glVertexPointer(3, GL_FLOAT, 0, positions);
+	glColorPointer(3, GL_FLOAT, 0, colors);
+
+	glPointSize(m_PointSize);
+	glDrawArrays(GL_POINTS, 0, m_Count);
+
+	glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+
+	// make sure we don't interfere with other (client-side) vertex arrays
+	if(m_VertexBuffer) m_Buffers.bindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void ResultsBuffer::release()
+{
+	if(m_VertexBuffer) {
+		m_Buffers.deleteBuffers(1, &m_VertexBuffer);
+	}
+	m_VertexBuffer = 0;
+
+	m_Resolved = false;
+}
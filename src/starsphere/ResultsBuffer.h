@@ -0,0 +1,250 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef RESULTSBUFFER_H_
+#define RESULTSBUFFER_H_
+
+#include <iostream>
+#include <vector>
+
+#include <SDL.h>
+#include <SDL_opengl.h>
+
+#include "SkyProjection.h"
+#include "BufferFunctions.h"
+
+using namespace std;
+
+/**
+ * \addtogroup starsphere Starsphere
+ * @{
+ */
+
+/**
+ * \brief Incrementally updated vertex buffer for result candidates
+ *
+ * This class maintains the point markers of the result candidates (right ascension,
+ * declination and significance). Each candidate is drawn at its sky position, its
+ * distance to the origin and its color (see setColorMap()) are given by its significance
+ * normalized to the current significance range.
+ *
+ * Calling update() with a new set of candidates compares it to the current set and
+ * only processes the candidates that actually changed (or were added). The significance
+ * range is tracked incrementally (it only has to be rescanned if a candidate defining it
+ * was replaced). Only if the range changes are all candidates rescaled and recolored, in
+ * one tight loop over contiguous arrays. The resulting positions and colors are kept in
+ * one OpenGL vertex buffer object (VBO) of fixed capacity and upload() only transfers
+ * the changed range of candidates via glBufferSubData(). Thus refreshing an unchanged
+ * (or slightly changed) set of candidates is cheap enough to be done at any time.
+ *
+ * Note: without vertex buffer object support (OpenGL 1.5 or GL_ARB_vertex_buffer_object)
+ * the candidates are rendered from client-side vertex arrays.
+ *
+ * \author Oliver Bock\n
+ * Max-Planck-Institute for Gravitational Physics\n
+ * Hannover, Germany
+ */
+class ResultsBuffer
+{
+public:
+	/**
+	 * \brief Constructor
+	 *
+	 * \param capacity The maximum number of candidates
+	 */
+	ResultsBuffer(const int capacity);
+
+	/// Destructor
+	virtual ~ResultsBuffer();
+
+	/**
+	 * \brief Sets the color map used to color the candidates
+	 *
+	 * The most significant candidates get the first color, the least significant ones
+	 * get the last color of the map.
+	 *
+	 * \param colorMap The color map (RGB), has to stay valid as long as it's in use
+	 * \param size The number of colors of the map
+	 */
+	void setColorMap(const float colorMap[][3], const int size);
+
+	/**
+	 * \brief Sets the default significance range
+	 *
+	 * The actual range always includes this range and is extended by the candidates'
+	 * significance as necessary.
+	 *
+	 * \param minimum The default minimum significance
+	 * \param maximum The default maximum significance
+	 */
+	void setRangeDefaults(const float minimum, const float maximum);
+
+	/**
+	 * \brief Sets the radius of the sky sphere
+	 *
+	 * \param radius The radius of the sky sphere (candidates of maximum significance)
+	 */
+	void setRadius(const GLfloat radius);
+
+	/**
+	 * \brief Sets the point size used to render the candidates
+	 *
+	 * \param size The point size in pixels
+	 */
+	void setPointSize(const GLfloat size);
+
+	/**
+	 * \brief Updates the candidates
+	 *
+	 * Only the candidates that changed since the last call are processed.
+	 *
+	 * \param results The candidates (right ascension, declination, significance)
+	 * \param count The number of candidates (limited to the capacity of the buffer)
+	 */
+	void update(const float results[][3], const int count);
+
+	/**
+	 * \brief Transfers the changed candidates into the OpenGL vertex buffer object
+	 *
+	 * This method requires a valid OpenGL context. The buffer object is created by the
+	 * first call (after release()) which transfers all candidates.
+	 */
+	void upload();
+
+	/// Renders all candidates
+	void render() const;
+
+	/**
+	 * \brief Releases the OpenGL buffer object
+	 *
+	 * This method has to be called whenever the OpenGL context got (or is about to be)
+	 * recreated, in which case the next call to upload() creates a new one.
+	 */
+	void release();
+
+private:
+	/**
+	 * \brief Marks a range of candidates as changed
+	 *
+	 * \param first The index of the first changed candidate
+	 * \param last The index following the last changed candidate
+	 */
+	void markDirty(const int first, const int last);
+
+	/// Determines the significance range from scratch
+	void rescanRange();
+
+	/**
+	 * \brief Applies the current significance range
+	 *
+	 * If the range changed all candidates are rescaled and recolored,
+	 * otherwise only the given range of candidates.
+	 *
+	 * \param first The index of the first changed candidate
+	 * \param last The index following the last changed candidate
+	 */
+	void applyRange(const int first, const int last);
+
+	/**
+	 * \brief Computes positions and colors of a range of candidates
+	 *
+	 * \param first The index of the first candidate
+	 * \param last The index following the last candidate
+	 */
+	void recolor(const int first, const int last);
+
+	/// Maximum number of candidates
+	int m_Capacity;
+
+	/// Current number of candidates
+	int m_Count;
+
+	/// Candidate right ascensions
+	vector<GLfloat> m_RA;
+
+	/// Candidate declinations
+	vector<GLfloat> m_DE;
+
+	/// Candidate significances
+	vector<GLfloat> m_Significance;
+
+	/// Unit radii (used to compute the candidate directions)
+	vector<GLfloat> m_UnitRadius;
+
+	/// Candidate directions (unit vectors: x, y, z)
+	vector<GLfloat> m_Direction[3];
+
+	/// Candidate positions (interleaved x, y, z, first block of the buffer object)
+	vector<GLfloat> m_Positions;
+
+	/// Candidate colors (interleaved r, g, b, second block of the buffer object)
+	vector<GLfloat> m_Colors;
+
+	/// Color map (RGB)
+	const float (*m_ColorMap)[3];
+
+	/// Number of colors in m_ColorMap
+	int m_ColorMapSize;
+
+	/// Default minimum significance
+	float m_DefaultMinimum;
+
+	/// Default maximum significance
+	float m_DefaultMaximum;
+
+	/// Current minimum significance
+	float m_Minimum;
+
+	/// Current maximum significance
+	float m_Maximum;
+
+	/// Significance range used for the current positions and colors (minimum)
+	float m_AppliedMinimum;
+
+	/// Significance range used for the current positions and colors (maximum)
+	float m_AppliedMaximum;
+
+	/// Radius of the sky sphere
+	GLfloat m_Radius;
+
+	/// Point size
+	GLfloat m_PointSize;
+
+	/// Index of the first candidate not yet transferred into the buffer object
+	int m_DirtyFirst;
+
+	/// Index following the last candidate not yet transferred into the buffer object
+	int m_DirtyLast;
+
+	/// Indicates whether the OpenGL objects/entry points have been set up for the current context
+	bool m_Resolved;
+
+	/// ID of the OpenGL vertex buffer object (0 if not in use)
+	GLuint m_VertexBuffer;
+
+	/// Entry points of the buffer object functions (only valid if m_VertexBuffer != 0)
+	BufferFunctions m_Buffers;
+};
+
+/**
+ * @}
+ */
+
+#endif /*RESULTSBUFFER_H_*/
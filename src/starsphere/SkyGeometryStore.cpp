@@ -0,0 +1,414 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "SkyGeometryStore.h"
+
+#include <cstring>
+#include <cstddef>
+#include <algorithm>
+
+/// Vertex shader: fixed function transformation plus per-vertex point size
+static const GLchar *c_PointVertexShader =
+	"attribute float pointSize;\n"
+	"void main()\n"
+	"{\n"
+	"	vec4 eye = gl_ModelViewMatrix * gl_Vertex;\n"
+	"	gl_Position = gl_ProjectionMatrix * eye;\n"
+	"	gl_FrontColor = gl_Color;\n"
+	"	gl_FogFragCoord = abs(eye.z);\n"
+	"	gl_PointSize = pointSize;\n"
+	"}\n";
+
+/// Fragment shader: fixed function fog (0: off, 1: linear, 2: exp, 3: exp2)
+static const GLchar *c_PointFragmentShader =
+	"uniform int fogMode;\n"
+	"void main()\n"
+	"{\n"
+	"	float fog = 1.0;\n"
+	"	float z = gl_FogFragCoord;\n"
+	"	if(fogMode == 1) fog = (gl_Fog.end - z) * gl_Fog.scale;\n"
+	"	else if(fogMode == 2) fog = exp(-gl_Fog.density * z);\n"
+	"	else if(fogMode == 3) fog = exp(-gl_Fog.density * gl_Fog.density * z * z);\n"
+	"	fog = clamp(fog, 0.0, 1.0);\n"
+	"	gl_FragColor = vec4(mix(gl_Fog.color.rgb, gl_Color.rgb, fog), gl_Color.a);\n"
+	"}\n";
+
+SkyGeometryStore::SkyGeometryStore()
+{
+	m_CurrentLayer = -1;
+	m_CurrentColor[0] = 1.0;
+	m_CurrentColor[1] = 1.0;
+	m_CurrentColor[2] = 1.0;
+	m_CurrentSize = 1.0;
+
+	m_Resolved = false;
+	m_VertexBuffer = 0;
+
+	memset(&m_gl, 0, sizeof(m_gl));
+	m_PointProgram = 0;
+	m_PointSizeAttribute = -1;
+	m_FogModeUniform = -1;
+}
+
+SkyGeometryStore::~SkyGeometryStore()
+{
+	// note: we can't release the buffer object here as the GL context might be gone already
+}
+
+void SkyGeometryStore::clear()
+{
+	m_Vertices.clear();
+	m_Layers.clear();
+	m_PendingRA.clear();
+	m_PendingDE.clear();
+	m_PendingRadius.clear();
+	m_PendingIndex.clear();
+	m_CurrentLayer = -1;
+}
+
+bool SkyGeometryStore::empty() const
+{
+	return m_Layers.empty() && m_CurrentLayer == -1;
+}
+
+void SkyGeometryStore::beginLayer(const int layer, const GLenum mode, const GLfloat size)
+{
+	if(m_CurrentLayer != -1) {
+		cerr << "Geometry layer " << m_CurrentLayer << " still open! Closing it now..." << endl;
+		endLayer();
+	}
+
+	Layer range;
+	range.mode = mode;
+	range.first = m_Vertices.size();
+	range.count = 0;
+	range.size = size;
+
+	m_Layers[layer] = range;
+	m_CurrentLayer = layer;
+	m_CurrentSize = size;
+}
+
+void SkyGeometryStore::color(const GLfloat red, const GLfloat green, const GLfloat blue)
+{
+	m_CurrentColor[0] = red;
+	m_CurrentColor[1] = green;
+	m_CurrentColor[2] = blue;
+}
+
+void SkyGeometryStore::pointSize(const GLfloat size)
+{
+	m_CurrentSize = size;
+}
+
+void SkyGeometryStore::vertex(const GLfloat x, const GLfloat y, const GLfloat z)
+{
+	if(m_CurrentLayer == -1) {
+		cerr << "No geometry layer open! Vertex ignored..." << endl;
+		return;
+	}
+
+	Vertex vertex;
+	vertex.position[0] = x;
+	vertex.position[1] = y;
+	vertex.position[2] = z;
+	vertex.color[0] = m_CurrentColor[0];
+	vertex.color[1] = m_CurrentColor[1];
+	vertex.color[2] = m_CurrentColor[2];
+	vertex.size = m_CurrentSize;
+
+	m_Vertices.push_back(vertex);
+}
+
+void SkyGeometryStore::sphVertex(const GLfloat RAdeg, const GLfloat DEdeg, const GLfloat radius)
+{
+	if(m_CurrentLayer == -1) {
+		cerr << "No geometry layer open! Vertex ignored..." << endl;
+		return;
+	}
+
+	// add vertex now (color/size), its position is set by convertPending()
+	m_PendingIndex.push_back(m_Vertices.size());
+	m_PendingRA.push_back(RAdeg);
+	m_PendingDE.push_back(DEdeg);
+	m_PendingRadius.push_back(radius);
+	vertex(0.0, 0.0, 0.0);
+}
+
+void SkyGeometryStore::convertPending()
+{
+	const size_t count = m_PendingIndex.size();
+	if(count == 0) return;
+
+	for(int i = 0; i < 3; ++i) {
+		m_Converted[i].resize(count);
+	}
+
+	SkyProjection::toCartesian(&m_PendingRA[0], &m_PendingDE[0], &m_PendingRadius[0],
+							   &m_Converted[0][0], &m_Converted[1][0], &m_Converted[2][0], count);
+
+	for(size_t i = 0; i < count; ++i) {
+		GLfloat *position = m_Vertices[m_PendingIndex[i]].position;
+		position[0] = m_Converted[0][i];
+		position[1] = m_Converted[1][i];
+		position[2] = m_Converted[2][i];
+	}
+
+	m_PendingRA.clear();
+	m_PendingDE.clear();
+	m_PendingRadius.clear();
+	m_PendingIndex.clear();
+}
+
+void SkyGeometryStore::endLayer()
+{
+	if(m_CurrentLayer == -1) return;
+
+	convertPending();
+
+	Layer &range = m_Layers[m_CurrentLayer];
+	range.count = m_Vertices.size() - range.first;
+
+	if(range.mode == GL_POINTS) {
+		createBatches(range);
+	}
+	else {
+		Batch batch;
+		batch.first = range.first;
+		batch.count = range.count;
+		batch.size = range.size;
+		range.batches.assign(1, batch);
+	}
+
+	m_CurrentLayer = -1;
+}
+
+bool SkyGeometryStore::lessPointSize(const Vertex &a, const Vertex &b)
+{
+	return a.size < b.size;
+}
+
+void SkyGeometryStore::createBatches(Layer &range)
+{
+	range.batches.clear();
+	if(range.count == 0) return;
+
+	// the drawing order of points doesn't matter, so group them by size
+	vector<Vertex>::iterator begin = m_Vertices.begin() + range.first;
+	stable_sort(begin, begin + range.count, lessPointSize);
+
+	Batch batch;
+	batch.first = range.first;
+	batch.count = 0;
+	batch.size = m_Vertices[range.first].size;
+
+	for(GLint i = range.first; i < range.first + range.count; ++i) {
+		if(m_Vertices[i].size != batch.size) {
+			range.batches.push_back(batch);
+			batch.first = i;
+			batch.count = 0;
+			batch.size = m_Vertices[i].size;
+		}
+		batch.count++;
+	}
+	range.batches.push_back(batch);
+}
+
+bool SkyGeometryStore::createPointProgram()
+{
+	m_PointProgram = 0;
+
+	m_gl.createShader = (PFNGLCREATESHADERPROC) SDL_GL_GetProcAddress("glCreateShader");
+	m_gl.shaderSource = (PFNGLSHADERSOURCEPROC) SDL_GL_GetProcAddress("glShaderSource");
+	m_gl.compileShader = (PFNGLCOMPILESHADERPROC) SDL_GL_GetProcAddress("glCompileShader");
+	m_gl.attachShader = (PFNGLATTACHSHADERPROC) SDL_GL_GetProcAddress("glAttachShader");
+	m_gl.deleteShader = (PFNGLDELETESHADERPROC) SDL_GL_GetProcAddress("glDeleteShader");
+	m_gl.createProgram = (PFNGLCREATEPROGRAMPROC) SDL_GL_GetProcAddress("glCreateProgram");
+	m_gl.linkProgram = (PFNGLLINKPROGRAMPROC) SDL_GL_GetProcAddress("glLinkProgram");
+	m_gl.getProgramiv = (PFNGLGETPROGRAMIVPROC) SDL_GL_GetProcAddress("glGetProgramiv");
+	m_gl.getProgramInfoLog = (PFNGLGETPROGRAMINFOLOGPROC) SDL_GL_GetProcAddress("glGetProgramInfoLog");
+	m_gl.useProgram = (PFNGLUSEPROGRAMPROC) SDL_GL_GetProcAddress("glUseProgram");
+	m_gl.deleteProgram = (PFNGLDELETEPROGRAMPROC) SDL_GL_GetProcAddress("glDeleteProgram");
+	m_gl.getAttribLocation = (PFNGLGETATTRIBLOCATIONPROC) SDL_GL_GetProcAddress("glGetAttribLocation");
+	m_gl.getUniformLocation = (PFNGLGETUNIFORMLOCATIONPROC) SDL_GL_GetProcAddress("glGetUniformLocation");
+	m_gl.uniform1i = (PFNGLUNIFORM1IPROC) SDL_GL_GetProcAddress("glUniform1i");
+	m_gl.vertexAttribPointer = (PFNGLVERTEXATTRIBPOINTERPROC) SDL_GL_GetProcAddress("glVertexAttribPointer");
+	m_gl.enableVertexAttribArray = (PFNGLENABLEVERTEXATTRIBARRAYPROC) SDL_GL_GetProcAddress("glEnableVertexAttribArray");
+	m_gl.disableVertexAttribArray = (PFNGLDISABLEVERTEXATTRIBARRAYPROC) SDL_GL_GetProcAddress("glDisableVertexAttribArray");
+
+	// SDL might return stubs for unsupported functions, so check the version as well
+	const char *version = (const char*) glGetString(GL_VERSION);
+	if(!version || version[0] < '2') return false;
+
+	if(!m_gl.createShader || !m_gl.shaderSource || !m_gl.compileShader ||
+	   !m_gl.attachShader || !m_gl.deleteShader || !m_gl.createProgram ||
+	   !m_gl.linkProgram || !m_gl.getProgramiv || !m_gl.getProgramInfoLog ||
+	   !m_gl.useProgram || !m_gl.deleteProgram || !m_gl.getAttribLocation ||
+	   !m_gl.getUniformLocation || !m_gl.uniform1i || !m_gl.vertexAttribPointer ||
+	   !m_gl.enableVertexAttribArray || !m_gl.disableVertexAttribArray)
+	{
+		return false;
+	}
+
+	GLuint vertexShader = m_gl.createShader(GL_VERTEX_SHADER);
+	m_gl.shaderSource(vertexShader, 1, &c_PointVertexShader, 0);
+	m_gl.compileShader(vertexShader);
+
+	GLuint fragmentShader = m_gl.createShader(GL_FRAGMENT_SHADER);
+	m_gl.shaderSource(fragmentShader, 1, &c_PointFragmentShader, 0);
+	m_gl.compileShader(fragmentShader);
+
+	GLuint program = m_gl.createProgram();
+	m_gl.attachShader(program, vertexShader);
+	m_gl.attachShader(program, fragmentShader);
+	m_gl.linkProgram(program);
+
+	// shaders are kept alive by the program
+	m_gl.deleteShader(vertexShader);
+	m_gl.deleteShader(fragmentShader);
+
+	GLint status = GL_FALSE;
+	m_gl.getProgramiv(program, GL_LINK_STATUS, &status);
+	if(status != GL_TRUE) {
+		GLchar log[1024] = "";
+		m_gl.getProgramInfoLog(program, sizeof(log), 0, log);
+		cerr << "Could not build point size shader: " << log << endl;
+		m_gl.deleteProgram(program);
+		return false;
+	}
+
+	m_PointSizeAttribute = m_gl.getAttribLocation(program, "pointSize");
+	m_FogModeUniform = m_gl.getUniformLocation(program, "fogMode");
+	m_PointProgram = program;
+
+	return true;
+}
+
+void SkyGeometryStore::upload()
+{
+	if(m_CurrentLayer != -1) endLayer();
+
+	// set up OpenGL objects once per context (see release())
+	if(!m_Resolved) {
+		if(!createPointProgram()) {
+			cerr << "Point size shader not available! Using point size batches..." << endl;
+		}
+
+		if(m_Buffers.resolve()) {
+			m_Buffers.genBuffers(1, &m_VertexBuffer);
+		}
+		else {
+			cerr << "Vertex buffer objects not supported! Using client-side vertex arrays..." << endl;
+		}
+
+		m_Resolved = true;
+	}
+
+	if(!m_VertexBuffer) return;
+
+	m_Buffers.bindBuffer(GL_ARRAY_BUFFER, m_VertexBuffer);
+	m_Buffers.bufferData(GL_ARRAY_BUFFER,
+				   m_Vertices.size() * sizeof(Vertex),
+				   m_Vertices.empty() ? 0 : &m_Vertices[0],
+				   GL_STATIC_DRAW);
+	m_Buffers.bindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void SkyGeometryStore::render(const int layer, const bool vertexColors) const
+{
+	map<int, Layer>::const_iterator range = m_Layers.find(layer);
+	if(range == m_Layers.end() || range->second.count == 0) return;
+
+	// source vertex data from buffer object (offsets) or client memory (pointers)
+	const GLubyte *base = 0;
+	if(m_VertexBuffer) {
+		m_Buffers.bindBuffer(GL_ARRAY_BUFFER, m_VertexBuffer);
+	}
+	else {
+		base = (const GLubyte*) &m_Vertices[0];
+	}
+
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glVertexPointer(3, GL_FLOAT, sizeof(Vertex), base + offsetof(Vertex, position));
+
+	// without vertex colors the current color (glColor) applies
+	if(vertexColors) {
+		glEnableClientState(GL_COLOR_ARRAY);
+		glColorPointer(3, GL_FLOAT, sizeof(Vertex), base + offsetof(Vertex, color));
+	}
+
+	if(range->second.mode == GL_POINTS && m_PointProgram) {
+
+		// determine fixed function fog setup to be emulated by the shader
+		GLint fogMode = 0;
+		if(glIsEnabled(GL_FOG)) {
+			GLint mode;
+			glGetIntegerv(GL_FOG_MODE, &mode);
+			fogMode = mode == GL_LINEAR ? 1 : (mode == GL_EXP ? 2 : 3);
+		}
+
+		// all points (of any size) in one go
+		m_gl.useProgram(m_PointProgram);
+		m_gl.uniform1i(m_FogModeUniform, fogMode);
+		m_gl.enableVertexAttribArray(m_PointSizeAttribute);
+		m_gl.vertexAttribPointer(m_PointSizeAttribute, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex), base + offsetof(Vertex, size));
+		glEnable(GL_VERTEX_PROGRAM_POINT_SIZE);
+
+		glDrawArrays(GL_POINTS, range->second.first, range->second.count);
+
+		glDisable(GL_VERTEX_PROGRAM_POINT_SIZE);
+		m_gl.disableVertexAttribArray(m_PointSizeAttribute);
+		m_gl.useProgram(0);
+	}
+	else {
+		// one draw call per point size/line width
+		const vector<Batch> &batches = range->second.batches;
+		for(size_t i = 0; i < batches.size(); ++i) {
+			if(range->second.mode == GL_POINTS) {
+				glPointSize(batches[i].size);
+			}
+			else {
+				glLineWidth(batches[i].size);
+			}
+			glDrawArrays(range->second.mode, batches[i].first, batches[i].count);
+		}
+	}
+
+	if(vertexColors) glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+
+	// make sure we don't interfere with other (client-side) vertex arrays
+	if(m_VertexBuffer) m_Buffers.bindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void SkyGeometryStore::release()
+{
+	if(m_VertexBuffer) {
+		m_Buffers.deleteBuffers(1, &m_VertexBuffer);
+	}
+	m_VertexBuffer = 0;
+
+	if(m_PointProgram) {
+		m_gl.deleteProgram(m_PointProgram);
+	}
+	m_PointProgram = 0;
+
+	m_Resolved = false;
+}
@@ -0,0 +1,327 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef SKYGEOMETRYSTORE_H_
+#define SKYGEOMETRYSTORE_H_
+
+#include <iostream>
+#include <vector>
+#include <map>
+
+#include <SDL.h>
+#include <SDL_opengl.h>
+
+#include "SkyProjection.h"
+#include "BufferFunctions.h"
+
+using namespace std;
+
+/**
+ * \addtogroup starsphere Starsphere
+ * @{
+ */
+
+/**
+ * \brief Vertex buffer based storage for the static geometry of the celestial sphere
+ *
+ * This class collects the vertices of several independent geometry layers (e.g. stars,
+ * constellations, grid) in one interleaved vertex array (position, color and point size). Each
+ * layer is identified by an arbitrary integer (usually a Starsphere::Features flag) and
+ * occupies one contiguous range of that array. After all layers have been defined the
+ * array is uploaded into a single OpenGL vertex buffer object (VBO) and each layer can
+ * subsequently be rendered with just one call to glDrawArrays().
+ *
+ * The layers are defined in an immediate mode fashion:
+ * \code
+ * store.beginLayer(Starsphere::STARS, GL_POINTS, 4.0);
+ * store.color(1.0, 1.0, 1.0);
+ * store.vertex(x, y, z);
+ * store.sphVertex(RAdeg, DEdeg, radius);
+ * ...
+ * store.endLayer();
+ * \endcode
+ *
+ * Vertices given in sky sphere coordinates (see sphVertex()) are converted to cartesian
+ * coordinates in one batch per layer using SkyProjection.
+ *
+ * Point layers may contain markers of different sizes (see pointSize()). The size is
+ * stored per vertex and passed to a minimal GLSL program (OpenGL 2.0) which sets
+ * \c gl_PointSize accordingly, such that every point layer is still rendered by a single
+ * draw call without any point size state changes. Without GLSL support the points of
+ * each layer are sorted by size when the layer is finished and rendered with one draw
+ * call per distinct size.
+ *
+ * Note: vertex buffer objects require OpenGL 1.5 (or GL_ARB_vertex_buffer_object). If
+ * they're not available (e.g. old software renderers) the store transparently falls back
+ * to client-side vertex arrays (OpenGL 1.1), so it works on any GL implementation
+ * including Mesa's software rasterizers.
+ *
+ * \author Oliver Bock\n
+ * Max-Planck-Institute for Gravitational Physics\n
+ * Hannover, Germany
+ */
+class SkyGeometryStore
+{
+public:
+	/// Default contructor
+	SkyGeometryStore();
+
+	/// Destructor
+	virtual ~SkyGeometryStore();
+
+	/**
+	 * \brief Removes all layers and vertices
+	 *
+	 * Note: the OpenGL buffer object is kept until the next call to upload()
+	 * or release().
+	 */
+	void clear();
+
+	/**
+	 * \brief Checks whether any layers are defined
+	 *
+	 * \return TRUE if no layer has been defined since construction or the last clear()
+	 */
+	bool empty() const;
+
+	/**
+	 * \brief Starts the definition of a new geometry layer
+	 *
+	 * All subsequent calls to vertex() are added to this layer until endLayer() is called.
+	 * An existing layer with the same identifier is replaced.
+	 *
+	 * \param layer The identifier of the layer
+	 * \param mode The OpenGL primitive type used to render the layer (e.g. \c GL_POINTS, \c GL_LINES)
+	 * \param size The (initial) point size or line width used to render the layer
+	 */
+	void beginLayer(const int layer, const GLenum mode, const GLfloat size = 1.0);
+
+	/**
+	 * \brief Sets the color of all subsequently added vertices
+	 *
+	 * Use like glColor()
+	 *
+	 * \param red The red color component
+	 * \param green The green color component
+	 * \param blue The blue color component
+	 */
+	void color(const GLfloat red, const GLfloat green, const GLfloat blue);
+
+	/**
+	 * \brief Sets the point size of all subsequently added vertices
+	 *
+	 * Use like glPointSize() (only applies to \c GL_POINTS layers)
+	 *
+	 * \param size The point size in pixels
+	 */
+	void pointSize(const GLfloat size);
+
+	/**
+	 * \brief Adds a vertex to the current layer
+	 *
+	 * Use like glVertex()
+	 *
+	 * \param x The x-coordinate of the new vertex
+	 * \param y The y-coordinate of the new vertex
+	 * \param z The z-coordinate of the new vertex
+	 */
+	void vertex(const GLfloat x, const GLfloat y, const GLfloat z);
+
+	/**
+	 * \brief Adds a vertex in 3D sky sphere coordinates to the current layer
+	 *
+	 * Use like Starsphere::sphQueueVertex3D(). The conversion to cartesian coordinates
+	 * is deferred until the layer is finished (batch conversion).
+	 *
+	 * \param RAdeg The right ascension of the new vertex
+	 * \param DEdeg The declination of the new vertex
+	 * \param radius The radius of the sky sphere
+	 */
+	void sphVertex(const GLfloat RAdeg, const GLfloat DEdeg, const GLfloat radius);
+
+	/// Finishes the definition of the current layer
+	void endLayer();
+
+	/**
+	 * \brief Transfers all layers into the OpenGL vertex buffer object
+	 *
+	 * This method has to be called after all layers have been (re)defined and before
+	 * any of them is rendered. It requires a valid OpenGL context. The required OpenGL
+	 * objects are created by the first call and reused afterwards.
+	 */
+	void upload();
+
+	/**
+	 * \brief Renders a single layer
+	 *
+	 * \param layer The identifier of the layer to be rendered (unknown layers are ignored)
+	 * \param vertexColors Use the stored vertex colors (TRUE) or the current OpenGL color (FALSE)
+	 */
+	void render(const int layer, const bool vertexColors = true) const;
+
+	/**
+	 * \brief Releases the OpenGL buffer and program objects
+	 *
+	 * This method has to be called whenever the OpenGL context got (or is about to be)
+	 * recreated, in which case the next call to upload() creates new objects.
+	 */
+	void release();
+
+private:
+	/// Interleaved vertex data layout
+	struct Vertex {
+		/// Vertex position (x, y, z)
+		GLfloat position[3];
+
+		/// Vertex color (r, g, b)
+		GLfloat color[3];
+
+		/// Point size (in pixels)
+		GLfloat size;
+	};
+
+	/// Draw range of vertices sharing the same point size/line width
+	struct Batch {
+		/// Index of the first vertex of this batch
+		GLint first;
+
+		/// Number of vertices of this batch
+		GLsizei count;
+
+		/// Point size or line width
+		GLfloat size;
+	};
+
+	/// Draw range and render state of a single layer
+	struct Layer {
+		/// OpenGL primitive type
+		GLenum mode;
+
+		/// Index of the first vertex of this layer
+		GLint first;
+
+		/// Number of vertices of this layer
+		GLsizei count;
+
+		/// Point size or line width
+		GLfloat size;
+
+		/// Draw ranges by point size (used when there's no point size shader available)
+		vector<Batch> batches;
+	};
+
+	/// OpenGL 2.0 entry points required to build and use the point size shader
+	struct ShaderFunctions {
+		PFNGLCREATESHADERPROC createShader;
+		PFNGLSHADERSOURCEPROC shaderSource;
+		PFNGLCOMPILESHADERPROC compileShader;
+		PFNGLATTACHSHADERPROC attachShader;
+		PFNGLDELETESHADERPROC deleteShader;
+		PFNGLCREATEPROGRAMPROC createProgram;
+		PFNGLLINKPROGRAMPROC linkProgram;
+		PFNGLGETPROGRAMIVPROC getProgramiv;
+		PFNGLGETPROGRAMINFOLOGPROC getProgramInfoLog;
+		PFNGLUSEPROGRAMPROC useProgram;
+		PFNGLDELETEPROGRAMPROC deleteProgram;
+		PFNGLGETATTRIBLOCATIONPROC getAttribLocation;
+		PFNGLGETUNIFORMLOCATIONPROC getUniformLocation;
+		PFNGLUNIFORM1IPROC uniform1i;
+		PFNGLVERTEXATTRIBPOINTERPROC vertexAttribPointer;
+		PFNGLENABLEVERTEXATTRIBARRAYPROC enableVertexAttribArray;
+		PFNGLDISABLEVERTEXATTRIBARRAYPROC disableVertexAttribArray;
+	};
+
+	/// Converts all pending sky sphere coordinates of the current layer (batch)
+	void convertPending();
+
+	/// Sort predicate for point vertices (ascending size)
+	static bool lessPointSize(const Vertex &a, const Vertex &b);
+
+	/**
+	 * \brief Sorts the vertices of a point layer by size and creates its draw batches
+	 *
+	 * \param range The layer to be processed
+	 */
+	void createBatches(Layer &range);
+
+	/**
+	 * \brief Builds the GLSL program used to render point layers with per-vertex sizes
+	 *
+	 * \return TRUE if the program could be built, otherwise FALSE
+	 */
+	bool createPointProgram();
+
+	/// Vertex array (client-side copy)
+	vector<Vertex> m_Vertices;
+
+	/// Sky sphere coordinates of the current layer awaiting conversion (right ascension)
+	vector<GLfloat> m_PendingRA;
+
+	/// Sky sphere coordinates of the current layer awaiting conversion (declination)
+	vector<GLfloat> m_PendingDE;
+
+	/// Sky sphere coordinates of the current layer awaiting conversion (radius)
+	vector<GLfloat> m_PendingRadius;
+
+	/// Vertex indices of the coordinates awaiting conversion
+	vector<size_t> m_PendingIndex;
+
+	/// Conversion buffer for the cartesian coordinates (x, y, z)
+	vector<GLfloat> m_Converted[3];
+
+	/// Draw ranges of all known layers (identified by layer ID)
+	map<int, Layer> m_Layers;
+
+	/// Identifier of the layer currently being defined (-1 if none)
+	int m_CurrentLayer;
+
+	/// Current vertex color
+	GLfloat m_CurrentColor[3];
+
+	/// Current point size
+	GLfloat m_CurrentSize;
+
+	/// Indicates whether the OpenGL objects/entry points have been set up for the current context
+	bool m_Resolved;
+
+	/// ID of the OpenGL vertex buffer object (0 if not in use)
+	GLuint m_VertexBuffer;
+
+	/// Entry points of the buffer object functions (only valid if m_VertexBuffer != 0)
+	BufferFunctions m_Buffers;
+
+	/// Entry points of the GLSL functions (only valid if m_PointProgram != 0)
+	ShaderFunctions m_gl;
+
+	/// ID of the point size shader program (0 if not available)
+	GLuint m_PointProgram;
+
+	/// Location of the point size attribute in m_PointProgram
+	GLint m_PointSizeAttribute;
+
+	/// Location of the fog mode uniform in m_PointProgram
+	GLint m_FogModeUniform;
+};
+
+/**
+ * @}
+ */
+
+#endif /*SKYGEOMETRYSTORE_H_*/
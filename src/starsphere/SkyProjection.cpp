@@ -0,0 +1,234 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "SkyProjection.h"
+
+#include <cmath>
+
+#ifdef SKYPROJECTION_X86
+#include <immintrin.h>
+#endif
+
+SkyProjection::Kernel SkyProjection::m_Kernel = 0;
+const char *SkyProjection::m_KernelName = "scalar";
+
+// degrees to radians
+#define DEG2RAD 0.017453292519943295f
+
+// minimax coefficients for sin/cos on [-pi/4, pi/4] (Cephes sinf/cosf)
+#define SIN_C1 -1.6666654611e-1f
+#define SIN_C2  8.3321608736e-3f
+#define SIN_C3 -1.9515295891e-4f
+#define COS_C1  4.166664568298827e-2f
+#define COS_C2 -1.388731625493765e-3f
+#define COS_C3  2.443315711809948e-5f
+
+void SkyProjection::toCartesian(const float *RAdeg, const float *DEdeg, const float *radius,
+								float *x, float *y, float *z, const size_t count)
+{
+	if(!m_Kernel) selectKernel();
+	m_Kernel(RAdeg, DEdeg, radius, x, y, z, count);
+}
+
+const char *SkyProjection::kernelName()
+{
+	if(!m_Kernel) selectKernel();
+	return m_KernelName;
+}
+
+SkyProjection::Kernel SkyProjection::kernel(const KernelType type)
+{
+	switch(type) {
+		case ScalarKernel:
+			return toCartesianScalar;
+#ifdef SKYPROJECTION_X86
+		case SSE2Kernel:
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("sse2") ? toCartesianSSE2 : 0;
+		case AVX2Kernel:
+			__builtin_cpu_init();
+			return __builtin_cpu_supports("avx2") ? toCartesianAVX2 : 0;
+#endif
+		default:
+			return 0;
+	}
+}
+
+const char *SkyProjection::kernelName(const KernelType type)
+{
+	switch(type) {
+		case SSE2Kernel:
+			return "sse2";
+		case AVX2Kernel:
+			return "avx2";
+		default:
+			return "scalar";
+	}
+}
+
+void SkyProjection::selectKernel()
+{
+	// prefer the widest kernel supported by the host CPU
+	const KernelType preferred[] = {AVX2Kernel, SSE2Kernel, ScalarKernel};
+
+	for(size_t i = 0; i < sizeof(preferred) / sizeof(preferred[0]); ++i) {
+		Kernel candidate = kernel(preferred[i]);
+		if(candidate) {
+			m_Kernel = candidate;
+			m_KernelName = kernelName(preferred[i]);
+			return;
+		}
+	}
+}
+
+void SkyProjection::toCartesianScalar(const float *RAdeg, const float *DEdeg, const float *radius,
+									  float *x, float *y, float *z, const size_t count)
+{
+	// note: double precision avoids range reduction errors for large angles
+	for(size_t i = 0; i < count; ++i) {
+		const double ra = RAdeg[i] * (M_PI / 180.0);
+		const double de = DEdeg[i] * (M_PI / 180.0);
+		const double rcosde = radius[i] * cos(de);
+
+		x[i] = rcosde * cos(ra);
+		y[i] = radius[i] * sin(de);
+		z[i] = -rcosde * sin(ra);
+	}
+}
+
+#ifdef SKYPROJECTION_X86
+
+/**
+ * Computes sine and cosine of four angles (in degrees). The angles are reduced
+ * to [-45, 45] degrees in degrees (exact for the angles we use) before they are
+ * converted to radians, the quadrant is applied by swapping/negating the results.
+ */
+__attribute__((target("sse2")))
+static inline void sincosdeg_sse2(__m128 deg, __m128 *s, __m128 *c)
+{
+	// quadrant and reduced angle
+	const __m128 q = _mm_cvtepi32_ps(_mm_cvtps_epi32(_mm_mul_ps(deg, _mm_set1_ps(1.0f / 90.0f))));
+	const __m128i quadrant = _mm_cvtps_epi32(q);
+	const __m128 r = _mm_mul_ps(_mm_sub_ps(deg, _mm_mul_ps(q, _mm_set1_ps(90.0f))), _mm_set1_ps(DEG2RAD));
+	const __m128 r2 = _mm_mul_ps(r, r);
+
+	// polynomials
+	__m128 ps = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(SIN_C3), r2), _mm_set1_ps(SIN_C2));
+	ps = _mm_add_ps(_mm_mul_ps(ps, r2), _mm_set1_ps(SIN_C1));
+	ps = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(ps, r2), r), r);
+
+	__m128 pc = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(COS_C3), r2), _mm_set1_ps(COS_C2));
+	pc = _mm_add_ps(_mm_mul_ps(pc, r2), _mm_set1_ps(COS_C1));
+	pc = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(pc, r2), r2), _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(r2, _mm_set1_ps(0.5f))));
+
+	// odd quadrants swap sine and cosine
+	const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+	__m128 sine = _mm_or_ps(_mm_and_ps(swap, pc), _mm_andnot_ps(swap, ps));
+	__m128 cosine = _mm_or_ps(_mm_and_ps(swap, ps), _mm_andnot_ps(swap, pc));
+
+	// sign of sine: quadrants 2, 3 / sign of cosine: quadrants 1, 2
+	const __m128 signS = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), 30));
+	const __m128 signC = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+	*s = _mm_xor_ps(sine, signS);
+	*c = _mm_xor_ps(cosine, signC);
+}
+
+__attribute__((target("sse2")))
+void SkyProjection::toCartesianSSE2(const float *RAdeg, const float *DEdeg, const float *radius,
+									float *x, float *y, float *z, const size_t count)
+{
+	const __m128 sign = _mm_set1_ps(-0.0f);
+	size_t i = 0;
+
+	for(; i + 4 <= count; i += 4) {
+		__m128 sinRA, cosRA, sinDE, cosDE;
+		sincosdeg_sse2(_mm_loadu_ps(RAdeg + i), &sinRA, &cosRA);
+		sincosdeg_sse2(_mm_loadu_ps(DEdeg + i), &sinDE, &cosDE);
+
+		const __m128 r = _mm_loadu_ps(radius + i);
+		const __m128 rcosde = _mm_mul_ps(r, cosDE);
+
+		_mm_storeu_ps(x + i, _mm_mul_ps(rcosde, cosRA));
+		_mm_storeu_ps(y + i, _mm_mul_ps(r, sinDE));
+		_mm_storeu_ps(z + i, _mm_xor_ps(_mm_mul_ps(rcosde, sinRA), sign));
+	}
+
+	// remainder
+	toCartesianScalar(RAdeg + i, DEdeg + i, radius + i, x + i, y + i, z + i, count - i);
+}
+
+/**
+ * AVX2 version of sincosdeg_sse2()
+ */
+__attribute__((target("avx2")))
+static inline void sincosdeg_avx2(__m256 deg, __m256 *s, __m256 *c)
+{
+	// quadrant and reduced angle
+	const __m256 q = _mm256_round_ps(_mm256_mul_ps(deg, _mm256_set1_ps(1.0f / 90.0f)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+	const __m256i quadrant = _mm256_cvtps_epi32(q);
+	const __m256 r = _mm256_mul_ps(_mm256_sub_ps(deg, _mm256_mul_ps(q, _mm256_set1_ps(90.0f))), _mm256_set1_ps(DEG2RAD));
+	const __m256 r2 = _mm256_mul_ps(r, r);
+
+	// polynomials
+	__m256 ps = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(SIN_C3), r2), _mm256_set1_ps(SIN_C2));
+	ps = _mm256_add_ps(_mm256_mul_ps(ps, r2), _mm256_set1_ps(SIN_C1));
+	ps = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(ps, r2), r), r);
+
+	__m256 pc = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(COS_C3), r2), _mm256_set1_ps(COS_C2));
+	pc = _mm256_add_ps(_mm256_mul_ps(pc, r2), _mm256_set1_ps(COS_C1));
+	pc = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(pc, r2), r2), _mm256_sub_ps(_mm256_set1_ps(1.0f), _mm256_mul_ps(r2, _mm256_set1_ps(0.5f))));
+
+	// odd quadrants swap sine and cosine
+	const __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(quadrant, _mm256_set1_epi32(1)), _mm256_set1_epi32(1)));
+	__m256 sine = _mm256_blendv_ps(ps, pc, swap);
+	__m256 cosine = _mm256_blendv_ps(pc, ps, swap);
+
+	// sign of sine: quadrants 2, 3 / sign of cosine: quadrants 1, 2
+	const __m256 signS = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(quadrant, _mm256_set1_epi32(2)), 30));
+	const __m256 signC = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(quadrant, _mm256_set1_epi32(1)), _mm256_set1_epi32(2)), 30));
+	*s = _mm256_xor_ps(sine, signS);
+	*c = _mm256_xor_ps(cosine, signC);
+}
+
+__attribute__((target("avx2")))
+void SkyProjection::toCartesianAVX2(const float *RAdeg, const float *DEdeg, const float *radius,
+									float *x, float *y, float *z, const size_t count)
+{
+	const __m256 sign = _mm256_set1_ps(-0.0f);
+	size_t i = 0;
+
+	for(; i + 8 <= count; i += 8) {
+		__m256 sinRA, cosRA, sinDE, cosDE;
+		sincosdeg_avx2(_mm256_loadu_ps(RAdeg + i), &sinRA, &cosRA);
+		sincosdeg_avx2(_mm256_loadu_ps(DEdeg + i), &sinDE, &cosDE);
+
+		const __m256 r = _mm256_loadu_ps(radius + i);
+		const __m256 rcosde = _mm256_mul_ps(r, cosDE);
+
+		_mm256_storeu_ps(x + i, _mm256_mul_ps(rcosde, cosRA));
+		_mm256_storeu_ps(y + i, _mm256_mul_ps(r, sinDE));
+		_mm256_storeu_ps(z + i, _mm256_xor_ps(_mm256_mul_ps(rcosde, sinRA), sign));
+	}
+
+	// remainder
+	toCartesianSSE2(RAdeg + i, DEdeg + i, radius + i, x + i, y + i, z + i, count - i);
+}
+
+#endif
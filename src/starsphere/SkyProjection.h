@@ -0,0 +1,139 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef SKYPROJECTION_H_
+#define SKYPROJECTION_H_
+
+#include <cstddef>
+
+// SIMD kernels are available for x86 compilers supporting per-function target selection
+#if (defined(__x86_64__) || defined(__i386__)) && \
+	(defined(__clang__) || (defined(__GNUC__) && (__GNUC__ >= 5)))
+#define SKYPROJECTION_X86
+#endif
+
+/**
+ * \addtogroup starsphere Starsphere
+ * @{
+ */
+
+/**
+ * \brief Batch conversion of celestial coordinates to cartesian coordinates
+ *
+ * This class converts arrays (structure of arrays) of right ascension, declination
+ * and radius into the cartesian coordinates used by %Starsphere:
+ * \code
+ * x =  radius * cos(DE) * cos(RA)
+ * y =  radius * sin(DE)
+ * z = -radius * cos(DE) * sin(RA)
+ * \endcode
+ *
+ * The conversion uses single precision SIMD kernels (AVX2: 8, SSE2: 4 vertices
+ * per iteration) with a polynomial sine/cosine approximation (max. error about
+ * 2e-7 relative to the radius, see the skybench tool). The best kernel supported by
+ * the host CPU is selected at runtime. On other platforms (or CPUs) a scalar fallback
+ * using the (double precision) standard math library is used.
+ *
+ * \author Oliver Bock\n
+ * Max-Planck-Institute for Gravitational Physics\n
+ * Hannover, Germany
+ */
+class SkyProjection
+{
+public:
+	/// Signature of the conversion kernels
+	typedef void (*Kernel)(const float*, const float*, const float*, float*, float*, float*, const size_t);
+
+	/// Available conversion kernels
+	enum KernelType {
+		ScalarKernel,
+		SSE2Kernel,
+		AVX2Kernel
+	};
+
+	/**
+	 * \brief Converts celestial coordinates to cartesian coordinates
+	 *
+	 * \param RAdeg Array of right ascensions (in degrees)
+	 * \param DEdeg Array of declinations (in degrees)
+	 * \param radius Array of radii
+	 * \param x Array receiving the x-coordinates
+	 * \param y Array receiving the y-coordinates
+	 * \param z Array receiving the z-coordinates
+	 * \param count Number of coordinates (length of all arrays)
+	 */
+	static void toCartesian(const float *RAdeg, const float *DEdeg, const float *radius,
+							float *x, float *y, float *z, const size_t count);
+
+	/**
+	 * \brief Returns the name of the conversion kernel used on this host
+	 *
+	 * \return The kernel name ("avx2", "sse2" or "scalar")
+	 */
+	static const char *kernelName();
+
+	/**
+	 * \brief Returns a specific conversion kernel (e.g. to compare it to the others)
+	 *
+	 * \param type The kernel to be returned
+	 *
+	 * \return The kernel, NULL if it isn't supported by this build or host CPU
+	 */
+	static Kernel kernel(const KernelType type);
+
+	/**
+	 * \brief Returns the name of a specific conversion kernel
+	 *
+	 * \param type The kernel whose name should be returned
+	 *
+	 * \return The kernel name ("avx2", "sse2" or "scalar")
+	 */
+	static const char *kernelName(const KernelType type);
+
+private:
+	/// Selects the kernel to be used on this host (done once)
+	static void selectKernel();
+
+	/// Scalar conversion kernel (reference/fallback, also used for remainders)
+	static void toCartesianScalar(const float *RAdeg, const float *DEdeg, const float *radius,
+								  float *x, float *y, float *z, const size_t count);
+
+#ifdef SKYPROJECTION_X86
+	/// SSE2 conversion kernel (4 coordinates per iteration)
+	static void toCartesianSSE2(const float *RAdeg, const float *DEdeg, const float *radius,
+								float *x, float *y, float *z, const size_t count);
+
+	/// AVX2 conversion kernel (8 coordinates per iteration)
+	static void toCartesianAVX2(const float *RAdeg, const float *DEdeg, const float *radius,
+								float *x, float *y, float *z, const size_t count);
+#endif
+
+	/// Kernel selected for this host
+	static Kernel m_Kernel;
+
+	/// Name of the kernel selected for this host
+	static const char *m_KernelName;
+};
+
+/**
+ * @}
+ */
+
+#endif /*SKYPROJECTION_H_*/
@@ -24,7 +24,8 @@
 #include "Starsphere.h"
 
 Starsphere::Starsphere(string sharedMemoryAreaIdentifier) :
-	AbstractGraphicsEngine(sharedMemoryAreaIdentifier)
+	AbstractGraphicsEngine(sharedMemoryAreaIdentifier),
+	m_Results(MAX_RESULT_COUNT)
 {
 	m_FontResource = 0;
 	m_FontLogo1 = 0;
@@ -32,9 +33,7 @@ Starsphere::Starsphere(string sharedMemoryAreaIdentifier) :
 	m_FontHeader = 0;
 	m_FontText = 0;
 
-	Axes=0, Stars=0, Constellations=0, Pulsars=0, Results=0; 
-	LLOmarker=0, LHOmarker=0, GEOmarker=0, VIRGOmarker=0;
-	sphGrid=0, SNRs=0, SearchMarker=0;
+	SearchMarker=0;
 
 	/**
 	 * Parameters and State info
@@ -61,7 +60,15 @@ Starsphere::Starsphere(string sharedMemoryAreaIdentifier) :
 	m_CurrentDeclination = -1.0;
 	m_RefreshSearchMarker = true;
 
+	m_QualitySetting = BOINCClientAdapter::LowGraphicsQualitySetting;
+	m_UserInformationRevision = 0;
+
+	result_info = NULL;
 	Nresults=0;
+
+	// result candidate markers (rainbow_colormap has 256 entries)
+	m_Results.setColorMap(rainbow_colormap, 256);
+	m_Results.setPointSize(2.0);
 }
 
 Starsphere::~Starsphere()
@@ -73,48 +80,39 @@ Starsphere::~Starsphere()
 
 }
 
-void Starsphere::sphVertex3D(GLfloat RAdeg, GLfloat DEdeg, GLfloat radius)
+void Starsphere::sphQueueVertex3D(GLfloat RAdeg, GLfloat DEdeg, GLfloat radius)
 {
-	GLfloat x, y, z;
-
-	x = radius * COS(DEdeg) * COS(RAdeg);
-	z = -radius * COS(DEdeg) * SIN(RAdeg);
-	y = radius * SIN(DEdeg);
-	glVertex3f(x, y, z);
-	return;
+	m_QueuedVertices[0].push_back(RAdeg);
+	m_QueuedVertices[1].push_back(DEdeg);
+	m_QueuedVertices[2].push_back(radius);
 }
 
-void Starsphere::sphVertex(GLfloat RAdeg, GLfloat DEdeg)
+void Starsphere::sphQueueVertex(GLfloat RAdeg, GLfloat DEdeg)
 {
-	sphVertex3D(RAdeg, DEdeg, sphRadius);
+	sphQueueVertex3D(RAdeg, DEdeg, sphRadius);
 }
 
-/**
- * Star Marker:
- * Makes a marker for one star at a given position and angular size.
- */
-void Starsphere::star_marker(float RAdeg, float DEdeg, float size)
+void Starsphere::sphFlushVertices()
 {
-	glPointSize((GLfloat) size);
-	glBegin(GL_POINTS);
-	sphVertex((GLfloat) RAdeg, (GLfloat) DEdeg);
-	glEnd();
-	return;
-}
+	const size_t count = m_QueuedVertices[0].size();
+	if(count == 0) return;
 
-/**
- * Star Marker:
- * Makes a marker for one star at a given position, angular size and radius
- */
-void Starsphere::star_marker3D(float RAdeg, float DEdeg, float radius, float size)
-{
-	glPointSize((GLfloat) size);
-	glBegin(GL_POINTS);
-	sphVertex3D((GLfloat) RAdeg, (GLfloat) DEdeg, (GLfloat) (radius*sphRadius));
-	glEnd();
-	return;
-}
+	for(int i = 0; i < 3; ++i) {
+		m_ConvertedVertices[i].resize(count);
+	}
+
+	SkyProjection::toCartesian(&m_QueuedVertices[0][0], &m_QueuedVertices[1][0], &m_QueuedVertices[2][0],
+							   &m_ConvertedVertices[0][0], &m_ConvertedVertices[1][0], &m_ConvertedVertices[2][0],
+							   count);
 
+	for(size_t i = 0; i < count; ++i) {
+		glVertex3f(m_ConvertedVertices[0][i], m_ConvertedVertices[1][i], m_ConvertedVertices[2][i]);
+	}
+
+	for(int i = 0; i < 3; ++i) {
+		m_QueuedVertices[i].clear();
+	}
+}
 
 /**
  *  Create Stars: markers for each star
@@ -122,91 +120,43 @@ void Starsphere::star_marker3D(float RAdeg, float DEdeg, float radius, float siz
 void Starsphere::make_stars()
 {
 	GLfloat mag_size;
-	int i, j;
-	bool is_dupe;
-	int Ndupes=0;
-
-	// delete existing, create new (required for windoze)
-	if(Stars) glDeleteLists(Stars, 1);
-	Stars = glGenLists(1);
-	glNewList(Stars, GL_COMPILE);
-
-		glColor3f(1.0, 1.0, 1.0);
-
-		/**
-		 * At some point in the future star_info[][] will also contain
-		 * star magnitude and the marker size will vary with this.
-		 */
-		for (i=0; i < Nstars; i++) {
-			// same stars appear more than once in constallations so ignore dupes
-			is_dupe=false;
-			for (j=0; j< i; j++) {
-				if (star_info[j][0] == star_info[i][0] && star_info[j][0]
-				        == star_info[i][0]) {
-					is_dupe=true;
-					Ndupes++;
-					break;
-				}
-			}
-			if (!is_dupe) {
-				// mag_size = 0.05 + 0.50*rand()/RAND_MAX;
-				mag_size = 4.0;
-				star_marker(star_info[i][0], star_info[i][1], mag_size);
-			}
-		}
-
-	glEndList();
-}
-
-void Starsphere::make_results() 
-{
-	GLfloat mag_size=2.0;
 	int i;
-	float r,g,b;
-	float min_r, max_r; 
-        // default values for max significance metric
-	resultMetricDefaults(min_r,max_r);
 
-	
-	// delete existing, create new (required for windoze)
-	if(Results) glDeleteLists(Results, 1);
-	Results = glGenLists(1);
-	glNewList(Results, GL_COMPILE);
+	/**
+	 * At some point in the future star_info[][] will also contain
+	 * star magnitude and the marker size will vary with this.
+	 */
+	// mag_size = 0.05 + 0.50*rand()/RAND_MAX;
+	mag_size = 4.0;
 
+	m_StaticGeometry.beginLayer(STARS, GL_POINTS, mag_size);
 
-		for (i=0; i < Nresults; i++) {
-			float radius=result_info[i][2];
-			if (radius < min_r) {
-				min_r=radius;
-			}
-			if (radius > max_r) {
-				max_r=radius;		
-			}
+		m_StaticGeometry.color(1.0, 1.0, 1.0);
+
+		// note: the star positions are precomputed (unique, unit sphere) by starcat
+		for (i=0; i < c_StarVertexCount; i++) {
+			m_StaticGeometry.vertex(sphRadius * c_StarVertices[i][0],
+									sphRadius * c_StarVertices[i][1],
+									sphRadius * c_StarVertices[i][2]);
 		}
-		
-		if (min_r==max_r) min_r=max_r-1.0; 
- 			
-		for (i=0; i < Nresults; i++) {
 
-			float radius=result_info[i][2];
+	m_StaticGeometry.endLayer();
+}
 
-			float norm_radius = (radius - min_r) / (max_r-min_r);
-			int   color_bin = (int) (255.0 * (1.0 - norm_radius));
+void Starsphere::make_results()
+{
+	float min_r, max_r;
 
-			if (color_bin < 0) color_bin=0;
-			if (color_bin > 255) color_bin = 255;
+	// default values for max significance metric
+	resultMetricDefaults(min_r, max_r);
+	m_Results.setRangeDefaults(min_r, max_r);
+	m_Results.setRadius(sphRadius);
 
-			r = rainbow_colormap[color_bin][0];
-			g = rainbow_colormap[color_bin][1];
-			b = rainbow_colormap[color_bin][2];
-			glColor3f(r, g, b);
-			star_marker3D(result_info[i][0], result_info[i][1],norm_radius ,mag_size);
-		}
-	glEndList();
+	// only new/changed candidates are recolored and transferred
+	m_Results.update(result_info, Nresults);
+	m_Results.upload();
 }
 
-
-
 /**
  *  Pulsar Markers:
  */
@@ -215,18 +165,17 @@ void Starsphere::make_pulsars()
 	GLfloat mag_size=3.0;
 	int i;
 
-	// delete existing, create new (required for windoze)
-	if(Pulsars) glDeleteLists(Pulsars, 1);
-	Pulsars = glGenLists(1);
-	glNewList(Pulsars, GL_COMPILE);
+	m_StaticGeometry.beginLayer(PULSARS, GL_POINTS, mag_size);
 
-		glColor3f(0.80, 0.0, 0.85); // _P_ulsars are _P_urple
+		m_StaticGeometry.color(0.80, 0.0, 0.85); // _P_ulsars are _P_urple
 
-		for (i=0; i < Npulsars; i++) {
-			star_marker(pulsar_info[i][0], pulsar_info[i][1], mag_size);
+		for (i=0; i < c_PulsarVertexCount; i++) {
+			m_StaticGeometry.vertex(sphRadius * c_PulsarVertices[i][0],
+									sphRadius * c_PulsarVertices[i][1],
+									sphRadius * c_PulsarVertices[i][2]);
 		}
 
-	glEndList();
+	m_StaticGeometry.endLayer();
 }
 
 /**
@@ -237,18 +186,17 @@ void Starsphere::make_snrs()
 	GLfloat mag_size=3.0;
 	int i;
 
-	// delete existing, create new (required for windoze)
-	if(SNRs) glDeleteLists(SNRs, 1);
-	SNRs = glGenLists(1);
-	glNewList(SNRs, GL_COMPILE);
+	m_StaticGeometry.beginLayer(SNRS, GL_POINTS, mag_size);
 
-		glColor3f(0.7, 0.176, 0.0); // _S_NRs are _S_ienna
+		m_StaticGeometry.color(0.7, 0.176, 0.0); // _S_NRs are _S_ienna
 
-		for (i=0; i < NSNRs; i++) {
-			star_marker(SNR_info[i][0], SNR_info[i][1], mag_size);
+		for (i=0; i < c_SNRVertexCount; i++) {
+			m_StaticGeometry.vertex(sphRadius * c_SNRVertices[i][0],
+									sphRadius * c_SNRVertices[i][1],
+									sphRadius * c_SNRVertices[i][2]);
 		}
 
-	glEndList();
+	m_StaticGeometry.endLayer();
 }
 
 /**
@@ -259,57 +207,37 @@ void Starsphere::make_constellations()
 {
 	GLint star_num=0;
 
-	// delete existing, create new (required for windoze)
-	if(Constellations) glDeleteLists(Constellations, 1);
-	Constellations = glGenLists(1);
-	glNewList(Constellations, GL_COMPILE);
-
-		glLineWidth(1.0);
-		glColor3f(0.7, 0.7, 0.0); // light yellow
-
-		glBegin(GL_LINES); // draws lines between *pairs* of vertices
-			for (star_num=0; star_num < Nstars; ++star_num) {
-				sphVertex(star_info[star_num][0], star_info[star_num][1]);
-				star_num++;
-				sphVertex(star_info[star_num][0], star_info[star_num][1]);
-			}
-		glEnd();
+	// draws lines between *pairs* of vertices
+	m_StaticGeometry.beginLayer(CONSTELLATIONS, GL_LINES, 1.0);
 
-	glEndList();
+		m_StaticGeometry.color(0.7, 0.7, 0.0); // light yellow
+
+		for (star_num=0; star_num < c_ConstellationVertexCount; ++star_num) {
+			m_StaticGeometry.vertex(sphRadius * c_ConstellationVertices[star_num][0],
+									sphRadius * c_ConstellationVertices[star_num][1],
+									sphRadius * c_ConstellationVertices[star_num][2]);
+		}
+
+	m_StaticGeometry.endLayer();
 }
 
 /**
- * Create markers on sky sphere for LLO, LHO, GEO and VIRGO
+ * Built-in observatories: LLO, LHO, GEO and VIRGO
  * IFO corner positions are from Myers' personal GPS and are +/- 100m
  */
-
-GLfloat Starsphere::RAofZenith(double T, GLfloat LONdeg)
-{
-
-	// unix epoch at 12h  1/1/2000
-	const double T_0 = 946728000.0;
-
-	//  UT seconds of the day
-	double T_s = fmod(T, 24.0*3600.0);
-
-	// Julian centuries since 12h 1/1/2000 and 0h today
-	double T_c = (T - T_s - T_0)/3155760000.0;
-
-	// GMST at 0h today in seconds
-	double GMST0 = 6.0*3600.0 + 41.0*60.0 + 50.54841 + (8640184.812866
-	        + 0.093104*T_c)*T_c;
-
-	// GMST now in seconds
-	double GMST = GMST0 + 1.002738*T_s;
-
-	// longitude defined as west positive
-	GLfloat alpha = (GMST/(24.0*3600.0))*360.0 - LONdeg;
-
-	return alpha;
-}
+const Starsphere::Observatory Starsphere::c_Observatories[] = {
+	// LIGO Livingston Observatory (arms: south, west)
+	{ InterferometerShape, 30.56377, 90.77408, -1.0, 1.0, { 0.0, 1.0, 0.0 }, false, 0.0 },
+	// LIGO Hanford Observatory: H1 and H2 (arms: north, west)
+	{ DualInterferometerShape, 46.45510, 119.40627, 1.0, 1.0, { 0.0, 0.0, 1.0 }, false, 0.0 },
+	// GEO600 Interferometer (arms: north, east)
+	{ ShortInterferometerShape, 52.24452, -9.80683, 1.0, -1.0, { 1.0, 0.0, 0.0 }, false, 0.0 },
+	// VIRGO Interferometer (arms: north, west)
+	{ InterferometerShape, 43.63139, -10.505, 1.0, 1.0, { 1.0, 1.0, 1.0 }, false, 0.0 }
+};
 
 /**
- * Draw the observatories at their zenith positions
+ * Create markers on sky sphere for LLO, LHO, GEO and VIRGO
  */
 void Starsphere::generateObservatories(float dimFactor)
 {
@@ -317,177 +245,94 @@ void Starsphere::generateObservatories(float dimFactor)
 	if(dimFactor < 0.0) dimFactor = 0.0;
 	if(dimFactor > 1.0) dimFactor = 1.0;
 
-	GLfloat Lat, Lon; // Latitute/Longitude of IFO is
-	GLfloat RAdeg, DEdeg; // converted to RA/DEC of sky sphere position
-	GLfloat radius; // radius of sphere for obs
-
-	GLfloat arm_len_deg=3.000; // lenght of arms, in degrees (not to scale)
-	GLfloat h2=0.400; // slight offset for H2 arms
-
 	// get current time and UTC offset (for zenith position)
 	m_ObservatoryDrawTimeLocal = dtime();
 	time_t local = m_ObservatoryDrawTimeLocal;
 	tm *utc = gmtime(&local);
 	double utcOffset = difftime(local, mktime(utc));
-	double observatoryDrawTimeGMT = m_ObservatoryDrawTimeLocal - utcOffset;
-
-	radius = 1.0*sphRadius; // radius of sphere on which they are drawn
-
-	float lineSize = 4.0;
-
-	/**
-	 * LIGO Livingston Observatory:
-	 */
-
-	Lat= 30.56377;
-	Lon= 90.77408;
-
-	RAdeg= RAofZenith(observatoryDrawTimeGMT, Lon);
-	DEdeg= Lat;
-
-	// delete existing, create new (required for windoze)
-	if(LLOmarker) glDeleteLists(LLOmarker, 1);
-	LLOmarker = glGenLists(1);
-	glNewList(LLOmarker, GL_COMPILE);
-
-		glColor3f(dimFactor * 0.0, dimFactor * 1.0, dimFactor * 0.0);
-		glLineWidth(lineSize);
-
-		glBegin(GL_LINE_STRIP);
-			//  North/South arm:
-			sphVertex3D(RAdeg, DEdeg-arm_len_deg, radius);
-			sphVertex3D(RAdeg, DEdeg, radius);
-			// East/West arm:
-			sphVertex3D(RAdeg-arm_len_deg, DEdeg, radius);
-		glEnd();
-
-		// arm joint H2
-		glPointSize((GLfloat) lineSize);
-		glBegin(GL_POINTS);
-			sphVertex3D(RAdeg, DEdeg, radius);
-		glEnd();
-
-	glEndList();
+	m_ObservatoryDrawTimeGMT = m_ObservatoryDrawTimeLocal - utcOffset;
+
+	// instances: only their color and zenith position have to be computed
+	m_Observatories.clear();
+	for(size_t i = 0; i < sizeof(c_Observatories) / sizeof(c_Observatories[0]); ++i) {
+		Observatory observatory = c_Observatories[i];
+		observatory.rightAscension = RAofZenith(m_ObservatoryDrawTimeGMT, observatory.longitude);
+		observatory.color[0] *= dimFactor;
+		observatory.color[1] *= dimFactor;
+		observatory.color[2] *= dimFactor;
+		m_Observatories.push_back(observatory);
+	}
+}
 
-	/**
-	 * LIGO Hanford Observatory: H1 and H2
-	 */
+/**
+ * Create meshes for LLO, LHO, GEO and VIRGO (shared by all instances of the same shape)
+ */
+void Starsphere::generateObservatoryMeshes()
+{
+	make_interferometer_mesh(InterferometerShape, 3.0, false);
+	make_interferometer_mesh(ShortInterferometerShape, 1.5, false);
+	make_interferometer_mesh(DualInterferometerShape, 3.0, true);
+}
 
-	Lat= 46.45510;
-	Lon= 119.40627;
+/**
+ * Interferometer mesh: centered at RA = DEC = 0, arms pointing north and west
+ */
+void Starsphere::make_interferometer_mesh(const int shape, const GLfloat arm_len_deg, const bool dual)
+{
+	GLfloat radius = 1.0*sphRadius; // radius of sphere on which they are drawn
+	GLfloat h2 = 0.400; // slight offset for H2 arms
+	GLfloat lineSize = 4.0;
 
-	RAdeg= RAofZenith(observatoryDrawTimeGMT, Lon);
-	DEdeg= Lat;
+	m_ObservatoryGeometry.beginLayer(2 * shape, GL_LINES, lineSize);
 
-	// delete existing, create new (required for windoze)
-	if(LHOmarker) glDeleteLists(LHOmarker, 1);
-	LHOmarker = glGenLists(1);
-	glNewList(LHOmarker, GL_COMPILE);
-
-		glColor3f(dimFactor * 0.0, dimFactor * 0.0, dimFactor * 1.0);
-		glLineWidth(lineSize);
-
-		glBegin(GL_LINE_STRIP);
-			// North/South arm:
-			sphVertex3D(RAdeg, DEdeg+arm_len_deg, radius);
-			sphVertex3D(RAdeg, DEdeg, radius);
-			// East/West arm:
-			sphVertex3D(RAdeg-arm_len_deg, DEdeg, radius);
-		glEnd();
+		// North/South arm:
+		m_ObservatoryGeometry.sphVertex(0.0, arm_len_deg, radius);
+		m_ObservatoryGeometry.sphVertex(0.0, 0.0, radius);
+		// East/West arm:
+		m_ObservatoryGeometry.sphVertex(0.0, 0.0, radius);
+		m_ObservatoryGeometry.sphVertex(-arm_len_deg, 0.0, radius);
 
-		glBegin(GL_LINE_STRIP);
+		if(dual) {
 			// North/South arm, H2:
-			sphVertex3D(RAdeg-h2, DEdeg+arm_len_deg/2.0+h2/2.0, radius);
-			sphVertex3D(RAdeg-h2, DEdeg+h2/2.0, radius);
-			// East/West arm, H2;
-			sphVertex3D(RAdeg-arm_len_deg/2.0-h2, DEdeg+h2/2.0, radius);
-		glEnd();
-
-		// arm joint H1
-		glPointSize((GLfloat) lineSize);
-		glBegin(GL_POINTS);
-			sphVertex3D(RAdeg, DEdeg, radius);
-		glEnd();
-
-		// arm joint H2
-		glPointSize((GLfloat) lineSize);
-		glBegin(GL_POINTS);
-			sphVertex3D(RAdeg-h2, DEdeg+h2/2.0, radius);
-		glEnd();
-
-	glEndList();
-
-	/**
-	 *  GEO600 Interferometer:
-	 */
-
-	Lat= 52.24452;
-	Lon= -9.80683;
-	arm_len_deg=1.50; // not to scale
-
-	RAdeg= RAofZenith(observatoryDrawTimeGMT, Lon);
-	DEdeg= Lat;
+			m_ObservatoryGeometry.sphVertex(-h2, arm_len_deg/2.0+h2/2.0, radius);
+			m_ObservatoryGeometry.sphVertex(-h2, h2/2.0, radius);
+			// East/West arm, H2:
+			m_ObservatoryGeometry.sphVertex(-h2, h2/2.0, radius);
+			m_ObservatoryGeometry.sphVertex(-arm_len_deg/2.0-h2, h2/2.0, radius);
+		}
 
-	// delete existing, create new (required for windoze)
-	if(GEOmarker) glDeleteLists(GEOmarker, 1);
-	GEOmarker = glGenLists(1);
-	glNewList(GEOmarker, GL_COMPILE);
-
-		glColor3f(dimFactor * 1.0, dimFactor * 0.0, dimFactor * 0.0);
-		glLineWidth(lineSize);
-
-		glBegin(GL_LINE_STRIP);
-			// North/South arm:
-			sphVertex3D(RAdeg, DEdeg+arm_len_deg, radius);
-			sphVertex3D(RAdeg, DEdeg, radius);
-			// West/East arm:
-			sphVertex3D(RAdeg+arm_len_deg, DEdeg, radius);
-		glEnd();
+	m_ObservatoryGeometry.endLayer();
 
-		// arm joint
-		glPointSize((GLfloat) lineSize);
-		glBegin(GL_POINTS);
-			sphVertex3D(RAdeg, DEdeg, radius);
-		glEnd();
+	m_ObservatoryGeometry.beginLayer(2 * shape + 1, GL_POINTS, lineSize);
 
-	glEndList();
+		// arm joint (H1)
+		m_ObservatoryGeometry.sphVertex(0.0, 0.0, radius);
 
-	/**
-	 *  VIRGO Interferometer:
-	 */
+		if(dual) {
+			// arm joint H2
+			m_ObservatoryGeometry.sphVertex(-h2, h2/2.0, radius);
+		}
 
-	Lat= 43.63139;
-	Lon= -10.505;
-	arm_len_deg=3.000; // not to scale
+	m_ObservatoryGeometry.endLayer();
+}
 
-	RAdeg= RAofZenith(observatoryDrawTimeGMT, Lon);
-	DEdeg= Lat;
+void Starsphere::renderObservatory(const Observatory &observatory)
+{
+	glPushMatrix();
 
-	// delete existing, create new (required for windoze)
-	if(VIRGOmarker) glDeleteLists(VIRGOmarker, 1);
-	VIRGOmarker = glGenLists(1);
-	glNewList(VIRGOmarker, GL_COMPILE);
-
-		glColor3f(dimFactor * 1.0, dimFactor * 1.0, dimFactor * 1.0);
-		glLineWidth(lineSize);
-
-		glBegin(GL_LINE_STRIP);
-			// North/South arm:
-			sphVertex3D(RAdeg, DEdeg+arm_len_deg, radius);
-			sphVertex3D(RAdeg, DEdeg, radius);
-			// West/East arm:
-			sphVertex3D(RAdeg-arm_len_deg, DEdeg, radius);
-		glEnd();
+	// instance transform: zenith position, latitude, orientation
+	glRotatef(observatory.rightAscension, 0.0, 1.0, 0.0);
+	glRotatef(observatory.latitude, 0.0, 0.0, 1.0);
+	glScalef(1.0, observatory.north, observatory.east);
 
-		// arm joint
-		glPointSize((GLfloat) lineSize);
-		glBegin(GL_POINTS);
-			sphVertex3D(RAdeg, DEdeg, radius);
-		glEnd();
+	// note: the current color is undefined after using color arrays, so set it per layer
+	if(!observatory.meshColors) glColor3fv(observatory.color);
+	m_ObservatoryGeometry.render(2 * observatory.shape, observatory.meshColors);
 
-	glEndList();
+	if(!observatory.meshColors) glColor3fv(observatory.color);
+	m_ObservatoryGeometry.render(2 * observatory.shape + 1, observatory.meshColors);
 
-	return;
+	glPopMatrix();
 }
 
 void Starsphere::make_search_marker(GLfloat RAdeg, GLfloat DEdeg, GLfloat size)
@@ -522,8 +367,9 @@ void Starsphere::make_search_marker(GLfloat RAdeg, GLfloat DEdeg, GLfloat size)
 				theta = i*360.0/Nstep;
 				x = r1*COS(theta);
 				y = r1*SIN(theta);
-				sphVertex(x, y);
+				sphQueueVertex(x, y);
 			}
+			sphFlushVertices();
 		glEnd();
 
 		// Outer circle
@@ -532,24 +378,26 @@ void Starsphere::make_search_marker(GLfloat RAdeg, GLfloat DEdeg, GLfloat size)
 				theta = i*360.0/Nstep;
 				x = r2*COS(theta);
 				y = r2*SIN(theta);
-				sphVertex(x, y);
+				sphQueueVertex(x, y);
 			}
+			sphFlushVertices();
 		glEnd();
 
 		// Arms that form the gunsight
 		glBegin(GL_LINES);
 			//  North arm:
-			sphVertex(0.0, +r1);
-			sphVertex(0.0, +r3);
+			sphQueueVertex(0.0, +r1);
+			sphQueueVertex(0.0, +r3);
 			//  South arm:
-			sphVertex(0.0, -r1);
-			sphVertex(0.0, -r3);
+			sphQueueVertex(0.0, -r1);
+			sphQueueVertex(0.0, -r3);
 			// East arm:
-			sphVertex(-r1, 0.0);
-			sphVertex(-r3, 0.0);
+			sphQueueVertex(-r1, 0.0);
+			sphQueueVertex(-r3, 0.0);
 			// West arm:
-			sphVertex(+r1, 0.0);
-			sphVertex(+r3, 0.0);
+			sphQueueVertex(+r1, 0.0);
+			sphQueueVertex(+r3, 0.0);
+			sphFlushVertices();
 		glEnd();
 
 		glPopMatrix();
@@ -557,8 +405,9 @@ void Starsphere::make_search_marker(GLfloat RAdeg, GLfloat DEdeg, GLfloat size)
 		// searchlight line out to marker (OFF!)
 		if(false) {
 			glBegin(GL_LINES);
-				sphVertex3D(RAdeg, DEdeg, 0.50*sphRadius);
-				sphVertex3D(RAdeg, DEdeg, 0.95*sphRadius);
+				sphQueueVertex3D(RAdeg, DEdeg, 0.50*sphRadius);
+				sphQueueVertex3D(RAdeg, DEdeg, 0.95*sphRadius);
+				sphFlushVertices();
 			glEnd();
 		}
 
@@ -573,28 +422,21 @@ void Starsphere::make_axes()
 {
 	GLfloat axl=10.0;
 
-	// delete existing, create new (required for windoze)
-	if(Axes) glDeleteLists(Axes, 1);
-	Axes = glGenLists(1);
-	glNewList(Axes, GL_COMPILE);
+	m_StaticGeometry.beginLayer(AXES, GL_LINES, 2.0);
 
-		glLineWidth(2.0);
+		m_StaticGeometry.color(1.0, 0.0, 0.0);
+		m_StaticGeometry.vertex(-axl, 0.0, 0.0);
+		m_StaticGeometry.vertex(axl, 0.0, 0.0);
 
-		glBegin(GL_LINES);
-			glColor3f(1.0, 0.0, 0.0);
-			glVertex3f(-axl, 0.0, 0.0);
-			glVertex3f(axl, 0.0, 0.0);
+		m_StaticGeometry.color(0.0, 1.0, 0.0);
+		m_StaticGeometry.vertex(0.0, -axl, 0.0);
+		m_StaticGeometry.vertex(0.0, axl, 0.0);
 
-			glColor3f(0.0, 1.0, 0.0);
-			glVertex3f(0.0, -axl, 0.0);
-			glVertex3f(0.0, axl, 0.0);
+		m_StaticGeometry.color(0.0, 0.0, 1.0);
+		m_StaticGeometry.vertex(0.0, 0.0, -axl);
+		m_StaticGeometry.vertex(0.0, 0.0, axl);
 
-			glColor3f(0.0, 0.0, 1.0);
-			glVertex3f(0.0, 0.0, -axl);
-			glVertex3f(0.0, 0.0, axl);
-		glEnd();
-
-	glEndList();
+	m_StaticGeometry.endLayer();
 }
 
 /**
@@ -605,42 +447,41 @@ void Starsphere::make_globe()
 	int hr, j, i, iMax=100;
 	GLfloat RAdeg, DEdeg;
 
-	// delete existing, create new (required for windoze)
-	if(sphGrid) glDeleteLists(sphGrid, 1);
-	sphGrid = glGenLists(1);
-	glNewList(sphGrid, GL_COMPILE);
-
-		glLineWidth(1.0);
+	// note: line strips are stored as separate segments (GL_LINES) so that
+	// all grid lines can be drawn with a single call
+	m_StaticGeometry.beginLayer(GLOBE, GL_LINES, 1.0);
 
 		// Lines of constant Right Ascencion (East Longitude)
 		for (hr=0; hr<24; hr++) {
 			RAdeg=hr*15.0;
-			glColor3f(0.25, 0.25, 0.25);
+			m_StaticGeometry.color(0.25, 0.25, 0.25);
 
 			// mark median
-			if(hr==0) glColor3f(0.55, 0.55, 0.55);
+			if(hr==0) m_StaticGeometry.color(0.55, 0.55, 0.55);
 
-			glBegin(GL_LINE_STRIP);
-				for (i=0; i<=iMax; i++) {
-					DEdeg = i*180.0/iMax - 90.0;
-					sphVertex(RAdeg, DEdeg);
-				}
-			glEnd();
+			for (i=0; i<iMax; i++) {
+				DEdeg = i*180.0/iMax - 90.0;
+				m_StaticGeometry.sphVertex(RAdeg, DEdeg, sphRadius);
+				DEdeg = (i+1)*180.0/iMax - 90.0;
+				m_StaticGeometry.sphVertex(RAdeg, DEdeg, sphRadius);
+			}
 		}
 
+		m_StaticGeometry.color(0.25, 0.25, 0.25);
+
 		// Lines of constant Declination (Lattitude)
 		for (j=1; j<=12; j++) {
 			DEdeg = 90.0 - j*15.0;
 
-			glBegin(GL_LINE_STRIP);
-				for (i=0; i<=iMax; i++) {
-					RAdeg = i*360.0/iMax;
-					sphVertex(RAdeg, DEdeg);
-				}
-			glEnd();
+			for (i=0; i<iMax; i++) {
+				RAdeg = i*360.0/iMax;
+				m_StaticGeometry.sphVertex(RAdeg, DEdeg, sphRadius);
+				RAdeg = (i+1)*360.0/iMax;
+				m_StaticGeometry.sphVertex(RAdeg, DEdeg, sphRadius);
+			}
 		}
 
-	glEndList();
+	m_StaticGeometry.endLayer();
 }
 
 
@@ -694,6 +535,9 @@ void Starsphere::initialize(const int width, const int height, const Resource *f
 		// initialize the BOINC client adapter
 		m_BoincAdapter.initialize();
 
+		// store quality setting (the fetching thread isn't running yet)
+		m_QualitySetting = m_BoincAdapter.graphicsQualitySetting();
+
 		// inital HUD offset setup
 		m_XStartPosLeft = 5;
 		m_YOffsetLarge = 18;
@@ -730,8 +574,8 @@ void Starsphere::initialize(const int width, const int height, const Resource *f
 
 		// create medium font instances using font resource (base address + size)
 		m_FontHeader = new OGLFT::TranslucentTexture(
-									&m_FontResource->data()->at(0),
-									m_FontResource->data()->size(),
+									m_FontResource->data(),
+									m_FontResource->size(),
 									13, 78 );
 
 		if ( m_FontHeader == 0 || !m_FontHeader->isValid() ) {
@@ -743,8 +587,8 @@ void Starsphere::initialize(const int width, const int height, const Resource *f
 
 		// create small font instances using font resource (base address + size)
 		m_FontText = new OGLFT::TranslucentTexture(
-									&m_FontResource->data()->at(0),
-									m_FontResource->data()->size(),
+									m_FontResource->data(),
+									m_FontResource->size(),
 									11, 72 );
 
 		if ( m_FontText == 0 || !m_FontText->isValid() ) {
@@ -771,7 +615,7 @@ void Starsphere::initialize(const int width, const int height, const Resource *f
 	glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
 
 	// enable opt-in quality feature
-	if(m_BoincAdapter.graphicsQualitySetting() == BOINCClientAdapter::HighGraphicsQualitySetting) {
+	if(m_QualitySetting == BOINCClientAdapter::HighGraphicsQualitySetting) {
 		// some polishing
 		glShadeModel(GL_SMOOTH);
 		glEnable(GL_POINT_SMOOTH);
@@ -793,8 +637,8 @@ void Starsphere::initialize(const int width, const int height, const Resource *f
 	glDepthFunc(GL_LEQUAL);
 
 	// enable opt-in quality feature
-	if(m_BoincAdapter.graphicsQualitySetting() == BOINCClientAdapter::MediumGraphicsQualitySetting ||
-	   m_BoincAdapter.graphicsQualitySetting() == BOINCClientAdapter::HighGraphicsQualitySetting)
+	if(m_QualitySetting == BOINCClientAdapter::MediumGraphicsQualitySetting ||
+	   m_QualitySetting == BOINCClientAdapter::HighGraphicsQualitySetting)
 	{
 		// fog aids depth perception
 		glEnable(GL_FOG);
@@ -803,14 +647,29 @@ void Starsphere::initialize(const int width, const int height, const Resource *f
 		glHint(GL_FOG_HINT, GL_DONT_CARE);
 	}
 
-	// create pre-drawn display lists
+	// delete existing, create new (required for windoze)
+	m_StaticGeometry.release();
+	m_Results.release();
+
+	// create static geometry (all layers share one vertex buffer)
+	m_StaticGeometry.clear();
 	make_stars();
 	make_constellations();
 	make_pulsars();
-	make_results();
 	make_snrs();
 	make_axes();
 	make_globe();
+	m_StaticGeometry.upload();
+
+	// observatory meshes are built only once but have to be transferred to every context
+	m_ObservatoryGeometry.release();
+	if(m_ObservatoryGeometry.empty()) {
+		generateObservatoryMeshes();
+	}
+	m_ObservatoryGeometry.upload();
+
+	// transfer results (all of them after release)
+	make_results();
 
 	glDisable(GL_CLIP_PLANE0);
 	glClear(GL_COLOR_BUFFER_BIT|GL_DEPTH_BUFFER_BIT);
@@ -873,29 +732,28 @@ void Starsphere::render(const double timeOfDay)
 	        0.0, 1.0, 0.0); // which way is up?  y axis!
 
 	// draw axes before any rotation so they stay put
-	if (isFeature(AXES)) glCallList(Axes);
+	if (isFeature(AXES)) m_StaticGeometry.render(AXES);
 
 	// draw the sky sphere, with rotation:
 	glPushMatrix();
 	glRotatef(Zrot - rotation_offset, 0.0, 1.0, 0.0);
 
 	// stars, pulsars, supernovae, grid, results
-	if (isFeature(STARS))			glCallList(Stars);
-	if (isFeature(PULSARS))			glCallList(Pulsars);
-	if (isFeature(SNRS))			glCallList(SNRs);
-	if (isFeature(CONSTELLATIONS))	glCallList(Constellations);
-	if (isFeature(GLOBE))			glCallList(sphGrid);
-	if (isFeature(RESULTS))			glCallList(Results);
+	if (isFeature(STARS))			m_StaticGeometry.render(STARS);
+	if (isFeature(PULSARS))			m_StaticGeometry.render(PULSARS);
+	if (isFeature(SNRS))			m_StaticGeometry.render(SNRS);
+	if (isFeature(CONSTELLATIONS))	m_StaticGeometry.render(CONSTELLATIONS);
+	if (isFeature(GLOBE))			m_StaticGeometry.render(GLOBE);
+	if (isFeature(RESULTS))			m_Results.render();
 
 	// observatories move an extra 15 degrees/hr since they were drawn
 	if (isFeature(OBSERVATORIES)) {
 		glPushMatrix();
 		Zobs = (timeOfDay - m_ObservatoryDrawTimeLocal) * 15.0/3600.0;
 		glRotatef(Zobs, 0.0, 1.0, 0.0);
-		glCallList(LLOmarker);
-		glCallList(LHOmarker);
-		glCallList(GEOmarker);
-		glCallList(VIRGOmarker);
+		for(size_t i = 0; i < m_Observatories.size(); ++i) {
+			renderObservatory(m_Observatories[i]);
+		}
 		renderAdditionalObservatories();
 		glPopMatrix();
 	}
@@ -1068,10 +926,17 @@ bool Starsphere::isFeature(const Features feature)
 	return ((featureFlags & feature) == feature ? true : false);
 }
 
-void Starsphere::refreshLocalBOINCInformation()
+void Starsphere::fetchLocalBOINCInformation()
 {
 	// call base class implementation
-	AbstractGraphicsEngine::refreshLocalBOINCInformation();
+	AbstractGraphicsEngine::fetchLocalBOINCInformation();
+
+	// only rebuild (and publish) when the user information actually changed
+	if(m_BoincAdapter.userInfoRevision() == m_UserInformationRevision) return;
+	m_UserInformationRevision = m_BoincAdapter.userInfoRevision();
+
+	// fill the complete snapshot (slots are recycled)
+	UserInformation &info = m_UserInformation.back();
 
 	// prepare conversion buffer
 	stringstream buffer;
@@ -1081,16 +946,24 @@ void Starsphere::refreshLocalBOINCInformation()
 	buffer.setf(ios::right, ios::adjustfield);
 
 	// store content required for our HUD (user info)
-	m_UserName = "User: " + m_BoincAdapter.userName();
-	m_TeamName = "Team: " + m_BoincAdapter.teamName();
+	info.userName = "User: " + m_BoincAdapter.userName();
+	info.teamName = "Team: " + m_BoincAdapter.teamName();
 
 	buffer << "Project Credit: " << fixed << m_BoincAdapter.userCredit() << ends;
-	m_UserCredit = buffer.str();
+	info.userCredit = buffer.str();
 	buffer.str("");
 
 	buffer << "Project RAC: " << fixed << m_BoincAdapter.userRACredit() << ends;
-	m_UserRACredit = buffer.str();
+	info.userRACredit = buffer.str();
 	buffer.str("");
+
+	m_UserInformation.publish();
+}
+
+void Starsphere::refreshLocalBOINCInformation()
+{
+	// just take over the latest snapshot (if any)
+	m_UserInformation.update();
 }
 float Starsphere::rainbow_colormap [][3] = {
 { 1.000000f , 0.000000f , 0.000000f }, 
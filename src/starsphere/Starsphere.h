@@ -40,7 +40,11 @@
 #include <util.h>
 
 #include "AbstractGraphicsEngine.h"
+#include "SnapshotBuffer.h"
 #include "EinsteinS5R3Adapter.h"
+#include "SkyGeometryStore.h"
+#include "ResultsBuffer.h"
+#include "SkyProjection.h"
 
 // SIN and COS take arguments in DEGREES
 #define PI 3.14159265
@@ -197,32 +201,115 @@ protected:
 	 * for potential specializing classes to add additional observatories by
 	 * overriding the empty default implementation.
 	 *
-	 * Important: overriding classes should just provide additional display lists
-	 * by via calls to glCallList().
+	 * Important: overriding classes should just render additional observatory
+	 * instances via calls to renderObservatory().
 	 *
 	 * \see StarsphereRadio::renderAdditionalObservatories()
 	 */
 	inline virtual void renderAdditionalObservatories();
 
 	/**
-	 * \brief This method has to be called in order to update the BOINC client information
+	 * \brief This method has to be called in order to fetch the BOINC client information
 	 *
 	 * This is the local/generic implementation which calls
-	 * AbstractGraphicsEngine::refreshLocalBOINCInformation() first and
-	 * refreshes the "BOINC Statistics" afterwards.
+	 * AbstractGraphicsEngine::fetchLocalBOINCInformation() first and
+	 * publishes the preformatted "BOINC Statistics" afterwards.
+	 * It's called by the fetching (background) thread.
 	 *
-	 * \see AbstractGraphicsEngine::refreshLocalBOINCInformation()
+	 * \see AbstractGraphicsEngine::fetchLocalBOINCInformation()
+	 * \see m_UserInformation
+	 */
+	virtual void fetchLocalBOINCInformation();
+
+	/**
+	 * \brief This method has to be called in order to update the BOINC client information
+	 *
+	 * This is the local/generic implementation which takes over the latest
+	 * "BOINC Statistics" published by fetchLocalBOINCInformation().
+	 * It's called by the render thread.
+	 *
+	 * \see m_UserInformation
 	 */
 	virtual void refreshLocalBOINCInformation();
 
 	/**
-	 * \brief Generates the OpenGL call lists for the displayed observatories
+	 * \brief Generates the instances of the displayed observatories
+	 *
+	 * Only the zenith position and color of each instance are computed here, the
+	 * meshes are generated once by generateObservatoryMeshes().
 	 *
 	 * \param dimFactor A dim factor (range: 0 <= x <= 1) that will, well, dim the color
 	 * of the observatories.
 	 */
 	virtual void generateObservatories(const float dimFactor);
 
+	/**
+	 * \brief Generates the meshes of the displayed observatory shapes
+	 *
+	 * This method is called only once by initialize(), the meshes are kept in
+	 * m_ObservatoryGeometry and just transferred again when the OpenGL context
+	 * gets recycled. Specializing classes adding their own shapes have to call
+	 * this implementation as well.
+	 */
+	virtual void generateObservatoryMeshes();
+
+	/**
+	 * \brief Available observatory mesh shapes
+	 *
+	 * Each shape occupies two layers of m_ObservatoryGeometry: 2 * shape (e.g. the arms)
+	 * and 2 * shape + 1 (e.g. the arm joints). Specializing classes may add their own
+	 * shapes starting at AdditionalObservatoryShapes.
+	 */
+	enum ObservatoryShape {
+		InterferometerShape = 0,
+		ShortInterferometerShape = 1,
+		DualInterferometerShape = 2,
+		AdditionalObservatoryShapes = 3
+	};
+
+	/**
+	 * \brief Observatory instance
+	 *
+	 * The mesh of each shape is defined only once, centered at right ascension and declination 0
+	 * with its arms pointing north and west. An instance is drawn by mirroring the mesh as
+	 * required, rotating it to the observatory's latitude (z-axis) and to the right ascension
+	 * of its zenith (y-axis).
+	 *
+	 * \see Starsphere::renderObservatory()
+	 */
+	struct Observatory {
+		/// Mesh shape (see ObservatoryShape)
+		int shape;
+
+		/// Latitude (in degrees)
+		GLfloat latitude;
+
+		/// Longitude (in degrees, west positive)
+		GLfloat longitude;
+
+		/// Mirror factor for the north/south direction (1 or -1)
+		GLfloat north;
+
+		/// Mirror factor for the east/west direction (1 or -1)
+		GLfloat east;
+
+		/// Color (unless the mesh colors are used)
+		GLfloat color[3];
+
+		/// Use the colors stored in the mesh (TRUE) or the instance color (FALSE)
+		bool meshColors;
+
+		/// Right ascension of the zenith at draw time (set by generateObservatories())
+		GLfloat rightAscension;
+	};
+
+	/**
+	 * \brief Renders a single observatory instance
+	 *
+	 * \param observatory The observatory to be rendered
+	 */
+	void renderObservatory(const Observatory &observatory);
+
 	/**
 	 * \brief Available feature IDs
 	 *
@@ -282,25 +369,34 @@ protected:
 	GLfloat RAofZenith(double T, GLfloat LONdeg);
 
 	/**
-	 * \brief Creates a GL vertex in 3D sky sphere coordinates
+	 * \brief Queues a vertex in 3D sky sphere coordinates for batch conversion
 	 *
-	 * Use like glVertex()
+	 * Use like glVertex(). The actual GL vertices are created by sphFlushVertices().
 	 *
 	 * \param RAdeg The right ascension of the new vertex
 	 * \param DEdeg The declination of the new vertex
 	 * \param radius The radius of the sky sphere
 	 */
-	void sphVertex3D(GLfloat RAdeg, GLfloat DEdeg, GLfloat radius);
+	void sphQueueVertex3D(GLfloat RAdeg, GLfloat DEdeg, GLfloat radius);
 
 	/**
-	 * \brief Creates a GL vertex on the surface of the sky sphere.
+	 * \brief Queues a vertex on the surface of the sky sphere for batch conversion
 	 *
-	 * Use like glVertex()
+	 * Use like glVertex(). The actual GL vertices are created by sphFlushVertices().
 	 *
 	 * \param RAdeg The right ascension of the new vertex
 	 * \param DEdeg The declination of the new vertex
 	 */
-	void sphVertex(GLfloat RAdeg, GLfloat DEdeg);
+	void sphQueueVertex(GLfloat RAdeg, GLfloat DEdeg);
+
+	/**
+	 * \brief Converts all queued vertices at once and creates the corresponding GL vertices
+	 *
+	 * Use before glEnd() (vertices are created in the order they were queued)
+	 *
+	 * \see SkyProjection::toCartesian()
+	 */
+	void sphFlushVertices();
 
 	/// Radius of the celestial sphere
 	GLfloat sphRadius;
@@ -308,6 +404,12 @@ protected:
 	/// Observatory movement (in seconds since 1970 with usec precision)
 	double m_ObservatoryDrawTimeLocal;
 
+	/// Observatory draw time (GMT, used to compute the zenith positions)
+	double m_ObservatoryDrawTimeGMT;
+
+	/// Observatory meshes (see Starsphere::ObservatoryShape)
+	SkyGeometryStore m_ObservatoryGeometry;
+
 	// resource handling
 
 	/// Font resource instance
@@ -348,19 +450,37 @@ protected:
 	/// Y-coordinate line offset for head up display (HUD) positioning
 	GLfloat m_YOffsetLarge;
 
+	/**
+	 * \brief Active render quality setting (render thread only)
+	 *
+	 * Taken over from the BOINC client adapter when the engine is initialized for the
+	 * first time, i.e. before the fetching thread starts updating the adapter. Just like
+	 * the FSAA setup of the window manager it then stays fixed for the whole session.
+	 */
+	BOINCClientAdapter::GraphicsQualitySetting m_QualitySetting;
+
 	// local HUD contents
 
-	/// User name to be displayed in "BOINC Information" panel
-	string m_UserName;
+	/// Preformatted contents of the "BOINC Information" panel
+	struct UserInformation {
+		/// User name to be displayed in "BOINC Information" panel
+		string userName;
+
+		/// Team name to be displayed in "BOINC Information" panel
+		string teamName;
 
-	/// Team name to be displayed in "BOINC Information" panel
-	string m_TeamName;
+		/// User total credit to be displayed in "BOINC Information" panel
+		string userCredit;
 
-	/// User total credit to be displayed in "BOINC Information" panel
-	string m_UserCredit;
+		/// User recent average credit to be displayed in "BOINC Information" panel
+		string userRACredit;
+	};
 
-	/// User recent average credit to be displayed in "BOINC Information" panel
-	string m_UserRACredit;
+	/// "BOINC Information" panel contents (published by the fetching thread, read via front())
+	SnapshotBuffer<UserInformation> m_UserInformation;
+
+	/// Revision of the user information published last (fetching thread only)
+	unsigned int m_UserInformationRevision;
 
 	// search marker info
 
@@ -377,73 +497,75 @@ protected:
 	bool m_RefreshResults;
 
 
-	/// Result (Candiate) coordinates and 'score' 
-	float result_info[MAX_RESULT_COUNT][3];
+	/// Result (Candiate) coordinates and 'score' (points into the current snapshot, if any)
+	const float (*result_info)[3];
 
 	/// nr of candidate results
 	int Nresults;
 
 private:
-	/// Generate OpenGL display list for stars
+	/// Generate static geometry layer for stars
 	void make_stars();
 
-	/// Generate OpenGL display list for pulsars
+	/// Generate static geometry layer for pulsars
 	void make_pulsars();
 
-	/// Generate OpenGL display list for results
+	/// Update result candidates (only changed ones are processed)
 	void make_results();
 
-	/// Generate OpenGL display list for SNRs
+	/// Generate static geometry layer for SNRs
 	void make_snrs();
 
-	/// Generate OpenGL display list for constellations
+	/// Generate static geometry layer for constellations
 	void make_constellations();
 
-	/// Generate OpenGL display list for the axes (debug)
+	/// Generate static geometry layer for the axes (debug)
 	void make_axes();
 
-	/// Generate OpenGL display list for the globe
+	/// Generate static geometry layer for the globe
 	void make_globe();
 
 	/**
-	 * \brief Generate OpenGL display list for search marker (gunsight)
+	 * \brief Generate observatory mesh layers for an interferometer shape
 	 *
-	 * \param RAdeg Right ascension in degrees
-	 * \param DEdeg Declination in degrees
-	 * \param size Base size (radius/length) of the marker
+	 * \param shape The shape identifier (see ObservatoryShape)
+	 * \param arm_len_deg The length of the arms, in degrees (not to scale)
+	 * \param dual Add a second, smaller interferometer (e.g. Hanford H2)
 	 */
-	void make_search_marker(GLfloat RAdeg, GLfloat DEdeg, GLfloat size);
+	void make_interferometer_mesh(const int shape, const GLfloat arm_len_deg, const bool dual);
 
 	/**
-	 * \brief Generate a single star vertex
-	 *
-	 * \param RAdeg Right ascension in degrees
-	 * \param DEdeg Declination in degrees
-	 * \param size Point size of the star
-	 */
-	void star_marker(float RAdeg, float DEdeg, float size);
-
-	/**
-	 * \brief Generate a single star vertex with radius
+	 * \brief Generate OpenGL display list for search marker (gunsight)
 	 *
 	 * \param RAdeg Right ascension in degrees
 	 * \param DEdeg Declination in degrees
-	 * \param radius radius as fraction of sphere radius
-	 * \param size Point size of the star
+	 * \param size Base size (radius/length) of the marker
 	 */
-	void star_marker3D(float RAdeg, float DEdeg, float radius, float size);
+	void make_search_marker(GLfloat RAdeg, GLfloat DEdeg, GLfloat size);
 
 	/// rainbow-like color map (RGB)
 	static float rainbow_colormap [][3];
 
-	/// Feature display list ID's
-	GLuint Axes, Stars, Constellations, Pulsars, SNRs, Results;
+	/// Static geometry (stars, pulsars, SNRs, constellations, globe, axes) identified by feature ID
+	SkyGeometryStore m_StaticGeometry;
 
-	/// Feature display list ID's
-	GLuint LLOmarker, LHOmarker, GEOmarker, VIRGOmarker;
+	/// Result candidates (incrementally updated)
+	ResultsBuffer m_Results;
+
+	/// Sky sphere coordinates queued for batch conversion (right ascension, declination, radius)
+	vector<GLfloat> m_QueuedVertices[3];
+
+	/// Conversion buffer for queued vertices (x, y, z)
+	vector<GLfloat> m_ConvertedVertices[3];
+
+	/// Built-in observatories (LLO, LHO, GEO, VIRGO)
+	static const Observatory c_Observatories[];
+
+	/// Current instances of the built-in observatories (dimmed color, zenith position)
+	vector<Observatory> m_Observatories;
 
 	/// Feature display list ID's
-	GLuint sphGrid, SearchMarker;
+	GLuint SearchMarker;
 
 	/**
 	 * \brief Current state of all features (bitmask)
@@ -507,23 +629,29 @@ private:
 
 };
 
-/// Constellation & star coordinates (starlist.C)
-extern float star_info[][2];
+/// Unique star positions on the unit sphere (generated by starcat from starlist.C)
+extern const float c_StarVertices[][3];
+
+/// Total number of unique stars
+extern const int c_StarVertexCount;
+
+/// Constellation line vertex pairs on the unit sphere (generated by starcat from starlist.C)
+extern const float c_ConstellationVertices[][3];
 
-/// Total number of stars
-extern int Nstars;
+/// Total number of constellation line vertices
+extern const int c_ConstellationVertexCount;
 
-/// Pulsar coordinates are (pulsar_list.C)
-extern float pulsar_info[][2];
+/// Unique pulsar positions on the unit sphere (generated by starcat from pulsar_list.C)
+extern const float c_PulsarVertices[][3];
 
-/// Total number of pulsars
-extern int Npulsars;
+/// Total number of unique pulsars
+extern const int c_PulsarVertexCount;
 
-/// SNR coordinates (snr_list.C)
-extern float SNR_info[][2];
+/// Unique SNR positions on the unit sphere (generated by starcat from snr_list.C)
+extern const float c_SNRVertices[][3];
 
-/// Total number of SNRs
-extern int NSNRs;
+/// Total number of unique SNRs
+extern const int c_SNRVertexCount;
 
 
 /**
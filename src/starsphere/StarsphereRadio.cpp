@@ -20,11 +20,12 @@
 
 #include "StarsphereRadio.h"
 
+#include <algorithm>
+
 StarsphereRadio::StarsphereRadio() :
 	Starsphere(EinsteinRadioAdapter::SharedMemoryIdentifier),
 	m_EinsteinAdapter(&m_BoincAdapter)
 {
-	m_WUDispersionMeasureValue = -1.0;
 	m_PowerSpectrumCoordSystemList = 0;
 	m_PowerSpectrumBinList = 0;
 	m_PowerSpectrumFreqBins = 0;
@@ -38,9 +39,6 @@ void StarsphereRadio::initialize(const int width, const int height, const Resour
 {
 	Starsphere::initialize(width, height, font, recycle);
 
-	// store quality setting
-	m_QualitySetting = m_BoincAdapter.graphicsQualitySetting();
-
 	// check whether we initialize the first time or have to recycle (required for windoze)
 	if(!recycle) {
 
@@ -74,8 +72,8 @@ void StarsphereRadio::initialize(const int width, const int height, const Resour
 
 	// create large font instances using font resource (base address + size)
 	m_FontLogo1 = new OGLFT::TranslucentTexture(
-								&m_FontResource->data()->at(0),
-								m_FontResource->data()->size(),
+								m_FontResource->data(),
+								m_FontResource->size(),
 								26, 78 );
 
 	if ( m_FontLogo1 == 0 || !m_FontLogo1->isValid() ) {
@@ -87,8 +85,8 @@ void StarsphereRadio::initialize(const int width, const int height, const Resour
 
 	// create medium font instances using font resource (base address + size)
 	m_FontLogo2 = new OGLFT::TranslucentTexture(
-								&m_FontResource->data()->at(0),
-								m_FontResource->data()->size(),
+								m_FontResource->data(),
+								m_FontResource->size(),
 								12, 72 );
 
 	if ( m_FontLogo2 == 0 || !m_FontLogo2->isValid() ) {
@@ -124,17 +122,36 @@ void StarsphereRadio::resize(const int width, const int height)
 }
 
 void StarsphereRadio::renderAdditionalObservatories() {
-	glCallList(m_areciboObservatory);
+	// enable opt-in quality feature FSAA (GL_POLYGON_SMOOTH is discouraged)
+	if(m_QualitySetting == BOINCClientAdapter::HighGraphicsQualitySetting) {
+		glEnable(GL_MULTISAMPLE_ARB);
+	}
+
+	// make sure both side are visible
+	glDisable(GL_CULL_FACE);
+
+	renderObservatory(m_AreciboObservatory);
+
+	// enable culling again
+	glEnable(GL_CULL_FACE);
+
+	// disable opt-in quality feature FSAA again
+	if(m_QualitySetting == BOINCClientAdapter::HighGraphicsQualitySetting) {
+		glDisable(GL_MULTISAMPLE_ARB);
+	}
 }
 
-void StarsphereRadio::refreshBOINCInformation()
+void StarsphereRadio::fetchBOINCInformation()
 {
 	// call base class implementation
-	Starsphere::refreshLocalBOINCInformation();
+	Starsphere::fetchLocalBOINCInformation();
 
 	// update local/specific content
 	m_EinsteinAdapter.refresh();
 
+	// fill the complete snapshot (slots are recycled)
+	SearchInformation &info = m_SearchInformation.back();
+
 	// prepare conversion buffer
 	stringstream buffer;
 	buffer.precision(2);
@@ -143,51 +160,37 @@ void StarsphereRadio::refreshBOINCInformation()
 	buffer.setf(ios::right, ios::adjustfield);
 
 	// store content required for our HUD (search info)
-	if(m_CurrentRightAscension != m_EinsteinAdapter.wuSkyPosRightAscension()) {
-		// we've got a new position, update search marker and HUD
-		m_CurrentRightAscension = m_EinsteinAdapter.wuSkyPosRightAscension();
-		m_RefreshSearchMarker = true;
-		buffer << "Ascension: " << fixed << m_CurrentRightAscension << " deg" << ends;
-		m_WUSkyPosRightAscension = buffer.str();
-		buffer.str("");
-	}
-
-	if(m_CurrentDeclination != m_EinsteinAdapter.wuSkyPosDeclination()) {
-		// we've got a new position, update search marker and HUD
-		m_CurrentDeclination = m_EinsteinAdapter.wuSkyPosDeclination();
-		m_RefreshSearchMarker = true;
-		buffer << "Declination: " << fixed << m_CurrentDeclination << " deg" << ends;
-		m_WUSkyPosDeclination = buffer.str();
-		buffer.str("");
-	}
+	info.rightAscension = m_EinsteinAdapter.wuSkyPosRightAscension();
+	buffer << "Ascension: " << fixed << info.rightAscension << " deg" << ends;
+	info.wuSkyPosRightAscension = buffer.str();
+	buffer.str("");
 
-	if(m_WUDispersionMeasureValue != m_EinsteinAdapter.wuDispersionMeasure()) {
-		// we've got a new dispersion measure, update HUD
-		m_WUDispersionMeasureValue = m_EinsteinAdapter.wuDispersionMeasure();
-		buffer << "DM: " << fixed << m_WUDispersionMeasureValue << " pc/cm3" << ends;
-		m_WUDispersionMeasure = buffer.str();
-		buffer.str("");
-	}
+	info.declination = m_EinsteinAdapter.wuSkyPosDeclination();
+	buffer << "Declination: " << fixed << info.declination << " deg" << ends;
+	info.wuSkyPosDeclination = buffer.str();
+	buffer.str("");
 
-	// update the following information every time (no need to check first)
+	buffer << "DM: " << fixed << m_EinsteinAdapter.wuDispersionMeasure() << " pc/cm3" << ends;
+	info.wuDispersionMeasure = buffer.str();
+	buffer.str("");
 
 	buffer.precision(3);
 	buffer << "Orb. Radius: " << fixed << m_EinsteinAdapter.wuTemplateOrbitalRadius() << " ls" << ends;
-	m_WUTemplateOrbitalRadius = buffer.str();
+	info.wuTemplateOrbitalRadius = buffer.str();
 	buffer.str("");
 
 	buffer.precision(0);
 	buffer << "Orb. Period: " << fixed << m_EinsteinAdapter.wuTemplateOrbitalPeriod() << " s" << ends;
-	m_WUTemplateOrbitalPeriod = buffer.str();
+	info.wuTemplateOrbitalPeriod = buffer.str();
 	buffer.str("");
 
 	buffer.precision(2);
 	buffer << "Orb. Phase: " << fixed << m_EinsteinAdapter.wuTemplateOrbitalPhase() << " rad" << ends;
-	m_WUTemplateOrbitalPhase = buffer.str();
+	info.wuTemplateOrbitalPhase = buffer.str();
 	buffer.str("");
 
 	buffer << "WU Completed: " << fixed << m_EinsteinAdapter.wuFractionDone() * 100 << " %" << ends;
-	m_WUPercentDone = buffer.str();
+	info.wuPercentDone = buffer.str();
 	buffer.str("");
 
 	// show WU's total CPU time (previously accumulated + current session)
@@ -200,7 +203,35 @@ void StarsphereRadio::refreshBOINCInformation()
 							  << right << setw(2) << min << ":"
 							  << right << setw(2) << sec << ends;
 
-	m_WUCPUTime = buffer.str();
+	info.wuCPUTime = buffer.str();
+
+	// copy power spectrum bin data (no reallocation unless the spectrum size changes)
+	const vector<unsigned char> *powerSpectrum = m_EinsteinAdapter.wuTemplatePowerSpectrum();
+	if(powerSpectrum) {
+		info.powerSpectrum.assign(powerSpectrum->begin(), powerSpectrum->end());
+	}
+
+	m_SearchInformation.publish();
+}
+
+void StarsphereRadio::refreshBOINCInformation()
+{
+	// call base class implementation
+	Starsphere::refreshLocalBOINCInformation();
+
+	// take over the latest snapshot (if any)
+	if(!m_SearchInformation.update()) return;
+
+	const SearchInformation &info = m_SearchInformation.front();
+
+	if(m_CurrentRightAscension != info.rightAscension ||
+	   m_CurrentDeclination != info.declination)
+	{
+		// we've got a new position, update search marker
+		m_CurrentRightAscension = info.rightAscension;
+		m_CurrentDeclination = info.declination;
+		m_RefreshSearchMarker = true;
+	}
 
 	// update power spectrum bin data
 	generatePowerSpectrumBins(m_PowerSpectrumXPos, m_PowerSpectrumYPos);
@@ -208,23 +239,26 @@ void StarsphereRadio::refreshBOINCInformation()
 
 void StarsphereRadio::renderSearchInformation()
 {
+	const SearchInformation &info = m_SearchInformation.front();
+	const UserInformation &user = m_UserInformation.front();
+
 	// left info block
 	m_FontHeader->draw(m_XStartPosLeft, m_YStartPosBottom, "BOINC Information");
-	m_FontText->draw(m_XStartPosLeft, m_Y1StartPosBottom, m_UserName.c_str());
-	m_FontText->draw(m_XStartPosLeft, m_Y2StartPosBottom, m_TeamName.c_str());
-	m_FontText->draw(m_XStartPosLeft, m_Y3StartPosBottom, m_UserCredit.c_str());
-	m_FontText->draw(m_XStartPosLeft, m_Y4StartPosBottom, m_UserRACredit.c_str());
-	m_FontText->draw(m_XStartPosLeft, m_Y5StartPosBottom, m_WUPercentDone.c_str());
-	m_FontText->draw(m_XStartPosLeft, m_Y6StartPosBottom, m_WUCPUTime.c_str());
+	m_FontText->draw(m_XStartPosLeft, m_Y1StartPosBottom, user.userName.c_str());
+	m_FontText->draw(m_XStartPosLeft, m_Y2StartPosBottom, user.teamName.c_str());
+	m_FontText->draw(m_XStartPosLeft, m_Y3StartPosBottom, user.userCredit.c_str());
+	m_FontText->draw(m_XStartPosLeft, m_Y4StartPosBottom, user.userRACredit.c_str());
+	m_FontText->draw(m_XStartPosLeft, m_Y5StartPosBottom, info.wuPercentDone.c_str());
+	m_FontText->draw(m_XStartPosLeft, m_Y6StartPosBottom, info.wuCPUTime.c_str());
 
 	// right info block
 	m_FontHeader->draw(m_XStartPosRight, m_YStartPosBottom, "Search Information");
-	m_FontText->draw(m_XStartPosRight, m_Y1StartPosBottom, m_WUSkyPosRightAscension.c_str());
-	m_FontText->draw(m_XStartPosRight, m_Y2StartPosBottom, m_WUSkyPosDeclination.c_str());
-	m_FontText->draw(m_XStartPosRight, m_Y3StartPosBottom, m_WUDispersionMeasure.c_str());
-	m_FontText->draw(m_XStartPosRight, m_Y4StartPosBottom, m_WUTemplateOrbitalRadius.c_str());
-	m_FontText->draw(m_XStartPosRight, m_Y5StartPosBottom, m_WUTemplateOrbitalPeriod.c_str());
-	m_FontText->draw(m_XStartPosRight, m_Y6StartPosBottom, m_WUTemplateOrbitalPhase.c_str());
+	m_FontText->draw(m_XStartPosRight, m_Y1StartPosBottom, info.wuSkyPosRightAscension.c_str());
+	m_FontText->draw(m_XStartPosRight, m_Y2StartPosBottom, info.wuSkyPosDeclination.c_str());
+	m_FontText->draw(m_XStartPosRight, m_Y3StartPosBottom, info.wuDispersionMeasure.c_str());
+	m_FontText->draw(m_XStartPosRight, m_Y4StartPosBottom, info.wuTemplateOrbitalRadius.c_str());
+	m_FontText->draw(m_XStartPosRight, m_Y5StartPosBottom, info.wuTemplateOrbitalPeriod.c_str());
+	m_FontText->draw(m_XStartPosRight, m_Y6StartPosBottom, info.wuTemplateOrbitalPhase.c_str());
 
 	// power spectrum label
 	m_FontText->draw(m_PowerSpectrumLabelXPos, m_PowerSpectrumLabelYPos, "Arecibo Power Spectrum");
@@ -295,10 +329,14 @@ void StarsphereRadio::generatePowerSpectrumBins(const int originX, const int ori
 	// set pixel normalization factor for maximum bin height
 	GLfloat normalizationFactor = 255.0 / (m_PowerSpectrumHeight - axesYOffset);
 
-	// fetch pointer to power spectrum data
-	m_PowerSpectrumFreqBins = m_EinsteinAdapter.wuTemplatePowerSpectrum();
-	if(!m_PowerSpectrumFreqBins) {
+	// fetch pointer to power spectrum data (current snapshot)
+	m_PowerSpectrumFreqBins = &m_SearchInformation.front().powerSpectrum;
+	if(m_PowerSpectrumFreqBins->empty()) {
 		cerr << "Power spectrum data currently unavailable!" << endl;
+
+		// don't keep showing outdated bins
+		if(m_PowerSpectrumBinList) glDeleteLists(m_PowerSpectrumBinList, 1);
+		m_PowerSpectrumBinList = 0;
 		return;
 	}
 
@@ -309,12 +347,19 @@ void StarsphereRadio::generatePowerSpectrumBins(const int originX, const int ori
 
 		glLineWidth(m_PowerSpectrumBinWidth);
 
+		// larger spectra are condensed to POWERSPECTRUM_BINS bins (showing their peak power)
+		const size_t spectrumBins = m_PowerSpectrumFreqBins->size();
+		const size_t displayBins = spectrumBins < POWERSPECTRUM_BINS ? spectrumBins : POWERSPECTRUM_BINS;
+
 		// draw frequency bins
 		glBegin(GL_LINES);
 			// iterate over all bins
-			for(int i = 0; i < POWERSPECTRUM_BINS; ++i) {
+			for(size_t i = 0; i < displayBins; ++i) {
+				const unsigned char power = *max_element(m_PowerSpectrumFreqBins->begin() + i * spectrumBins / displayBins,
+														 m_PowerSpectrumFreqBins->begin() + (i + 1) * spectrumBins / displayBins);
+
 				// show potential candidates (power >= 100)...
-				if(m_PowerSpectrumFreqBins->at(i) >= 100) {
+				if(power >= 100) {
 					 // ...in bright white
 					glColor4f(1.0, 1.0, 1.0, 1.0);
 				}
@@ -327,7 +372,7 @@ void StarsphereRadio::generatePowerSpectrumBins(const int originX, const int ori
 						   offsetY + axesYOffset);
 				// upper vertex
 				glVertex2f(offsetX + axesXOffset + i*binXOffset,
-						   offsetY + axesYOffset + m_PowerSpectrumFreqBins->at(i) / normalizationFactor);
+						   offsetY + axesYOffset + power / normalizationFactor);
 			}
 		glEnd();
 
@@ -339,112 +384,90 @@ void StarsphereRadio::generateObservatories(float dimFactor)
 	// call base class implementation first
 	Starsphere::generateObservatories(dimFactor);
 
-	GLfloat Lat, Lon; // Latitute/Longitude of IFO is
-	GLfloat RAdeg, DEdeg; // converted to RA/DEC of sky sphere position
-	GLfloat radius; // radius of sphere for obs
-
-	double factorRadDeg = 1.0 / 57.29577957795135; // RAD/DEG conversion factor
-	GLfloat dishRadius = 1; // radius of the Arecibo telescope antenna
-	GLfloat domeRadius = 0.2; // radius of the Arecibo telescope receiver dome
-
-	// get current time and UTC offset (for zenith position)
-	m_ObservatoryDrawTimeLocal = dtime();
-	time_t local = m_ObservatoryDrawTimeLocal;
-	tm *utc = gmtime(&local);
-	double utcOffset = difftime(local, mktime(utc));
-	double observatoryDrawTimeGMT = m_ObservatoryDrawTimeLocal - utcOffset;
-
-	radius = 1.0*sphRadius; // radius of sphere on which they are drawn
-
 	/**
 	 * Arecibo Observatory:
 	 */
 
-	Lat = 18.344167;
-	Lon = 66.752778;
-
-	RAdeg= RAofZenith(observatoryDrawTimeGMT, Lon);
-	DEdeg= Lat;
-
-	// delete existing, create new (required for windoze)
-	if(m_areciboObservatory) glDeleteLists(m_areciboObservatory, 1);
-	m_areciboObservatory = glGenLists(1);
-	glNewList(m_areciboObservatory, GL_COMPILE);
+	m_AreciboObservatory.shape = AreciboShape;
+	m_AreciboObservatory.latitude = 18.344167;
+	m_AreciboObservatory.longitude = 66.752778;
+	m_AreciboObservatory.north = 1.0;
+	m_AreciboObservatory.east = 1.0;
+	m_AreciboObservatory.rightAscension = RAofZenith(m_ObservatoryDrawTimeGMT, m_AreciboObservatory.longitude);
+
+	// we don't dim Arecibo, just IFOs (the mesh has its own colors)
+	m_AreciboObservatory.color[0] = 0.75;
+	m_AreciboObservatory.color[1] = 0.75;
+	m_AreciboObservatory.color[2] = 0.75;
+	m_AreciboObservatory.meshColors = true;
+}
 
-		// enable opt-in quality feature FSAA (GL_POLYGON_SMOOTH is discouraged)
-		if(m_QualitySetting == BOINCClientAdapter::HighGraphicsQualitySetting) {
-			glEnable(GL_MULTISAMPLE_ARB);
-		}
+void StarsphereRadio::generateObservatoryMeshes()
+{
+	// call base class implementation first
+	Starsphere::generateObservatoryMeshes();
 
-		// we don't dim Arecibo, just IFOs
-		glColor3f(0.75, 0.75, 0.75);
+	double factorRadDeg = 1.0 / 57.29577957795135; // RAD/DEG conversion factor
+	GLfloat dishRadius = 1; // radius of the Arecibo telescope antenna
+	GLfloat domeRadius = 0.2; // radius of the Arecibo telescope receiver dome
+	GLfloat radius = 1.0*sphRadius; // radius of sphere on which they are drawn
 
-		// lines used to draw triangles
-		glLineWidth(1.0);
+	// Arecibo mesh: centered at RA = DEC = 0 (see Starsphere::Observatory)
+	m_ObservatoryGeometry.beginLayer(2 * AreciboShape, GL_TRIANGLES, 1.0);
 
-		// draw antenna dish
-		float originX = RAdeg;
-		float originY = DEdeg;
-		float vectorY1 = originY;
-		float vectorX1 = originX;
+		float vectorX1;
+		float vectorY1;
 		float vectorX;
 		float vectorY;
 		float angle;
 
-		// make sure both side are visible
-		glDisable(GL_CULL_FACE);
-
-		glBegin(GL_TRIANGLES);
-			for(int i=0; i <= 360; i++) {
-				angle = ((double)i) * factorRadDeg;
-				vectorX = originX + dishRadius * (float)sin(angle);
-				vectorY = originY + dishRadius * (float)cos(angle);
-				sphVertex(originX, originY);
-				sphVertex(vectorX1, vectorY1);
-				sphVertex(vectorX, vectorY);
-				vectorY1 = vectorY;
-				vectorX1 = vectorX;
-			}
-		glEnd();
+		// draw antenna dish
+		m_ObservatoryGeometry.color(0.75, 0.75, 0.75);
+		vectorX1 = 0.0;
+		vectorY1 = dishRadius;
+		for(int i=1; i <= 360; i++) {
+			angle = ((double)i) * factorRadDeg;
+			vectorX = dishRadius * (float)sin(angle);
+			vectorY = dishRadius * (float)cos(angle);
+			m_ObservatoryGeometry.sphVertex(0.0, 0.0, radius);
+			m_ObservatoryGeometry.sphVertex(vectorX1, vectorY1, radius);
+			m_ObservatoryGeometry.sphVertex(vectorX, vectorY, radius);
+			vectorY1 = vectorY;
+			vectorX1 = vectorX;
+		}
 
 		// draw receiver dome
-		glColor3f(0.5, 0.5, 0.5);
-		glBegin(GL_TRIANGLES);
-			for(int i=0; i <= 360; i++) {
-				angle = ((double)i) * factorRadDeg;
-				vectorX = originX + domeRadius * (float)sin(angle);
-				vectorY = originY + domeRadius * (float)cos(angle);
-				sphVertex(originX, originY);
-				sphVertex(vectorX1, vectorY1);
-				sphVertex(vectorX, vectorY);
-				vectorY1 = vectorY;
-				vectorX1 = vectorX;
-			}
-		glEnd();
+		m_ObservatoryGeometry.color(0.5, 0.5, 0.5);
+		vectorX1 = 0.0;
+		vectorY1 = domeRadius;
+		for(int i=1; i <= 360; i++) {
+			angle = ((double)i) * factorRadDeg;
+			vectorX = domeRadius * (float)sin(angle);
+			vectorY = domeRadius * (float)cos(angle);
+			m_ObservatoryGeometry.sphVertex(0.0, 0.0, radius);
+			m_ObservatoryGeometry.sphVertex(vectorX1, vectorY1, radius);
+			m_ObservatoryGeometry.sphVertex(vectorX, vectorY, radius);
+			vectorY1 = vectorY;
+			vectorX1 = vectorX;
+		}
 
-		// enable culling again
-		glEnable(GL_CULL_FACE);
+	m_ObservatoryGeometry.endLayer();
 
-        // draw receiver struts
-		glColor3f(0.0, 0.0, 0.0);
-		glBegin(GL_LINES);
-			// north guide
-			sphVertex3D(RAdeg, DEdeg, radius);
-			sphVertex3D(RAdeg, DEdeg+1.0, radius);
-		glEnd();
-		glBegin(GL_LINE_STRIP);
-			// south-west & south-east guides:
-			sphVertex3D(RAdeg-0.7, DEdeg-0.7, radius);
-			sphVertex3D(RAdeg, DEdeg, radius);
-			sphVertex3D(RAdeg+0.7, DEdeg-0.7, radius);
-		glEnd();
+	// draw receiver struts
+	m_ObservatoryGeometry.beginLayer(2 * AreciboShape + 1, GL_LINES, 1.0);
 
-		// disable opt-in quality feature FSAA again
-		if(m_QualitySetting == BOINCClientAdapter::HighGraphicsQualitySetting) {
-			glDisable(GL_MULTISAMPLE_ARB);
-		}
+		m_ObservatoryGeometry.color(0.0, 0.0, 0.0);
 
-	glEndList();
+		// north guide
+		m_ObservatoryGeometry.sphVertex(0.0, 0.0, radius);
+		m_ObservatoryGeometry.sphVertex(0.0, 1.0, radius);
+		// south-west & south-east guides:
+		m_ObservatoryGeometry.sphVertex(-0.7, -0.7, radius);
+		m_ObservatoryGeometry.sphVertex(0.0, 0.0, radius);
+		m_ObservatoryGeometry.sphVertex(0.0, 0.0, radius);
+		m_ObservatoryGeometry.sphVertex(0.7, -0.7, radius);
+
+	m_ObservatoryGeometry.endLayer();
 }
 
 void StarsphereRadio::renderLogo()
@@ -87,12 +87,24 @@ public:
 	 */
 	void resize(const int width, const int height);
 
+	/**
+	 * \brief This method is called when the BOINC client information should be fetched
+	 *
+	 * This method implements AbstractGraphicsEngine::fetchBOINCInformation() and calls
+	 * Starsphere::fetchLocalBOINCInformation() first and "adds" the specialized
+	 * parts afterwards (published as \ref m_SearchInformation snapshot).
+	 *
+	 * \see AbstractGraphicsEngine::fetchBOINCInformation()
+	 * \see Starsphere::fetchLocalBOINCInformation()
+	 */
+	void fetchBOINCInformation();
+
 	/**
 	 * \brief This method is called when the BOINC client information should be updated
 	 *
 	 * This method implements AbstractGraphicsEngine::refreshBOINCInformation() and calls
-	 * Starsphere::refreshLocalBOINCInformation() first and "adds" the specialized
-	 * parts afterwards.
+	 * Starsphere::refreshLocalBOINCInformation() first and takes over the latest
+	 * \ref m_SearchInformation snapshot afterwards.
 	 *
 	 * \see AbstractGraphicsEngine::refreshBOINCInformation()
 	 * \see Starsphere::refreshLocalBOINCInformation()
@@ -119,8 +131,8 @@ private:
 	/**
 	 * \brief Renders the Arecibo observatory
 	 *
-	 * This specific implementation invokes a single display list rendering the
-	 * Arecibo observatory. It overrides the (empty) base class implementation.
+	 * This specific implementation renders the Arecibo observatory instance.
+	 * It overrides the (empty) base class implementation.
 	 */
 	inline void renderAdditionalObservatories();
 
@@ -141,7 +153,7 @@ private:
 	void generatePowerSpectrumBins(const int originX, const int originY);
 
 	/**
-	 * \brief Generates the OpenGL call lists for the displayed observatories
+	 * \brief Generates the instances of the displayed observatories
 	 *
 	 * \param dimFactor A dim factor (range: 0 <= x <= 1) that will, well, dim the color
 	 * of the observatories. Right now the factor is propagated to the base class
@@ -150,6 +162,9 @@ private:
 	 */
 	void generateObservatories(const float dimFactor);
 
+	/// Generates the meshes of the displayed observatory shapes (adds the Arecibo shape)
+	void generateObservatoryMeshes();
+
 	/// ID of the OpenGL call list which contains the static power spectrum coordinate system
 	GLuint m_PowerSpectrumCoordSystemList;
 
@@ -198,38 +213,50 @@ private:
 	/// Power Spectrum label configuration setting (vertical position relative to the power spectrum origin)
 	GLfloat m_PowerSpectrumLabelYOffset;
 
-	/// Active render quality setting
-	BOINCClientAdapter::GraphicsQualitySetting m_QualitySetting;
-
 	/// Specialized BOINC client adapter instance for information retrieval
 	EinsteinRadioAdapter m_EinsteinAdapter;
 
-	/// Formatted string copy of the current WU's search parameter "Right-Ascension" (degrees)
-	string m_WUSkyPosRightAscension;
+	/// Search information snapshot (prepared by the fetching thread)
+	struct SearchInformation {
+		/// Constructor
+		SearchInformation() : rightAscension(0.0), declination(0.0), powerSpectrum(POWERSPECTRUM_BINS, 0) {}
+
+		/// The current WU's search parameter "Right-Ascension" (degrees)
+		double rightAscension;
+
+		/// The current WU's search parameter "Declination" (degrees)
+		double declination;
 
-	/// Formatted string copy of the current WU's search parameter "Declination" (degrees)
-	string m_WUSkyPosDeclination;
+		/// Formatted string copy of the current WU's search parameter "Right-Ascension" (degrees)
+		string wuSkyPosRightAscension;
 
-	/// Formatted string copy of the current WU's search parameter "Dispersion measure"
-	string m_WUDispersionMeasure;
+		/// Formatted string copy of the current WU's search parameter "Declination" (degrees)
+		string wuSkyPosDeclination;
 
-	/// Local value copy of the current WU's search parameter "Dispersion measure"
-	double m_WUDispersionMeasureValue;
+		/// Formatted string copy of the current WU's search parameter "Dispersion measure"
+		string wuDispersionMeasure;
 
-	/// Formatted string copy of the current template's search parameter "Projected orbital radius"
-	string m_WUTemplateOrbitalRadius;
+		/// Formatted string copy of the current template's search parameter "Projected orbital radius"
+		string wuTemplateOrbitalRadius;
 
-	/// Formatted string copy of the current template's search parameter "Orbital period"
-	string m_WUTemplateOrbitalPeriod;
+		/// Formatted string copy of the current template's search parameter "Orbital period"
+		string wuTemplateOrbitalPeriod;
 
-	/// Formatted string copy of the current template's search parameter "Initial orbital phase"
-	string m_WUTemplateOrbitalPhase;
+		/// Formatted string copy of the current template's search parameter "Initial orbital phase"
+		string wuTemplateOrbitalPhase;
 
-	/// Formatted string copy of the current WU's search parameter "Percent done"
-	string m_WUPercentDone;
+		/// Formatted string copy of the current WU's search parameter "Percent done"
+		string wuPercentDone;
 
-	/// Formatted string copy of the current WU's search parameter "CPU Time"
-	string m_WUCPUTime;
+		/// Formatted string copy of the current WU's search parameter "CPU Time"
+		string wuCPUTime;
+
+		/// Copy of the current template's power spectrum bin values
+		vector<unsigned char> powerSpectrum;
+	};
+
+	/// Search information (published by the fetching thread, read via front())
+	SnapshotBuffer<SearchInformation> m_SearchInformation;
 
 	/// HUD configuration setting (line offset for medium sized font)
 	GLfloat m_YOffsetMedium;
@@ -261,8 +288,13 @@ private:
 	/// HUD configuration setting (vertical start position for the bottom part, line 6)
 	GLfloat m_Y6StartPosBottom;
 
-	/// Arecibo Observatory display list
-	GLuint m_areciboObservatory;
+	/// Observatory mesh shapes (in addition to Starsphere::ObservatoryShape)
+	enum RadioObservatoryShape {
+		AreciboShape = AdditionalObservatoryShapes
+	};
+
+	/// Arecibo Observatory instance
+	Observatory m_AreciboObservatory;
 };
 
 /**
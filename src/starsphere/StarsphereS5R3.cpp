@@ -25,7 +25,6 @@ StarsphereS5R3::StarsphereS5R3() :
 	Starsphere(EinsteinS5R3Adapter::SharedMemoryIdentifier),
 	m_EinsteinAdapter(&m_BoincAdapter)
 {
-	m_CurrentTime = "";
 }
 
 StarsphereS5R3::~StarsphereS5R3()
@@ -52,8 +51,8 @@ void StarsphereS5R3::initialize(const int width, const int height, const Resourc
 
 	// create large font instances using font resource (base address + size)
 	m_FontLogo1 = new OGLFT::TranslucentTexture(
-								&m_FontResource->data()->at(0),
-								m_FontResource->data()->size(),
+								m_FontResource->data(),
+								m_FontResource->size(),
 								24, 72 );
 
 	if ( m_FontLogo1 == 0 || !m_FontLogo1->isValid() ) {
@@ -65,8 +64,8 @@ void StarsphereS5R3::initialize(const int width, const int height, const Resourc
 
 	// create medium font instances using font resource (base address + size)
 	m_FontLogo2 = new OGLFT::TranslucentTexture(
-								&m_FontResource->data()->at(0),
-								m_FontResource->data()->size(),
+								m_FontResource->data(),
+								m_FontResource->size(),
 								13, 78 );
 
 	if ( m_FontLogo2 == 0 || !m_FontLogo2->isValid() ) {
@@ -95,15 +94,17 @@ void StarsphereS5R3::resize(const int width, const int height)
 	m_XStartPosClock = width - 98;
 }
 
-void StarsphereS5R3::refreshBOINCInformation()
+void StarsphereS5R3::fetchBOINCInformation()
 {
-	bool refresh_results = false;
 	// call base class implementation
-	Starsphere::refreshLocalBOINCInformation();
+	Starsphere::fetchLocalBOINCInformation();
 
 	// update local/specific content
 	m_EinsteinAdapter.refresh();
 
+	// fill the complete snapshot (slots are recycled)
+	SearchInformation &info = m_SearchInformation.back();
+
 	// prepare conversion buffer
 	stringstream buffer;
 	buffer.precision(2);
@@ -112,33 +113,24 @@ void StarsphereS5R3::refreshBOINCInformation()
 	buffer.setf(ios::right, ios::adjustfield);
 
 	// store content required for our HUD (search info)
-	if(m_CurrentRightAscension != m_EinsteinAdapter.wuSkyPosRightAscension()) {
-		// we've got a new position, update search marker and HUD
-		m_CurrentRightAscension = m_EinsteinAdapter.wuSkyPosRightAscension();
-		m_RefreshSearchMarker = true;
-		buffer.str("");
-		buffer << "RA: " << fixed << m_CurrentRightAscension << " deg" << ends;
-		m_WUSkyPosRightAscension = buffer.str();
-		refresh_results=true;
-	}
+	info.rightAscension = m_EinsteinAdapter.wuSkyPosRightAscension();
+	buffer << "RA: " << fixed << info.rightAscension << " deg" << ends;
+	info.wuSkyPosRightAscension = buffer.str();
 
-	if(m_CurrentDeclination != m_EinsteinAdapter.wuSkyPosDeclination()) {
-		// we've got a new position, update search marker and HUD
-		m_CurrentDeclination = m_EinsteinAdapter.wuSkyPosDeclination();
-		m_RefreshSearchMarker = true;
-		buffer.str("");
-		buffer << "dec: " << fixed << m_CurrentDeclination << " deg" << ends;
-		m_WUSkyPosDeclination = buffer.str();
-		refresh_results=true;
-	}
+	info.declination = m_EinsteinAdapter.wuSkyPosDeclination();
+	buffer.str("");
+	buffer << "dec: " << fixed << info.declination << " deg" << ends;
+	info.wuSkyPosDeclination = buffer.str();
 
-	if(refresh_results) {
-		Nresults=m_EinsteinAdapter.copyCandidates(result_info, MAX_RESULT_COUNT);
+	// candidates only change with a new checkpoint (the recycled slot might hold older ones)
+	if(info.candidateRevision != m_EinsteinAdapter.candidateRevision()) {
+		info.candidateCount = m_EinsteinAdapter.copyCandidates(info.candidates, MAX_RESULT_COUNT);
+		info.candidateRevision = m_EinsteinAdapter.candidateRevision();
 	}
 
 	buffer.str("");
 	buffer << "Completed: " << fixed << m_EinsteinAdapter.wuFractionDone() * 100 << " %" << ends;
-	m_WUPercentDone = buffer.str();
+	info.wuPercentDone = buffer.str();
 
 	// show WU's total CPU time (previously accumulated + current session)
 	double timeCPU = m_BoincAdapter.wuCPUTimeSpent() + m_EinsteinAdapter.wuCPUTime();
@@ -151,7 +143,7 @@ void StarsphereS5R3::refreshBOINCInformation()
 							<< right << setw(2) << min << ":"
 							<< right << setw(2) << sec << ends;
 
-	m_WUCPUTime = buffer.str();
+	info.wuCPUTime = buffer.str();
 
 	// update current time string (clock)
 	char cBuffer[10] = {0};
@@ -159,27 +151,56 @@ void StarsphereS5R3::refreshBOINCInformation()
 	struct tm* timeLocal = localtime(&timeNow);
 	strftime(cBuffer, sizeof(cBuffer) - 1, "%H:%M:%S", timeLocal);
 
-	m_CurrentTime = string(cBuffer);
+	info.currentTime = string(cBuffer);
+
+	m_SearchInformation.publish();
+}
+
+void StarsphereS5R3::refreshBOINCInformation()
+{
+	// call base class implementation
+	Starsphere::refreshLocalBOINCInformation();
+
+	// take over the latest snapshot (if any)
+	if(!m_SearchInformation.update()) return;
+
+	const SearchInformation &info = m_SearchInformation.front();
+
+	if(m_CurrentRightAscension != info.rightAscension ||
+	   m_CurrentDeclination != info.declination)
+	{
+		// we've got a new position, update search marker (and results)
+		m_CurrentRightAscension = info.rightAscension;
+		m_CurrentDeclination = info.declination;
+		m_RefreshSearchMarker = true;
+	}
+
+	// candidates are read from the current snapshot
+	result_info = info.candidates;
+	Nresults = info.candidateCount;
 }
 
 void StarsphereS5R3::renderSearchInformation()
 {
+		const SearchInformation &info = m_SearchInformation.front();
+		const UserInformation &user = m_UserInformation.front();
+
 		// clock
-		m_FontLogo1->draw(m_XStartPosClock, m_YStartPosTop, m_CurrentTime.c_str());
+		m_FontLogo1->draw(m_XStartPosClock, m_YStartPosTop, info.currentTime.c_str());
 
 		// left info block
 		m_FontHeader->draw(m_XStartPosLeft, m_YStartPosBottom, "BOINC Statistics");
-		m_FontText->draw(m_XStartPosLeft, m_Y1StartPosBottom, m_UserName.c_str());
-		m_FontText->draw(m_XStartPosLeft, m_Y2StartPosBottom, m_TeamName.c_str());
-		m_FontText->draw(m_XStartPosLeft, m_Y3StartPosBottom, m_UserCredit.c_str());
-		m_FontText->draw(m_XStartPosLeft, m_Y4StartPosBottom, m_UserRACredit.c_str());
+		m_FontText->draw(m_XStartPosLeft, m_Y1StartPosBottom, user.userName.c_str());
+		m_FontText->draw(m_XStartPosLeft, m_Y2StartPosBottom, user.teamName.c_str());
+		m_FontText->draw(m_XStartPosLeft, m_Y3StartPosBottom, user.userCredit.c_str());
+		m_FontText->draw(m_XStartPosLeft, m_Y4StartPosBottom, user.userRACredit.c_str());
 
 		// right info block
 		m_FontHeader->draw(m_XStartPosRight, m_YStartPosBottom, "Search Information");
-		m_FontText->draw(m_XStartPosRight, m_Y1StartPosBottom, m_WUSkyPosRightAscension.c_str());
-		m_FontText->draw(m_XStartPosRight, m_Y2StartPosBottom, m_WUSkyPosDeclination.c_str());
-		m_FontText->draw(m_XStartPosRight, m_Y3StartPosBottom, m_WUPercentDone.c_str());
-		m_FontText->draw(m_XStartPosRight, m_Y4StartPosBottom, m_WUCPUTime.c_str());
+		m_FontText->draw(m_XStartPosRight, m_Y1StartPosBottom, info.wuSkyPosRightAscension.c_str());
+		m_FontText->draw(m_XStartPosRight, m_Y2StartPosBottom, info.wuSkyPosDeclination.c_str());
+		m_FontText->draw(m_XStartPosRight, m_Y3StartPosBottom, info.wuPercentDone.c_str());
+		m_FontText->draw(m_XStartPosRight, m_Y4StartPosBottom, info.wuCPUTime.c_str());
 }
 
 void StarsphereS5R3::generateObservatories(float dimFactor)
@@ -94,12 +94,24 @@ public:
 	virtual void resultMetricDefaults(float & min_default, float & max_default);
 
 
+	/**
+	 * \brief This method is called when the BOINC client information should be fetched
+	 *
+	 * This method implements AbstractGraphicsEngine::fetchBOINCInformation() and calls
+	 * Starsphere::fetchLocalBOINCInformation() first and "adds" the sepcialized
+	 * parts afterwards (published as \ref m_SearchInformation snapshot).
+	 *
+	 * \see AbstractGraphicsEngine::fetchBOINCInformation()
+	 * \see Starsphere::fetchLocalBOINCInformation()
+	 */
+	void fetchBOINCInformation();
+
 	/**
 	 * \brief This method is called when the BOINC client information should be updated
 	 *
 	 * This method implements AbstractGraphicsEngine::refreshBOINCInformation() and calls
-	 * Starsphere::refreshLocalBOINCInformation() first and "adds" the sepcialized
-	 * parts afterwards.
+	 * Starsphere::refreshLocalBOINCInformation() first and takes over the latest
+	 * \ref m_SearchInformation snapshot afterwards.
 	 *
 	 * \see AbstractGraphicsEngine::refreshBOINCInformation()
 	 * \see Starsphere::refreshLocalBOINCInformation()
@@ -124,7 +136,7 @@ private:
 	inline void renderSearchInformation();
 
 	/**
-	 * \brief Generates the OpenGL call lists for the displayed observatories
+	 * \brief Generates the meshes and instances of the displayed observatories
 	 *
 	 * \param dimFactor A dim factor (range: 0 <= x <= 1) that will, well, dim the color
 	 * of the observatories. Right now the factor is propagated to the base class
@@ -135,20 +147,44 @@ private:
 	/// Specialized BOINC client adapter instance for information retrieval
 	EinsteinS5R3Adapter m_EinsteinAdapter;
 
-	/// Local copy of the current WU's search parameter "Right-Ascension" (degrees)
-	string m_WUSkyPosRightAscension;
+	/// Search information snapshot (prepared by the fetching thread)
+	struct SearchInformation {
+		/// Constructor
+		SearchInformation() : rightAscension(0.0), declination(0.0), candidateCount(0), candidateRevision(0) {}
+
+		/// The current WU's search parameter "Right-Ascension" (degrees)
+		double rightAscension;
+
+		/// The current WU's search parameter "Declination" (degrees)
+		double declination;
+
+		/// Formatted copy of the current WU's search parameter "Right-Ascension" (degrees)
+		string wuSkyPosRightAscension;
+
+		/// Formatted copy of the current WU's search parameter "Declination" (degrees)
+		string wuSkyPosDeclination;
+
+		/// Formatted copy of the current WU's search parameter "Percent done"
+		string wuPercentDone;
+
+		/// Formatted copy of the current WU's search parameter "CPU Time"
+		string wuCPUTime;
+
+		/// String representation of the current time
+		string currentTime;
 
-	/// Local copy of the current WU's search parameter "Declination" (degrees)
-	string m_WUSkyPosDeclination;
+		/// Result candidates (coordinates and 'score')
+		float candidates[MAX_RESULT_COUNT][3];
 
-	/// Local copy of the current WU's search parameter "Percent done"
-	string m_WUPercentDone;
+		/// Number of result candidates
+		int candidateCount;
 
-	/// Local copy of the current WU's search parameter "CPU Time"
-	string m_WUCPUTime;
+		/// Revision of the result candidates (see EinsteinS5R3Adapter::candidateRevision())
+		unsigned int candidateRevision;
+	};
 
-	/// String representation of the current time
-	string m_CurrentTime;
+	/// Search information (published by the fetching thread, read via front())
+	SnapshotBuffer<SearchInformation> m_SearchInformation;
 
 	/// HUD configuration setting (line offset for medium sized font)
 	GLfloat m_YOffsetMedium;
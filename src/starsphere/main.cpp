@@ -23,6 +23,7 @@
 
 #include <diagnostics.h>
 #include <boinc_api.h>
+#include <filesys.h>
 
 #include "WindowManager.h"
 #include "ResourceFactory.h"
@@ -40,6 +41,8 @@ extern "C" {
 #endif
 #endif
 
+/// Logical name of the optional external resource pack (see ResourceFactory::openPackFile)
+#define RESOURCE_PACK_FILENAME "starsphere_resources.pack"
 
 int main(int argc, char **argv)
 {
@@ -62,6 +65,14 @@ int main(int argc, char **argv)
 	// prepare main objects
 	WindowManager window;
 	ResourceFactory factory;
+
+	// prefer external resource pack (if available) over built-in resources
+	string packFilename;
+	boinc_resolve_filename_s(RESOURCE_PACK_FILENAME, packFilename);
+	if(boinc_file_exists(packFilename.c_str())) {
+		factory.openPackFile(packFilename);
+	}
+
 	AbstractGraphicsEngine *graphics = GraphicsEngineFactory::createInstance(
 											GraphicsEngineFactory::Starsphere,
 											scienceApplication);
@@ -88,15 +99,15 @@ int main(int argc, char **argv)
 		exit(1);
 	}
 
-	if(fontResource->data()->size() <= 0) {
+	if(fontResource->size() <= 0) {
 		cerr << "Font resource could not be loaded!" << endl;
 		delete graphics;
 		delete fontResource;
 		exit(1);
 	}
 
-	if(iconResource != NULL && iconResource->data()->size() > 0) {
-		window.setWindowIcon(&iconResource->data()->at(0), iconResource->data()->size());
+	if(iconResource != NULL && iconResource->size() > 0) {
+		window.setWindowIcon(iconResource->data(), iconResource->size());
 		delete iconResource;
 	}
 	else {
@@ -110,6 +121,7 @@ int main(int argc, char **argv)
 
 	// pepare rendering
 	graphics->initialize(window.windowWidth(), window.windowHeight(), fontResource);
+	graphics->fetchBOINCInformation();
 	graphics->refreshBOINCInformation();
 
 	// check optional command line parameters
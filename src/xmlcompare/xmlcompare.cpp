@@ -0,0 +1,177 @@
+/***************************************************************************
+ *   Copyright (C) 2008 by Oliver Bock                                     *
+ *   oliver.bock[AT]aei.mpg.de                                             *
+ *                                                                         *
+ *   This file is part of Einstein@Home.                                   *
+ *                                                                         *
+ *   Einstein@Home is free software: you can redistribute it and/or modify *
+ *   it under the terms of the GNU General Public License as published     *
+ *   by the Free Software Foundation, version 2 of the License.            *
+ *                                                                         *
+ *   Einstein@Home is distributed in the hope that it will be useful,      *
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the          *
+ *   GNU General Public License for more details.                          *
+ *                                                                         *
+ *   You should have received a copy of the GNU General Public License     *
+ *   along with Einstein@Home. If not, see <http://www.gnu.org/licenses/>. *
+ *                                                                         *
+ ***************************************************************************/
+
+#include <cstdlib>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include "Libxml2Adapter.h"
+#include "SimpleXMLAdapter.h"
+
+using namespace std;
+
+/**
+ * \brief XML processor comparison
+ *
+ * This tool compares the built-in XML processor (SimpleXMLAdapter) with the libxml2 based
+ * one (Libxml2Adapter): both process the same documents (typical BOINC project preferences
+ * as well as edge cases and malformed input) and have to yield the same results for all
+ * XPath queries. Afterwards it measures the time both take to parse a document and resolve
+ * a batch of queries, as done whenever the project preferences change.
+ */
+
+/// Test documents (the first one is also used for the benchmark)
+const char *DOCUMENTS[] = {
+	"<project_preferences>\n"
+	"<graphics fps=\"30\" quality=\"high\" width=\"640\" height=\"480\">\n"
+	"<engine name=\"starsphere\"><candidates count=\"500\" metric=\"meansig\"/><feature id=\"globe\" enabled=\"true\"/></engine>"
+	"<engine name=\"waverider\"><feature id=\"sound\" enabled=\"false\" /></engine>"
+	"</graphics>"
+	"<x>a &amp; b &lt;c&gt; &#65;&#x42; &#xe9;</x><y><![CDATA[<raw>]]> t</y><z/>"
+	"</project_preferences>\n",
+
+	"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+	"<!DOCTYPE p [ <!ELEMENT p ANY> ]>\n"
+	"<!-- c --><project_preferences a='1&#10;2'><graphics fps='5'/><graphics fps='6'/><m>1<k/>2</m></project_preferences><!-- t -->",
+
+	"<project_preferences />\n",
+
+	// malformed documents (have to be rejected by both)
+	"<a><b></a>",
+	"<a>&foo;</a>",
+	"<a></a><b/>",
+	"text",
+	"<a b=c/>",
+	""
+};
+
+/// Number of test documents
+const int DOCUMENT_COUNT = sizeof(DOCUMENTS) / sizeof(DOCUMENTS[0]);
+
+/**
+ * \brief Test queries (the XPath subset used by the graphics applications plus a few edge cases)
+ *
+ * \c text() steps are left out on purpose: the built-in processor treats mixed contents
+ * as one text node and returns its value, while libxml2 returns no content for text nodes.
+ */
+const char *QUERIES[] = {
+	"/project_preferences/graphics/@fps",
+	"/project_preferences/graphics/@quality",
+	"/project_preferences/graphics/engine[@name='starsphere']/candidates/@count",
+	"/project_preferences/graphics/engine[@name='waverider']/feature/@enabled",
+	"/project_preferences/graphics/engine/feature/@id",
+	"/project_preferences/graphics/engine[2]/@name",
+	"/project_preferences/x",
+	"/project_preferences/y",
+	"/project_preferences/z",
+	"/project_preferences/@a",
+	"/project_preferences/graphics[2]/@fps",
+	"/project_preferences/m",
+	"/*/graphics/engine[@name]/@name",
+	"/nothing",
+	"/project_preferences/graphics/engine[@name=\"starsphere\"]/feature[@enabled='true']/@id"
+};
+
+/// Number of test queries
+const int QUERY_COUNT = sizeof(QUERIES) / sizeof(QUERIES[0]);
+
+/// Number of test queries used by the benchmark (the unambiguous ones at the beginning)
+const int BENCHMARK_QUERY_COUNT = 4;
+
+void printUsage() {
+	cerr << "Invalid command-line options!" << endl;
+	cerr << "Usage: xmlcompare [<benchmark iterations>]" << endl;
+}
+
+double benchmark(XMLProcessorInterface &processor, const vector<string> &xpaths, const int iterations)
+{
+	vector<string> values;
+
+	const clock_t start = clock();
+	for(int i = 0; i < iterations; ++i) {
+		processor.setXmlDocument(DOCUMENTS[0], "http://einstein.phys.uwm.edu");
+		processor.getSingleNodeContentsByXPath(xpaths, values);
+	}
+
+	return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char *argv[])
+{
+	if(argc > 2) {
+		printUsage();
+		exit(1);
+	}
+
+	const int iterations = argc > 1 ? atoi(argv[1]) : 10000;
+	if(iterations <= 0) {
+		printUsage();
+		exit(1);
+	}
+
+	const vector<string> xpaths(QUERIES, QUERIES + QUERY_COUNT);
+	const vector<string> benchmarkXpaths(QUERIES, QUERIES + BENCHMARK_QUERY_COUNT);
+	vector<string> libxml2Values, builtinValues;
+	int mismatches = 0;
+
+	// make sure both processors agree (fresh instances: rejected documents keep the previous one)
+	for(int d = 0; d < DOCUMENT_COUNT; ++d) {
+		Libxml2Adapter libxml2;
+		SimpleXMLAdapter builtin;
+
+		libxml2.setXmlDocument(DOCUMENTS[d], "http://einstein.phys.uwm.edu");
+		builtin.setXmlDocument(DOCUMENTS[d], "http://einstein.phys.uwm.edu");
+
+		const int libxml2Found = libxml2.getSingleNodeContentsByXPath(xpaths, libxml2Values);
+		const int builtinFound = builtin.getSingleNodeContentsByXPath(xpaths, builtinValues);
+
+		for(int q = 0; q < QUERY_COUNT; ++q) {
+			if(libxml2Values[q] != builtinValues[q]) {
+				printf("Document %d, %s: libxml2 \"%s\", builtin \"%s\"\n", d, QUERIES[q],
+					   libxml2Values[q].c_str(), builtinValues[q].c_str());
+				++mismatches;
+			}
+		}
+
+		if(libxml2Found != builtinFound) {
+			printf("Document %d: libxml2 found %d nodes, builtin %d\n", d, libxml2Found, builtinFound);
+			++mismatches;
+		}
+	}
+
+	printf("Test: %d documents, %d queries, %d mismatches\n", DOCUMENT_COUNT, QUERY_COUNT, mismatches);
+
+	// benchmark (parse and batch query, as done for every preferences update)
+	Libxml2Adapter libxml2;
+	SimpleXMLAdapter builtin;
+
+	const double libxml2Time = benchmark(libxml2, benchmarkXpaths, iterations);
+	const double builtinTime = benchmark(builtin, benchmarkXpaths, iterations);
+
+	printf("Benchmark: %lu bytes, %d queries, %d iterations\n", (unsigned long) string(DOCUMENTS[0]).length(), BENCHMARK_QUERY_COUNT, iterations);
+	printf("libxml2: %10.3f us per update\n", libxml2Time * 1e6 / iterations);
+	printf("builtin: %10.3f us per update (%.1fx)\n", builtinTime * 1e6 / iterations,
+		   builtinTime > 0 ? libxml2Time / builtinTime : 0.0);
+
+	exit(mismatches == 0 ? 0 : 1);
+}